@@ -10,6 +10,7 @@
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "DataProviders/AIDataProvider.h"
 #include "EnvironmentQuery/EnvQueryNode.h"
+#include "Async/ParallelFor.h"
 #include "EnvQueryTest.generated.h"
 
 class AActor;
@@ -56,6 +57,23 @@ struct FEnvQueryTestScoringPreview
 };
 #endif
 
+/** Locations of items in structure of arrays layout, used by tests scoring items in batches */
+struct AIMODULE_API FEnvQueryItemLocations
+{
+	/** indices in FEnvQueryInstance::Items, in the order they are visited by FEnvQueryInstance::ItemIterator */
+	TArray<int32> ItemIndices;
+
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	FORCEINLINE int32 Num() const { return ItemIndices.Num(); }
+	FORCEINLINE FVector GetLocation(int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+
+	void Reset(int32 ExpectedNum = 0);
+	void Add(int32 ItemIndex, const FVector& Location);
+};
+
 UCLASS(Abstract)
 class AIMODULE_API UEnvQueryTest : public UEnvQueryNode
 {
@@ -203,6 +221,34 @@ public:
 		return GetItemActor(QueryInstance, Iterator.GetIndex());
 	}
 
+	/** helper: get locations of all items that are still to be processed by this test */
+	void GatherItemLocations(FEnvQueryInstance& QueryInstance, FEnvQueryItemLocations& OutLocations) const;
+
+	/** helper: filter and score items using values computed in batch, NumValuesPerItem consecutive values for each entry of Locations.
+	 *  Items are processed with a regular ItemIterator, so time slicing works the same as for per item tests */
+	void SetBatchedScores(FEnvQueryInstance& QueryInstance, const FEnvQueryItemLocations& Locations, const TArray<float>& Values, int32 NumValuesPerItem,
+		float MinThresholdValue, float MaxThresholdValue) const;
+
+	/** helper: calls Body(StartIndex, EndIndex) for ranges covering [0, NumItems), spread over worker threads when there's enough work (see ai.eqs.ParallelScoringMinValues).
+	 *  Body must not access anything but its input data and its range of the output */
+	template<typename FuncType>
+	static void ForEachItemBatch(int32 NumItems, int32 NumValuesPerItem, FuncType&& Body)
+	{
+		const int32 NumBatches = GetNumItemBatches(NumItems, NumValuesPerItem);
+		if (NumBatches <= 1)
+		{
+			Body(0, NumItems);
+			return;
+		}
+
+		const int32 BatchSize = FMath::DivideAndRoundUp(NumItems, NumBatches);
+		ParallelFor(NumBatches, [&Body, BatchSize, NumItems](int32 BatchIndex)
+		{
+			const int32 StartIndex = BatchIndex * BatchSize;
+			Body(StartIndex, FMath::Min(StartIndex + BatchSize, NumItems));
+		});
+	}
+
 	/** normalize scores in range */
 	void NormalizeItemScores(FEnvQueryInstance& QueryInstance);
 
@@ -223,6 +269,10 @@ public:
 
 	/** update preview list */
 	void UpdatePreviewData();
+
+private:
+	/** number of batches for scoring items on worker threads, 1 for running on calling thread */
+	static int32 GetNumItemBatches(int32 NumItems, int32 NumValuesPerItem);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -60,6 +60,10 @@ protected:
 		TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo, TSubclassOf<UEnvQueryContext> LineDirection, bool bUseDirectionContext,
 		const FVector& ItemLocation = FVector::ZeroVector, const FRotator& ItemRotation = FRotator::ZeroRotator) const;
 
+	/** helper function: score all items in batch, used when lines depend on item locations but not on item rotations */
+	void RunBatchedTest(FEnvQueryInstance& QueryInstance, const TArray<FVector>& LineADirs, const TArray<FVector>& LineBDirs,
+		bool bUpdateLineAPerItem, bool bUpdateLineBPerItem, float MinThresholdValue, float MaxThresholdValue) const;
+
 	/** helper function: check if contexts are updated per item */
 	bool RequiresPerItemUpdates(TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo, TSubclassOf<UEnvQueryContext> LineDirection, bool bUseDirectionContext) const;
 };
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "GenericTeamAgentInterface.h"
+#include "WorldCollision.h"
 #include "Perception/AISense.h"
 #include "AISense_Sight.generated.h"
 
@@ -77,11 +78,14 @@ struct FAISightQuery
 
 	FVector LastSeenLocation;
 
+	/** World time of the last default line of sight trace, negative when there is no trace result to reuse */
+	float LastTraceTime;
+
 	uint64 bLastResult:1;
 	uint64 LastProcessedFrameNumber :63;
 
 	FAISightQuery(FPerceptionListenerID ListenerId = FPerceptionListenerID::InvalidID(), FAISightTarget::FTargetId Target = FAISightTarget::InvalidTargetId)
-		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), LastSeenLocation(FAISystem::InvalidLocation), bLastResult(false), LastProcessedFrameNumber(GFrameCounter)
+		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), LastSeenLocation(FAISystem::InvalidLocation), LastTraceTime(-1.f), bLastResult(false), LastProcessedFrameNumber(GFrameCounter)
 	{
 	}
 
@@ -104,6 +108,18 @@ struct FAISightQuery
 	{
 		LastSeenLocation = FAISystem::InvalidLocation;
 		bLastResult = false;
+		InvalidateTraceResult();
+	}
+
+	/** Whether bLastResult comes from a default trace done less than CacheDuration seconds ago */
+	bool HasValidTraceResult(float WorldTime, float CacheDuration) const
+	{
+		return LastTraceTime >= 0.f && (WorldTime - LastTraceTime) < CacheDuration;
+	}
+
+	void InvalidateTraceResult()
+	{
+		LastTraceTime = -1.f;
 	}
 
 	class FSortPredicate
@@ -151,6 +167,9 @@ public:
 	TArray<FAISightQuery> SightQueriesOutOfRange;
 	TArray<FAISightQuery> SightQueriesInRange;
 
+	/** Queries waiting for the result of their asynchronous line of sight trace, they are not in any of the lists above meanwhile */
+	TMap<FTraceHandle, FAISightQuery> SightQueriesPending;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
 	int32 MaxTracesPerTick;
@@ -172,8 +191,26 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
 	float SightLimitQueryImportance;
 
+	/** Line of sight traces of targets not implementing IAISightTargetInterface are done asynchronously, their results are registered when the traces complete */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
+	bool bUseAsyncTraces;
+
+	/** Maximum number of asynchronous traces issued per update, used instead of MaxTracesPerTick for default traces when bUseAsyncTraces is set */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config, meta = (EditCondition = "bUseAsyncTraces", ClampMin = "1"))
+	int32 MaxAsyncTracesPerTick;
+
+	/** Time in seconds the result of a default line of sight trace is reused for while the target stays in the listener's sight cone. 0 disables reusing results. */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config, meta = (ClampMin = "0"))
+	float VisibilityCacheDuration;
+
+	/** Size of the 2D grid cells used to skip out of range queries whose listener and target are too far apart to get in range. 0 disables the grid. */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config, meta = (ClampMin = "0"))
+	float BroadphaseCellSize;
+
 	ECollisionChannel DefaultSightCollisionChannel;
 
+	FTraceDelegate AsyncTraceDelegate;
+
 public:
 
 	virtual void PostInitProperties() override;
@@ -206,6 +243,11 @@ protected:
 
 	float CalcQueryImportance(const FPerceptionListener& Listener, const FVector& TargetLocation, const float SightRadiusSq) const;
 
+	/** Registers the outcome of a default line of sight trace, BlockingHit being the first blocking hit if any */
+	void RegisterDefaultTraceResult(FPerceptionListener& Listener, FAISightQuery& SightQuery, AActor& TargetActor, const FVector& TargetLocation, const FHitResult* BlockingHit, float WorldTime);
+
+	void OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
 	// Deprecated methods
 public:
 	UE_DEPRECATED(4.25, "Not needed anymore done automatically at the beginning of each update.")
@@ -3,9 +3,41 @@
 #include "EnvironmentQuery/EnvQueryTest.h"
 #include "EnvironmentQuery/Contexts/EnvQueryContext_Item.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_ActorBase.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Async/TaskGraphInterfaces.h"
 
 #define LOCTEXT_NAMESPACE "EnvQueryGenerator"
 
+namespace FEnvQueryTestBatching
+{
+	/** if set, tests scoring items in batches will spread the work over worker threads */
+	int32 ParallelScoring = 1;
+	FAutoConsoleVariableRef CVarParallelScoring(TEXT("ai.eqs.ParallelScoring"), ParallelScoring,
+		TEXT("Allow EQS tests to compute item scores on worker threads.\n0: Disable, 1: Enable"), ECVF_Default);
+
+	/** minimal number of values computed by a test before it's worth going wide */
+	int32 ParallelScoringMinValues = 2048;
+	FAutoConsoleVariableRef CVarParallelScoringMinValues(TEXT("ai.eqs.ParallelScoringMinValues"), ParallelScoringMinValues,
+		TEXT("Minimal number of item values (items x context entries) computed by an EQS test to spread the work over worker threads."), ECVF_Default);
+}
+
+void FEnvQueryItemLocations::Reset(int32 ExpectedNum)
+{
+	ItemIndices.Reset(ExpectedNum);
+	X.Reset(ExpectedNum);
+	Y.Reset(ExpectedNum);
+	Z.Reset(ExpectedNum);
+}
+
+void FEnvQueryItemLocations::Add(int32 ItemIndex, const FVector& Location)
+{
+	ItemIndices.Add(ItemIndex);
+	X.Add(Location.X);
+	Y.Add(Location.Y);
+	Z.Add(Location.Z);
+}
+
 UEnvQueryTest::UEnvQueryTest(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	TestPurpose = EEnvTestPurpose::FilterAndScore;
@@ -189,6 +221,56 @@ AActor* UEnvQueryTest::GetItemActor(FEnvQueryInstance& QueryInstance, int32 Item
 		NULL;
 }
 
+void UEnvQueryTest::GatherItemLocations(FEnvQueryInstance& QueryInstance, FEnvQueryItemLocations& OutLocations) const
+{
+	OutLocations.Reset(QueryInstance.NumValidItems);
+	if (QueryInstance.ItemTypeVectorCDO == nullptr)
+	{
+		for (FEnvQueryInstance::FConstItemIterator It(QueryInstance); It; ++It)
+		{
+			OutLocations.Add(It.GetIndex(), FVector::ZeroVector);
+		}
+		return;
+	}
+
+	for (FEnvQueryInstance::FConstItemIterator It(QueryInstance); It; ++It)
+	{
+		OutLocations.Add(It.GetIndex(), QueryInstance.ItemTypeVectorCDO->GetItemLocation(It.GetItemData()));
+	}
+}
+
+void UEnvQueryTest::SetBatchedScores(FEnvQueryInstance& QueryInstance, const FEnvQueryItemLocations& Locations, const TArray<float>& Values, int32 NumValuesPerItem,
+	float MinThresholdValue, float MaxThresholdValue) const
+{
+	check(Values.Num() == Locations.Num() * NumValuesPerItem);
+
+	int32 LocationIndex = 0;
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It, LocationIndex++)
+	{
+		// both iterators skip the same invalid items, locations are gathered right before scoring
+		check(Locations.ItemIndices.IsValidIndex(LocationIndex) && Locations.ItemIndices[LocationIndex] == It.GetIndex());
+
+		const float* ItemValues = Values.GetData() + (LocationIndex * NumValuesPerItem);
+		for (int32 ValueIndex = 0; ValueIndex < NumValuesPerItem; ValueIndex++)
+		{
+			It.SetScore(TestPurpose, FilterType, ItemValues[ValueIndex], MinThresholdValue, MaxThresholdValue);
+		}
+	}
+}
+
+int32 UEnvQueryTest::GetNumItemBatches(int32 NumItems, int32 NumValuesPerItem)
+{
+	const int32 NumValues = NumItems * NumValuesPerItem;
+	if (!FEnvQueryTestBatching::ParallelScoring || NumValues < FMath::Max(1, FEnvQueryTestBatching::ParallelScoringMinValues) || !FApp::ShouldUseThreadingForPerformance())
+	{
+		return 1;
+	}
+
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	const int32 MaxBatches = NumValues / FMath::Max(1, FEnvQueryTestBatching::ParallelScoringMinValues / 4);
+	return FMath::Clamp(FMath::Min(NumWorkers, MaxBatches), 1, NumItems);
+}
+
 void UEnvQueryTest::PostLoad()
 {
 	Super::PostLoad();
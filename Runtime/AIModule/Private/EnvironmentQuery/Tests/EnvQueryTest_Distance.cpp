@@ -8,24 +8,29 @@
 
 namespace
 {
-	FORCEINLINE float CalcDistance3D(const FVector& PosA, const FVector& PosB)
+	/** computes DistanceFunc(Context - Item) for every item and context pair, OutValues is item major */
+	template<typename DistanceFuncType>
+	void CalcItemDistances(const FEnvQueryItemLocations& Locations, const TArray<FVector>& ContextLocations, TArray<float>& OutValues, DistanceFuncType DistanceFunc)
 	{
-		return (PosB - PosA).Size();
-	}
+		const int32 NumContexts = ContextLocations.Num();
+		OutValues.SetNumUninitialized(Locations.Num() * NumContexts);
 
-	FORCEINLINE float CalcDistance2D(const FVector& PosA, const FVector& PosB)
-	{
-		return (PosB - PosA).Size2D();
-	}
+		const float* ItemX = Locations.X.GetData();
+		const float* ItemY = Locations.Y.GetData();
+		const float* ItemZ = Locations.Z.GetData();
+		float* Values = OutValues.GetData();
 
-	FORCEINLINE float CalcDistanceZ(const FVector& PosA, const FVector& PosB)
-	{
-		return PosB.Z - PosA.Z;
-	}
-
-	FORCEINLINE float CalcDistanceAbsoluteZ(const FVector& PosA, const FVector& PosB)
-	{
-		return FMath::Abs(PosB.Z - PosA.Z);
+		UEnvQueryTest::ForEachItemBatch(Locations.Num(), NumContexts, [&](int32 StartIndex, int32 EndIndex)
+		{
+			for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+			{
+				const FVector ContextLocation = ContextLocations[ContextIndex];
+				for (int32 Index = StartIndex; Index < EndIndex; Index++)
+				{
+					Values[Index * NumContexts + ContextIndex] = DistanceFunc(ContextLocation.X - ItemX[Index], ContextLocation.Y - ItemY[Index], ContextLocation.Z - ItemZ[Index]);
+				}
+			}
+		});
 	}
 
 	FORCEINLINE void CheckItemLocationForNaN(const FVector& ItemLocation, UObject* QueryOwner, int32 Index, uint8 TestMode)
@@ -71,68 +76,44 @@ void UEnvQueryTest_Distance::RunTest(FEnvQueryInstance& QueryInstance) const
 		return;
 	}
 
+	for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
+	{
+		CheckContextLocationForNaN(ContextLocations[ContextIndex], QueryOwner, ContextIndex, TestMode);
+	}
+
+	// distances are computed for all remaining items at once over item locations in SoA layout and then passed to item iterator
+	FEnvQueryItemLocations Locations;
+	GatherItemLocations(QueryInstance, Locations);
+	for (int32 Index = 0; Index < Locations.Num(); Index++)
+	{
+		CheckItemLocationForNaN(Locations.GetLocation(Index), QueryOwner, Locations.ItemIndices[Index], TestMode);
+	}
+
+	TArray<float> Distances;
 	switch (TestMode)
 	{
 		case EEnvTestDistance::Distance3D:	
-			for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
-			{
-				const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
-				CheckItemLocationForNaN(ItemLocation, QueryOwner, It.GetIndex(), TestMode);
-				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-				{
-					CheckContextLocationForNaN(ContextLocations[ContextIndex], QueryOwner, ContextIndex, TestMode);
-					const float Distance = CalcDistance3D(ItemLocation, ContextLocations[ContextIndex]);
-					It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-				}
-			}
+			CalcItemDistances(Locations, ContextLocations, Distances, [](float DX, float DY, float DZ) { return FMath::Sqrt(DX * DX + DY * DY + DZ * DZ); });
 			break;
 
 		case EEnvTestDistance::Distance2D:	
-			for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
-			{
-				const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
-				CheckItemLocationForNaN(ItemLocation, QueryOwner, It.GetIndex(), TestMode);
-				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-				{
-					CheckContextLocationForNaN(ContextLocations[ContextIndex], QueryOwner, ContextIndex, TestMode);
-					const float Distance = CalcDistance2D(ItemLocation, ContextLocations[ContextIndex]);
-					It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-				}
-			}
+			CalcItemDistances(Locations, ContextLocations, Distances, [](float DX, float DY, float DZ) { return FMath::Sqrt(DX * DX + DY * DY); });
 			break;
 
 		case EEnvTestDistance::DistanceZ:	
-			for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
-			{
-				const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
-				CheckItemLocationForNaN(ItemLocation, QueryOwner, It.GetIndex(), TestMode);
-				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-				{
-					CheckContextLocationForNaN(ContextLocations[ContextIndex], QueryOwner, ContextIndex, TestMode);
-					const float Distance = CalcDistanceZ(ItemLocation, ContextLocations[ContextIndex]);
-					It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-				}
-			}
+			CalcItemDistances(Locations, ContextLocations, Distances, [](float DX, float DY, float DZ) { return DZ; });
 			break;
 
 		case EEnvTestDistance::DistanceAbsoluteZ:
-			for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
-			{
-				const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
-				CheckItemLocationForNaN(ItemLocation, QueryOwner, It.GetIndex(), TestMode);
-				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-				{
-					CheckContextLocationForNaN(ContextLocations[ContextIndex], QueryOwner, ContextIndex, TestMode);
-					const float Distance = CalcDistanceAbsoluteZ(ItemLocation, ContextLocations[ContextIndex]);
-					It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-				}
-			}
+			CalcItemDistances(Locations, ContextLocations, Distances, [](float DX, float DY, float DZ) { return FMath::Abs(DZ); });
 			break;
 
 		default:
 			checkNoEntry();
 			return;
 	}
+
+	SetBatchedScores(QueryInstance, Locations, Distances, ContextLocations.Num(), MinThresholdValue, MaxThresholdValue);
 }
 
 FText UEnvQueryTest_Distance::GetDescriptionTitle() const
@@ -5,6 +5,47 @@
 #include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
 #include "EnvironmentQuery/Contexts/EnvQueryContext_Item.h"
 
+namespace
+{
+	/** Line of dot test scored in batch: fixed directions, or directions between item and context locations */
+	struct FDotTestBatchLine
+	{
+		TArray<FVector> Directions;
+		TArray<FVector> FromLocations;
+		TArray<FVector> ToLocations;
+		bool bPerItem = false;
+		bool bFromItem = false;
+		bool bToItem = false;
+
+		int32 GetNumDirections() const
+		{
+			return bPerItem ? ((bFromItem ? 1 : FromLocations.Num()) * (bToItem ? 1 : ToLocations.Num())) : Directions.Num();
+		}
+
+		/** fills OutDirections with GetNumDirections() entries, in the same order as UEnvQueryTest_Dot::GatherLineDirections */
+		void GetDirections(const FVector& ItemLocation, FVector* OutDirections) const
+		{
+			if (!bPerItem)
+			{
+				FMemory::Memcpy(OutDirections, Directions.GetData(), Directions.Num() * sizeof(FVector));
+				return;
+			}
+
+			const int32 NumFrom = bFromItem ? 1 : FromLocations.Num();
+			const int32 NumTo = bToItem ? 1 : ToLocations.Num();
+			for (int32 FromIndex = 0; FromIndex < NumFrom; FromIndex++)
+			{
+				const FVector& From = bFromItem ? ItemLocation : FromLocations[FromIndex];
+				for (int32 ToIndex = 0; ToIndex < NumTo; ToIndex++)
+				{
+					const FVector& To = bToItem ? ItemLocation : ToLocations[ToIndex];
+					*OutDirections++ = (To - From).GetSafeNormal();
+				}
+			}
+		}
+	};
+}
+
 UEnvQueryTest_Dot::UEnvQueryTest_Dot(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Cost = EEnvTestCost::Low;
@@ -56,6 +97,17 @@ void UEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 		}
 	}
 
+	// lines based on item locations can be scored for all items at once, item rotations still require per item context gathering
+	const bool bCanRunBatched = (bUpdateLineAPerItem || bUpdateLineBPerItem)
+		&& !(bUpdateLineAPerItem && LineA.DirMode == EEnvDirection::Rotation)
+		&& !(bUpdateLineBPerItem && LineB.DirMode == EEnvDirection::Rotation)
+		&& (TestMode == EEnvTestDot::Dot3D || TestMode == EEnvTestDot::Dot2D);
+	if (bCanRunBatched)
+	{
+		RunBatchedTest(QueryInstance, LineADirs, LineBDirs, bUpdateLineAPerItem, bUpdateLineBPerItem, MinThresholdValue, MaxThresholdValue);
+		return;
+	}
+
 	// loop through all items
 	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
 	{
@@ -115,6 +167,84 @@ void UEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 	}
 }
 
+void UEnvQueryTest_Dot::RunBatchedTest(FEnvQueryInstance& QueryInstance, const TArray<FVector>& LineADirs, const TArray<FVector>& LineBDirs,
+	bool bUpdateLineAPerItem, bool bUpdateLineBPerItem, float MinThresholdValue, float MaxThresholdValue) const
+{
+	FDotTestBatchLine Lines[2];
+	const FEnvDirection* LineDefs[2] = { &LineA, &LineB };
+	const TArray<FVector>* FixedDirs[2] = { &LineADirs, &LineBDirs };
+	const bool bPerItem[2] = { bUpdateLineAPerItem, bUpdateLineBPerItem };
+	for (int32 LineIndex = 0; LineIndex < 2; LineIndex++)
+	{
+		FDotTestBatchLine& Line = Lines[LineIndex];
+		Line.bPerItem = bPerItem[LineIndex];
+		if (!Line.bPerItem)
+		{
+			Line.Directions = *FixedDirs[LineIndex];
+			continue;
+		}
+
+		// context locations don't change between items, gather them only once
+		Line.bFromItem = IsContextPerItem(LineDefs[LineIndex]->LineFrom);
+		Line.bToItem = IsContextPerItem(LineDefs[LineIndex]->LineTo);
+		if (!Line.bFromItem)
+		{
+			QueryInstance.PrepareContext(LineDefs[LineIndex]->LineFrom, Line.FromLocations);
+		}
+		if (!Line.bToItem)
+		{
+			QueryInstance.PrepareContext(LineDefs[LineIndex]->LineTo, Line.ToLocations);
+		}
+	}
+
+	FEnvQueryItemLocations Locations;
+	GatherItemLocations(QueryInstance, Locations);
+
+	const int32 NumDirsA = Lines[0].GetNumDirections();
+	const int32 NumDirsB = Lines[1].GetNumDirections();
+	const int32 NumValuesPerItem = NumDirsA * NumDirsB;
+
+	TArray<float> DotValues;
+	DotValues.SetNumUninitialized(Locations.Num() * NumValuesPerItem);
+	float* Values = DotValues.GetData();
+	const bool bDot2D = (TestMode == EEnvTestDot::Dot2D);
+
+	ForEachItemBatch(Locations.Num(), NumValuesPerItem, [&](int32 StartIndex, int32 EndIndex)
+	{
+		TArray<FVector, TInlineAllocator<8>> DirsA, DirsB;
+		DirsA.SetNumUninitialized(NumDirsA);
+		DirsB.SetNumUninitialized(NumDirsB);
+
+		for (int32 Index = StartIndex; Index < EndIndex; Index++)
+		{
+			const FVector ItemLocation = Locations.GetLocation(Index);
+			Lines[0].GetDirections(ItemLocation, DirsA.GetData());
+			Lines[1].GetDirections(ItemLocation, DirsB.GetData());
+
+			float* ItemValues = Values + (Index * NumValuesPerItem);
+			for (int32 LineAIndex = 0; LineAIndex < NumDirsA; LineAIndex++)
+			{
+				for (int32 LineBIndex = 0; LineBIndex < NumDirsB; LineBIndex++)
+				{
+					float DotValue = bDot2D ? DirsA[LineAIndex].CosineAngle2D(DirsB[LineBIndex]) : FVector::DotProduct(DirsA[LineAIndex], DirsB[LineBIndex]);
+					if (FMath::IsNaN(DotValue))
+					{
+						DotValue = 0.f;
+					}
+					else if (bAbsoluteValue)
+					{
+						DotValue = FMath::Abs(DotValue);
+					}
+
+					*ItemValues++ = DotValue;
+				}
+			}
+		}
+	});
+
+	SetBatchedScores(QueryInstance, Locations, DotValues, NumValuesPerItem, MinThresholdValue, MaxThresholdValue);
+}
+
 void UEnvQueryTest_Dot::GatherLineDirections(TArray<FVector>& Directions, FEnvQueryInstance& QueryInstance, const FVector& ItemLocation,
 	TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo) const
 {
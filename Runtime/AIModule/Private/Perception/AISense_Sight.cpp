@@ -31,6 +31,7 @@ DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Remove To Target"), STAT_AI_Se
 
 
 static const int32 DefaultMaxTracesPerTick = 6;
+static const int32 DefaultMaxAsyncTracesPerTick = 10;
 static const int32 DefaultMinQueriesPerTimeSliceCheck = 40;
 
 enum class EForEachResult : uint8
@@ -120,6 +121,10 @@ UAISense_Sight::UAISense_Sight(const FObjectInitializer& ObjectInitializer)
 	, HighImportanceQueryDistanceThreshold(300.f)
 	, MaxQueryImportance(60.f)
 	, SightLimitQueryImportance(10.f)
+	, bUseAsyncTraces(false)
+	, MaxAsyncTracesPerTick(DefaultMaxAsyncTracesPerTick)
+	, VisibilityCacheDuration(0.f)
+	, BroadphaseCellSize(2000.f)
 {
 	if (HasAnyFlags(RF_ClassDefaultObject) == false)
 	{
@@ -129,6 +134,7 @@ UAISense_Sight::UAISense_Sight(const FObjectInitializer& ObjectInitializer)
 		OnNewListenerDelegate.BindUObject(this, &UAISense_Sight::OnNewListenerImpl);
 		OnListenerUpdateDelegate.BindUObject(this, &UAISense_Sight::OnListenerUpdateImpl);
 		OnListenerRemovedDelegate.BindUObject(this, &UAISense_Sight::OnListenerRemovedImpl);
+		AsyncTraceDelegate.BindUObject(this, &UAISense_Sight::OnAsyncTraceCompleted);
 	}
 
 	NotifyType = EAISenseNotifyType::OnPerceptionChange;
@@ -165,11 +171,76 @@ bool UAISense_Sight::ShouldAutomaticallySeeTarget(const FDigestedSightProperties
 	return false;
 }
 
+void UAISense_Sight::RegisterDefaultTraceResult(FPerceptionListener& Listener, FAISightQuery& SightQuery, AActor& TargetActor, const FVector& TargetLocation, const FHitResult* BlockingHit, float WorldTime)
+{
+	const AActor* HitResultActor = BlockingHit ? BlockingHit->Actor.Get() : nullptr;
+	if (BlockingHit == nullptr || (HitResultActor && HitResultActor->IsOwnedBy(&TargetActor)))
+	{
+		Listener.RegisterStimulus(&TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener.CachedLocation));
+		SightQuery.bLastResult = true;
+		SightQuery.LastSeenLocation = TargetLocation;
+	}
+	// communicate failure only if we've seen give actor before
+	else if (SightQuery.bLastResult == true)
+	{
+		Listener.RegisterStimulus(&TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+		SightQuery.bLastResult = false;
+		SightQuery.LastSeenLocation = FAISystem::InvalidLocation;
+	}
+
+	if (SightQuery.bLastResult == false)
+	{
+		SIGHT_LOG_LOCATION(Listener.GetBodyActor(), TargetLocation, 25.f, FColor::Red, TEXT(""));
+	}
+
+	SightQuery.LastTraceTime = WorldTime;
+}
+
+void UAISense_Sight::OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FAISightQuery SightQuery;
+	if (SightQueriesPending.RemoveAndCopyValue(TraceHandle, SightQuery) == false)
+	{
+		// query got removed while its trace was in flight
+		return;
+	}
+
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+	FPerceptionListener* Listener = ListenersMap.Find(SightQuery.ObserverId);
+	const FAISightTarget* Target = ObservedTargets.Find(SightQuery.TargetId);
+	AActor* TargetActor = Target ? Target->Target.Get() : nullptr;
+	const FDigestedSightProperties* PropDigest = DigestedProperties.Find(SightQuery.ObserverId);
+	if (Listener == nullptr || Listener->Listener.IsValid() == false || TargetActor == nullptr || PropDigest == nullptr)
+	{
+		// listener or target got invalid while the trace was in flight, the remaining queries of an invalid target get removed by the next update
+		return;
+	}
+
+	const FHitResult* BlockingHit = (TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit) ? &TraceDatum.OutHits[0] : nullptr;
+	const UWorld* World = GetWorld();
+	RegisterDefaultTraceResult(*Listener, SightQuery, *TargetActor, TraceDatum.End, BlockingHit, World ? World->GetTimeSeconds() : 0.f);
+
+	// put the query back in the list matching its importance, in range queries get sorted at the beginning of each update
+	const float SightRadiusSq = SightQuery.bLastResult ? PropDigest->LoseSightRadiusSq : PropDigest->SightRadiusSq;
+	SightQuery.Importance = CalcQueryImportance(*Listener, TraceDatum.End, SightRadiusSq);
+	if (SightQuery.Importance > 0.0f)
+	{
+		SightQueriesInRange.Add(SightQuery);
+	}
+	else
+	{
+		// insert as the last processed one to preserve the out of range queries order
+		NextOutOfRangeIndex = FMath::Min(NextOutOfRangeIndex, SightQueriesOutOfRange.Num());
+		SightQueriesOutOfRange.Insert(SightQuery, NextOutOfRangeIndex);
+		++NextOutOfRangeIndex;
+	}
+}
+
 float UAISense_Sight::Update()
 {
 	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight);
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(GetPerceptionSystem()->GetOuter(), EGetWorldErrorMode::LogAndReturnNull);
+	UWorld* World = GEngine->GetWorldFromContextObject(GetPerceptionSystem()->GetOuter(), EGetWorldErrorMode::LogAndReturnNull);
 
 	if (World == NULL)
 	{
@@ -200,7 +271,9 @@ float UAISense_Sight::Update()
 	}
 
 	int32 TracesCount = 0;
+	int32 AsyncTracesCount = 0;
 	int32 NumQueriesProcessed = 0;
+	const float WorldTime = World->GetTimeSeconds();
 	double TimeSliceEnd = FPlatformTime::Seconds() + MaxTimeSlicePerTick;
 	bool bHitTimeSliceLimit = false;
 //#define AISENSE_SIGHT_TIMESLICING_DEBUG
@@ -212,14 +285,16 @@ float UAISense_Sight::Update()
 	enum class EOperationType : uint8
 	{
 		Remove,
-		SwapList
+		SwapList,
+		Pending
 	};
 	struct FQueryOperation
 	{
-		FQueryOperation(bool bInInRange, EOperationType InOpType, int32 InIndex) : bInRange(bInInRange), OpType(InOpType), Index(InIndex) {}
+		FQueryOperation(bool bInInRange, EOperationType InOpType, int32 InIndex, FTraceHandle InTraceHandle = FTraceHandle()) : bInRange(bInInRange), OpType(InOpType), Index(InIndex), TraceHandle(InTraceHandle) {}
 		bool bInRange;
 		EOperationType OpType;
 		int32 Index;
+		FTraceHandle TraceHandle;
 	};
 	TArray<FQueryOperation> QueryOperations;
 	TArray<FAISightTarget::FTargetId> InvalidTargets;
@@ -228,6 +303,61 @@ float UAISense_Sight::Update()
 
 	AIPerception::FListenerMap& ListenersMap = *GetListeners();
 
+	// Broadphase: out of range queries can only get in range once their listener and target are in nearby grid cells,
+	// locations are resolved once per update instead of once per query
+	struct FBroadphaseListener
+	{
+		FIntPoint Cell;
+		int32 InRangeCells;
+		/** Targets close to their last seen location are seen whatever their distance to the listener, see ShouldAutomaticallySeeTarget */
+		bool bAutoSuccessFromLastSeenLocation;
+	};
+	TMap<FPerceptionListenerID, FBroadphaseListener> BroadphaseListeners;
+	TMap<FAISightTarget::FTargetId, FIntPoint> BroadphaseTargets;
+	const float ImportanceFalloff = MaxQueryImportance - SightLimitQueryImportance;
+	if (BroadphaseCellSize > 0.f && ImportanceFalloff > 0.f && SightQueriesOutOfRange.Num() > 0)
+	{
+		auto GetCell = [this](const FVector& Location)
+		{
+			return FIntPoint(FMath::FloorToInt(Location.X / BroadphaseCellSize), FMath::FloorToInt(Location.Y / BroadphaseCellSize));
+		};
+
+		BroadphaseListeners.Reserve(DigestedProperties.Num());
+		for (const TPair<FPerceptionListenerID, FDigestedSightProperties>& It : DigestedProperties)
+		{
+			const FPerceptionListener* Listener = ListenersMap.Find(It.Key);
+			if (Listener)
+			{
+				// distance at which CalcQueryImportance gets positive, never below the sight radius itself since a negative
+				// SightLimitQueryImportance brings it closer, queries with a last positive result are never culled
+				const float InRangeDistanceSq = FMath::Max3(HighImportanceDistanceSquare, It.Value.SightRadiusSq, It.Value.SightRadiusSq * MaxQueryImportance / ImportanceFalloff);
+				const int32 InRangeCells = FMath::CeilToInt(FMath::Sqrt(InRangeDistanceSq) / BroadphaseCellSize) + 1;
+				const bool bAutoSuccessFromLastSeenLocation = It.Value.AutoSuccessRangeSqFromLastSeenLocation != FAISystem::InvalidRange;
+				BroadphaseListeners.Add(It.Key, FBroadphaseListener{ GetCell(Listener->CachedLocation), InRangeCells, bAutoSuccessFromLastSeenLocation });
+			}
+		}
+
+		BroadphaseTargets.Reserve(ObservedTargets.Num());
+		for (const TPair<FAISightTarget::FTargetId, FAISightTarget>& It : ObservedTargets)
+		{
+			if (const AActor* TargetActor = It.Value.GetTargetActor())
+			{
+				BroadphaseTargets.Add(It.Key, GetCell(TargetActor->GetActorLocation()));
+			}
+		}
+	}
+
+	auto IsCulledByBroadphase = [&BroadphaseListeners, &BroadphaseTargets](const FAISightQuery& SightQuery)
+	{
+		const FBroadphaseListener* ListenerCell = SightQuery.bLastResult ? nullptr : BroadphaseListeners.Find(SightQuery.ObserverId);
+		if (ListenerCell && ListenerCell->bAutoSuccessFromLastSeenLocation && SightQuery.LastSeenLocation != FAISystem::InvalidLocation)
+		{
+			return false;
+		}
+		const FIntPoint* TargetCell = ListenerCell ? BroadphaseTargets.Find(SightQuery.TargetId) : nullptr;
+		return TargetCell && FMath::Max(FMath::Abs(TargetCell->X - ListenerCell->Cell.X), FMath::Abs(TargetCell->Y - ListenerCell->Cell.Y)) > ListenerCell->InRangeCells;
+	};
+
 	int32 InRangeItr = 0;
 	int32 OutOfRangeItr = 0;
 	for (int32 QueryIndex = 0; QueryIndex < SightQueriesInRange.Num() + SightQueriesOutOfRange.Num(); ++QueryIndex)
@@ -260,10 +390,17 @@ float UAISense_Sight::Update()
 			// do not break here since that would bypass queue aging
 		}
 
-		if (TracesCount < MaxTracesPerTick && bHitTimeSliceLimit == false)
+		if (TracesCount < MaxTracesPerTick && (bUseAsyncTraces == false || AsyncTracesCount < MaxAsyncTracesPerTick) && bHitTimeSliceLimit == false)
 		{
 			bIsInRangeQuery ? ++InRangeItr : ++OutOfRangeItr;
 
+			if (!bIsInRangeQuery && IsCulledByBroadphase(*SightQuery))
+			{
+				// still too far to get in range, only restart the query
+				SightQuery->OnProcessed();
+				continue;
+			}
+
 			FPerceptionListener& Listener = ListenersMap[SightQuery->ObserverId];
 			FAISightTarget& Target = ObservedTargets[SightQuery->TargetId];
 
@@ -279,6 +416,7 @@ float UAISense_Sight::Update()
 				const float SightRadiusSq = SightQuery->bLastResult ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
 				
 				float StimulusStrength = 1.f;
+				FTraceHandle PendingTraceHandle;
 				
 				// @Note that automagical "seeing" does not care about sight range nor vision cone
 				const bool bShouldAutomatically = ShouldAutomaticallySeeTarget(PropDigest, SightQuery, Listener, TargetActor, StimulusStrength);
@@ -287,6 +425,7 @@ float UAISense_Sight::Update()
 					// Pretend like we've seen this target where we last saw them
 					Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, StimulusStrength, SightQuery->LastSeenLocation, Listener.CachedLocation));
 					SightQuery->bLastResult = true;
+					SightQuery->InvalidateTraceResult();
 				}
 				else if (FAISystem::CheckIsTargetInSightCone(Listener.CachedLocation, Listener.CachedDirection, PropDigest.PeripheralVisionAngleCos, PropDigest.PointOfViewBackwardOffset, PropDigest.NearClippingRadiusSq, SightRadiusSq, TargetLocation))
 				{
@@ -319,6 +458,25 @@ float UAISense_Sight::Update()
 
 						TracesCount += NumberOfLoSChecksPerformed;
 					}
+					else if (SightQuery->HasValidTraceResult(WorldTime, VisibilityCacheDuration))
+					{
+						// the target stayed in the sight cone since the last trace, reuse its result
+						if (SightQuery->bLastResult)
+						{
+							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener.CachedLocation));
+							SightQuery->LastSeenLocation = TargetLocation;
+						}
+					}
+					else if (bUseAsyncTraces)
+					{
+						// the query waits for the trace result outside of the in and out of range lists
+						PendingTraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Listener.CachedLocation, TargetLocation
+							, DefaultSightCollisionChannel
+							, FCollisionQueryParams(SCENE_QUERY_STAT(AILineOfSight), true, ListenerPtr->GetBodyActor())
+							, FCollisionResponseParams::DefaultResponseParam, &AsyncTraceDelegate);
+
+						++AsyncTracesCount;
+					}
 					else
 					{
 						// we need to do tests ourselves
@@ -329,43 +487,30 @@ float UAISense_Sight::Update()
 
 						++TracesCount;
 
-						auto HitResultActorIsOwnedByTargetActor = [&HitResult, TargetActor]()
-						{
-							AActor* HitResultActor = HitResult.Actor.Get();
-							return (HitResultActor ? HitResultActor->IsOwnedBy(TargetActor) : false);
-						};
-
-						if (bHit == false || HitResultActorIsOwnedByTargetActor())
-						{
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener.CachedLocation));
-							SightQuery->bLastResult = true;
-							SightQuery->LastSeenLocation = TargetLocation;
-						}
-						// communicate failure only if we've seen give actor before
-						else if (SightQuery->bLastResult == true)
-						{
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
-							SightQuery->bLastResult = false;
-							SightQuery->LastSeenLocation = FAISystem::InvalidLocation;
-						}
-
-						if (SightQuery->bLastResult == false)
-						{
-							SIGHT_LOG_LOCATION(ListenerPtr->GetOwner(), TargetLocation, 25.f, FColor::Red, TEXT(""));
-						}
+						RegisterDefaultTraceResult(Listener, *SightQuery, *TargetActor, TargetLocation, bHit ? &HitResult : nullptr, WorldTime);
 					}
 				}
-				// communicate failure only if we've seen give actor before
-				else if (SightQuery->bLastResult)
+				else
 				{
-					SIGHT_LOG_SEGMENT(ListenerPtr->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Red, TEXT("TargetID %d"), Target.TargetId);
-					Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
-					SightQuery->bLastResult = false;
+					// communicate failure only if we've seen give actor before
+					if (SightQuery->bLastResult)
+					{
+						SIGHT_LOG_SEGMENT(ListenerPtr->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Red, TEXT("TargetID %d"), Target.TargetId);
+						Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+						SightQuery->bLastResult = false;
+					}
+
+					// the target left the sight cone, its visibility has to be traced again once it's back
+					SightQuery->InvalidateTraceResult();
 				}
 
 				SightQuery->Importance = CalcQueryImportance(Listener, TargetLocation, SightRadiusSq);
 				const bool bShouldBeInRange = SightQuery->Importance > 0.0f;
-				if (bIsInRangeQuery != bShouldBeInRange)
+				if (PendingTraceHandle.IsValid())
+				{
+					QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::Pending, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex, PendingTraceHandle));
+				}
+				else if (bIsInRangeQuery != bShouldBeInRange)
 				{
 					QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::SwapList, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex));
 				}
@@ -420,6 +565,10 @@ float UAISense_Sight::Update()
 					SightQueriesInRange.Add(SightQueriesOutOfRange[Operation.Index]);
 				}
 			}
+			else if (Operation.OpType == EOperationType::Pending)
+			{
+				SightQueriesPending.Add(Operation.TraceHandle, Operation.bInRange ? SightQueriesInRange[Operation.Index] : SightQueriesOutOfRange[Operation.Index]);
+			}
 
 			if (Operation.bInRange)
 			{
@@ -481,7 +630,7 @@ void UAISense_Sight::UnregisterSource(AActor& SourceActor)
 	FAISightTarget AsTarget;
 	
 	if (ObservedTargets.RemoveAndCopyValue(AsTargetId, AsTarget) 
-		&& (SightQueriesInRange.Num() + SightQueriesOutOfRange.Num()) > 0)
+		&& (SightQueriesInRange.Num() + SightQueriesOutOfRange.Num() + SightQueriesPending.Num()) > 0)
 	{
 		AActor* TargetActor = AsTarget.Target.Get();
 
@@ -513,6 +662,18 @@ void UAISense_Sight::UnregisterSource(AActor& SourceActor)
 			{
 				bSightQueriesOutOfRangeDirty = true;
 			}
+			for (TMap<FTraceHandle, FAISightQuery>::TIterator It = SightQueriesPending.CreateIterator(); It; ++It)
+			{
+				if (It.Value().TargetId == AsTargetId)
+				{
+					if (It.Value().bLastResult == true)
+					{
+						FPerceptionListener& Listener = ListenersMap[It.Value().ObserverId];
+						Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, It.Value().LastSeenLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+					}
+					It.RemoveCurrent();
+				}
+			}
 		}
 	}
 }
@@ -749,7 +910,7 @@ void UAISense_Sight::RemoveAllQueriesByListener(const FPerceptionListener& Liste
 {
 	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_RemoveByListener);
 
-	if ((SightQueriesInRange.Num() + SightQueriesOutOfRange.Num()) == 0)
+	if ((SightQueriesInRange.Num() + SightQueriesOutOfRange.Num() + SightQueriesPending.Num()) == 0)
 	{
 		return;
 	}
@@ -776,6 +937,17 @@ void UAISense_Sight::RemoveAllQueriesByListener(const FPerceptionListener& Liste
 	{
 		bSightQueriesOutOfRangeDirty = true;
 	}
+	for (TMap<FTraceHandle, FAISightQuery>::TIterator It = SightQueriesPending.CreateIterator(); It; ++It)
+	{
+		if (It.Value().ObserverId == ListenerId)
+		{
+			if (OnRemoveFunc)
+			{
+				OnRemoveFunc(It.Value());
+			}
+			It.RemoveCurrent();
+		}
+	}
 }
 
 void UAISense_Sight::RemoveAllQueriesToTarget(const FAISightTarget::FTargetId& TargetId, const TFunction<void(const FAISightQuery&)>& OnRemoveFunc/*= nullptr */)
@@ -802,6 +974,17 @@ void UAISense_Sight::RemoveAllQueriesToTarget(const FAISightTarget::FTargetId& T
 	{
 		bSightQueriesOutOfRangeDirty = true;
 	}
+	for (TMap<FTraceHandle, FAISightQuery>::TIterator It = SightQueriesPending.CreateIterator(); It; ++It)
+	{
+		if (It.Value().TargetId == TargetId)
+		{
+			if (OnRemoveFunc)
+			{
+				OnRemoveFunc(It.Value());
+			}
+			It.RemoveCurrent();
+		}
+	}
 }
 
 void UAISense_Sight::OnListenerForgetsActor(const FPerceptionListener& Listener, AActor& ActorToForget)
@@ -820,9 +1003,16 @@ void UAISense_Sight::OnListenerForgetsActor(const FPerceptionListener& Listener,
 		return EForEachResult::Continue;
 	};
 
-	if (ForEach(SightQueriesInRange, ForgetPreviousResult) == EForEachResult::Continue)
+	if (ForEach(SightQueriesInRange, ForgetPreviousResult) == EForEachResult::Continue
+		&& ForEach(SightQueriesOutOfRange, ForgetPreviousResult) == EForEachResult::Continue)
 	{
-		ForEach(SightQueriesOutOfRange, ForgetPreviousResult);
+		for (TPair<FTraceHandle, FAISightQuery>& It : SightQueriesPending)
+		{
+			if (ForgetPreviousResult(It.Value) == EForEachResult::Break)
+			{
+				break;
+			}
+		}
 	}
 }
 
@@ -841,4 +1031,8 @@ void UAISense_Sight::OnListenerForgetsAll(const FPerceptionListener& Listener)
 
 	ForEach(SightQueriesInRange, ForgetPreviousResult);
 	ForEach(SightQueriesOutOfRange, ForgetPreviousResult);
+	for (TPair<FTraceHandle, FAISightQuery>& It : SightQueriesPending)
+	{
+		ForgetPreviousResult(It.Value);
+	}
 }
@@ -125,6 +125,20 @@ UAssetRegistryImpl::UAssetRegistryImpl(const FObjectInitializer& ObjectInitializ
 	// Read the scan filters for global asset scanning
 	InitializeBlacklistScanFiltersFromIni();
 
+	// Read the tag keys that get a value index for tag filtered queries
+	if (GConfig)
+	{
+		TArray<FString> IndexedTagKeyStrings;
+		GConfig->GetArray(TEXT("AssetRegistry"), TEXT("IndexedTagKeys"), IndexedTagKeyStrings, GEngineIni);
+
+		TSet<FName> IndexedTagKeys;
+		for (const FString& IndexedTagKey : IndexedTagKeyStrings)
+		{
+			IndexedTagKeys.Add(FName(*IndexedTagKey.TrimStartAndEnd()));
+		}
+		State.SetIndexedTagKeys(IndexedTagKeys);
+	}
+
 	// If in the editor, we scan all content right now
 	// If in the game, we expect user to make explicit sync queries using ScanPathsSynchronous
 	// If in a commandlet, we expect the commandlet to decide when to perform a synchronous scan
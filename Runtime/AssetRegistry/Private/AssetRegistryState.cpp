@@ -16,6 +16,20 @@
 #include "PackageReader.h"
 #include "NameTableArchive.h"
 #include "GenericPlatform/GenericPlatformChunkInstall.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+static int32 GAssetRegistryParallelFilterMinCandidates = 4096;
+static FAutoConsoleVariableRef CVarAssetRegistryParallelFilterMinCandidates(
+	TEXT("AssetRegistry.ParallelFilterMinCandidates"),
+	GAssetRegistryParallelFilterMinCandidates,
+	TEXT("Minimum number of candidate assets before FAssetRegistryState::EnumerateAssets tests a filter on worker threads."),
+	ECVF_Default);
+
+/** Number of candidate assets each worker tests per batch when filtering in parallel */
+static constexpr int32 AssetRegistryFilterBatchSize = 512;
 
 #if !defined(USE_COMPACT_ASSET_REGISTRY)
 #error "USE_COMPACT_ASSET_REGISTRY must be defined"
@@ -211,6 +225,7 @@ void FAssetRegistryState::Reset()
 	CachedAssetsByPath.Empty();
 	CachedAssetsByClass.Empty();
 	CachedAssetsByTag.Empty();
+	CachedAssetsByTagValue.Empty();
 	CachedDependsNodes.Empty();
 	CachedPackageData.Empty();
 }
@@ -648,163 +663,258 @@ bool FAssetRegistryState::EnumerateAssets(const FARCompiledFilter& Filter, const
 	const uint32 FilterWithoutPackageFlags = Filter.WithoutPackageFlags;
 	const uint32 FilterWithPackageFlags = Filter.WithPackageFlags;
 
-	// Form a set of assets matched by each filter
-	TArray<TSet<FAssetData*>> DiskFilterSets;
-
-	// On disk package names
-	if (Filter.PackageNames.Num() > 0)
+	// Tag filter entries whose key is indexed by value are resolved through CachedAssetsByTagValue up front,
+	// the remaining entries are tested per asset
+	TSet<const FAssetData*> IndexedTagMatches;
+	TArray<TPair<FName, const TOptional<FString>*>, TInlineAllocator<8>> UnindexedTagFilters;
+	for (auto FilterTagIt = Filter.TagsAndValues.CreateConstIterator(); FilterTagIt; ++FilterTagIt)
 	{
-		TSet<FAssetData*>& PackageNameFilter = DiskFilterSets[DiskFilterSets.AddDefaulted()];
+		const FName Tag = FilterTagIt.Key();
+		const TOptional<FString>& Value = FilterTagIt.Value();
 
-		for (FName PackageName : Filter.PackageNames)
+		const TMap<FString, TArray<FAssetData*>>* ValueIndex = Value.IsSet() ? CachedAssetsByTagValue.Find(Tag) : nullptr;
+		if (ValueIndex)
 		{
-			const TArray<FAssetData*>* PackageAssets = CachedAssetsByPackageName.Find(PackageName);
-
-			if (PackageAssets != nullptr)
+			if (const TArray<FAssetData*>* ValueAssets = ValueIndex->Find(Value.GetValue()))
 			{
-				PackageNameFilter.Append(*PackageAssets);
+				for (const FAssetData* AssetData : *ValueAssets)
+				{
+					IndexedTagMatches.Add(AssetData);
+				}
 			}
 		}
+		else
+		{
+			UnindexedTagFilters.Emplace(Tag, &Value);
+		}
 	}
 
-	// On disk package paths
-	if (Filter.PackagePaths.Num() > 0)
+	// Build the query plan: every filter component contributes the index lists it would draw candidates from.
+	// Only the most selective component is expanded into candidates, the others are applied as predicates.
+	enum class EFilterComponent : uint8
 	{
-		TSet<FAssetData*>& PathFilter = DiskFilterSets[DiskFilterSets.AddDefaulted()];
+		PackageNames,
+		PackagePaths,
+		ClassNames,
+		ObjectPaths,
+		TagsAndValues,
+	};
 
-		for (FName PackagePath : Filter.PackagePaths)
-		{
-			const TArray<FAssetData*>* PathAssets = CachedAssetsByPath.Find(PackagePath);
+	struct FFilterComponentPlan
+	{
+		EFilterComponent Component;
+		TArray<const TArray<FAssetData*>*, TInlineAllocator<8>> IndexLists;
+		int32 EstimatedNum = 0;
 
-			if (PathAssets != nullptr)
+		void AddIndexList(const TArray<FAssetData*>* IndexList)
+		{
+			if (IndexList != nullptr && IndexList->Num() > 0)
 			{
-				PathFilter.Append(*PathAssets);
+				IndexLists.Add(IndexList);
+				EstimatedNum += IndexList->Num();
 			}
 		}
-	}
+	};
 
-	// On disk classes
-	if (Filter.ClassNames.Num() > 0)
+	auto AddComponentPlan = [](TArray<FFilterComponentPlan, TInlineAllocator<5>>& Plans, EFilterComponent Component, const TSet<FName>& Keys, const TMap<FName, TArray<FAssetData*>>& Index)
 	{
-		TSet<FAssetData*>& ClassFilter = DiskFilterSets[DiskFilterSets.AddDefaulted()];
-
-		for (FName ClassName : Filter.ClassNames)
+		if (Keys.Num() > 0)
 		{
-			const TArray<FAssetData*>* ClassAssets = CachedAssetsByClass.Find(ClassName);
-
-			if (ClassAssets != nullptr)
+			FFilterComponentPlan& Plan = Plans.AddDefaulted_GetRef();
+			Plan.Component = Component;
+			for (FName Key : Keys)
 			{
-				ClassFilter.Append(*ClassAssets);
+				Plan.AddIndexList(Index.Find(Key));
 			}
 		}
-	}
+	};
+
+	TArray<FFilterComponentPlan, TInlineAllocator<5>> Plans;
+	AddComponentPlan(Plans, EFilterComponent::PackageNames, Filter.PackageNames, CachedAssetsByPackageName);
+	AddComponentPlan(Plans, EFilterComponent::PackagePaths, Filter.PackagePaths, CachedAssetsByPath);
+	AddComponentPlan(Plans, EFilterComponent::ClassNames, Filter.ClassNames, CachedAssetsByClass);
 
-	// On disk object paths
 	if (Filter.ObjectPaths.Num() > 0)
 	{
-		TSet<FAssetData*>& ObjectPathsFilter = DiskFilterSets[DiskFilterSets.AddDefaulted()];
-
+		// Object paths resolve to single assets, so the estimate is the number of paths that exist
+		FFilterComponentPlan& Plan = Plans.AddDefaulted_GetRef();
+		Plan.Component = EFilterComponent::ObjectPaths;
 		for (FName ObjectPath : Filter.ObjectPaths)
 		{
-			FAssetData* AssetDataPtr = CachedAssetsByObjectPath.FindRef(ObjectPath);
+			Plan.EstimatedNum += CachedAssetsByObjectPath.Contains(ObjectPath) ? 1 : 0;
+		}
+	}
+
+	if (Filter.TagsAndValues.Num() > 0)
+	{
+		FFilterComponentPlan& Plan = Plans.AddDefaulted_GetRef();
+		Plan.Component = EFilterComponent::TagsAndValues;
+		Plan.EstimatedNum = IndexedTagMatches.Num();
+		for (const TPair<FName, const TOptional<FString>*>& TagFilter : UnindexedTagFilters)
+		{
+			Plan.AddIndexList(CachedAssetsByTag.Find(TagFilter.Key));
+		}
+	}
+
+	// Every component has to match, so an empty component means an empty result
+	Algo::SortBy(Plans, &FFilterComponentPlan::EstimatedNum);
+	if (Plans[0].EstimatedNum == 0)
+	{
+		return true;
+	}
 
-			if (AssetDataPtr != nullptr)
+	// Expand the most selective component into the candidate list
+	const FFilterComponentPlan& DrivingPlan = Plans[0];
+	TArray<const FAssetData*> Candidates;
+	Candidates.Reserve(DrivingPlan.EstimatedNum);
+	switch (DrivingPlan.Component)
+	{
+	case EFilterComponent::PackageNames:
+	case EFilterComponent::PackagePaths:
+	case EFilterComponent::ClassNames:
+		// The index lists of these components are disjoint, no deduplication needed
+		for (const TArray<FAssetData*>* IndexList : DrivingPlan.IndexLists)
+		{
+			Candidates.Append(*IndexList);
+		}
+		break;
+	case EFilterComponent::ObjectPaths:
+		for (FName ObjectPath : Filter.ObjectPaths)
+		{
+			if (const FAssetData* AssetData = CachedAssetsByObjectPath.FindRef(ObjectPath))
 			{
-				ObjectPathsFilter.Add(AssetDataPtr);
+				Candidates.Add(AssetData);
 			}
 		}
+		break;
+	case EFilterComponent::TagsAndValues:
+	{
+		TSet<const FAssetData*> TagCandidates(IndexedTagMatches);
+		for (const TArray<FAssetData*>* IndexList : DrivingPlan.IndexLists)
+		{
+			for (const FAssetData* AssetData : *IndexList)
+			{
+				TagCandidates.Add(AssetData);
+			}
+		}
+		Candidates = TagCandidates.Array();
+		break;
+	}
 	}
 
-	// On disk tags and values
-	if (Filter.TagsAndValues.Num() > 0)
+	auto PassesFilter = [&](const FAssetData* AssetData)
 	{
-		TSet<FAssetData*>& TagAndValuesFilter = DiskFilterSets[DiskFilterSets.AddDefaulted()];
+		if (AssetData == nullptr)
+		{
+			return false;
+		}
 
-		for (auto FilterTagIt = Filter.TagsAndValues.CreateConstIterator(); FilterTagIt; ++FilterTagIt)
+		if (PackageNamesToSkip.Contains(AssetData->PackageName))
 		{
-			const FName Tag = FilterTagIt.Key();
-			const TOptional<FString>& Value = FilterTagIt.Value();
+			// Skip assets in passed in package list
+			return false;
+		}
 
-			const TArray<FAssetData*>* TagAssets = CachedAssetsByTag.Find(Tag);
+		if (AssetData->HasAnyPackageFlags(FilterWithoutPackageFlags))
+		{
+			return false;
+		}
+
+		if (!AssetData->HasAllPackageFlags(FilterWithPackageFlags))
+		{
+			return false;
+		}
 
-			if (TagAssets != nullptr)
+		// Apply the components in order of selectivity so the most likely rejections happen first
+		for (const FFilterComponentPlan& Plan : Plans)
+		{
+			switch (Plan.Component)
 			{
-				for (FAssetData* AssetData : *TagAssets)
+			case EFilterComponent::PackageNames:
+				if (!Filter.PackageNames.Contains(AssetData->PackageName))
+				{
+					return false;
+				}
+				break;
+			case EFilterComponent::PackagePaths:
+				if (!Filter.PackagePaths.Contains(AssetData->PackagePath))
+				{
+					return false;
+				}
+				break;
+			case EFilterComponent::ClassNames:
+				if (!Filter.ClassNames.Contains(AssetData->AssetClass))
 				{
-					if (AssetData != nullptr)
+					return false;
+				}
+				break;
+			case EFilterComponent::ObjectPaths:
+				if (!Filter.ObjectPaths.Contains(AssetData->ObjectPath))
+				{
+					return false;
+				}
+				break;
+			case EFilterComponent::TagsAndValues:
+				if (!IndexedTagMatches.Contains(AssetData))
+				{
+					bool bAccept = false;
+					for (const TPair<FName, const TOptional<FString>*>& TagFilter : UnindexedTagFilters)
 					{
-						bool bAccept;
+						const TOptional<FString>& Value = *TagFilter.Value;
 						if (!Value.IsSet())
 						{
-							bAccept = AssetData->TagsAndValues.Contains(Tag);
+							bAccept = AssetData->TagsAndValues.Contains(TagFilter.Key);
 						}
 						else
 						{
-							bAccept = AssetData->TagsAndValues.ContainsKeyValue(Tag, Value.GetValue());
+							bAccept = AssetData->TagsAndValues.ContainsKeyValue(TagFilter.Key, Value.GetValue());
 						}
 						if (bAccept)
 						{
-							TagAndValuesFilter.Add(AssetData);
+							break;
 						}
 					}
-				}
-			}
-		}
-	}
-
-	// If we have any filter sets, add the assets which are contained in the sets to OutAssetData
-	if (DiskFilterSets.Num() > 0)
-	{
-		// Initialize the combined filter set to the first set, in case we can skip combining.
-		TSet<FAssetData*>* CombinedFilterSetPtr = &DiskFilterSets[0];
-		TSet<FAssetData*> IntersectedFilterSet;
-
-		// If we have more than one set, we must combine them. We take the intersection
-		if (DiskFilterSets.Num() > 1)
-		{
-			IntersectedFilterSet = *CombinedFilterSetPtr;
-			CombinedFilterSetPtr = &IntersectedFilterSet;
-
-			for (int32 SetIdx = 1; SetIdx < DiskFilterSets.Num() && IntersectedFilterSet.Num() > 0; ++SetIdx)
-			{
-				// If the other set is smaller, swap it so we iterate the smaller set
-				TSet<FAssetData*> OtherFilterSet = DiskFilterSets[SetIdx];
-				if (OtherFilterSet.Num() < IntersectedFilterSet.Num())
-				{
-					Swap(OtherFilterSet, IntersectedFilterSet);
-				}
-
-				for (auto It = IntersectedFilterSet.CreateIterator(); It; ++It)
-				{
-					if (!OtherFilterSet.Contains(*It))
+					if (!bAccept)
 					{
-						It.RemoveCurrent();
-						continue;
+						return false;
 					}
 				}
+				break;
 			}
 		}
+		return true;
+	};
 
-		// Iterate over the final combined filter set to add to OutAssetData
-		for (const FAssetData* AssetData : *CombinedFilterSetPtr)
+	// Large candidate lists are tested on worker threads; the callback is always invoked on the calling thread
+	const int32 NumCandidates = Candidates.Num();
+	if (NumCandidates >= GAssetRegistryParallelFilterMinCandidates && FApp::ShouldUseThreadingForPerformance())
+	{
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumCandidates, AssetRegistryFilterBatchSize);
+		TArray<bool> bPassed;
+		bPassed.SetNumUninitialized(NumCandidates);
+		ParallelFor(NumBatches, [&Candidates, &bPassed, &PassesFilter, NumCandidates](int32 BatchIndex)
 		{
-			if (PackageNamesToSkip.Contains(AssetData->PackageName))
-			{
-				// Skip assets in passed in package list
-				continue;
-			}
-
-			if (AssetData->HasAnyPackageFlags(FilterWithoutPackageFlags))
+			const int32 Start = BatchIndex * AssetRegistryFilterBatchSize;
+			const int32 End = FMath::Min(Start + AssetRegistryFilterBatchSize, NumCandidates);
+			for (int32 Index = Start; Index < End; ++Index)
 			{
-				continue;
+				bPassed[Index] = PassesFilter(Candidates[Index]);
 			}
+		});
 
-			if (!AssetData->HasAllPackageFlags(FilterWithPackageFlags))
+		for (int32 Index = 0; Index < NumCandidates; ++Index)
+		{
+			if (bPassed[Index] && !Callback(*Candidates[Index]))
 			{
-				continue;
+				return true;
 			}
-
-			if (!Callback(*AssetData))
+		}
+	}
+	else
+	{
+		for (const FAssetData* AssetData : Candidates)
+		{
+			if (PassesFilter(AssetData) && !Callback(*AssetData))
 			{
 				return true;
 			}
@@ -1280,7 +1390,16 @@ void FAssetRegistryState::StripAssetRegistryKeyForObject(FName ObjectPath, FName
 	FAssetData** Found = CachedAssetsByObjectPath.Find(ObjectPath);
 	if (Found)
 	{
+		const bool bIndexedKey = IndexedTagKeys.Contains(Key);
+		if (bIndexedKey)
+		{
+			RemoveFromTagValueIndex(*Found);
+		}
 		(*Found)->TagsAndValues.StripKey(Key);
+		if (bIndexedKey)
+		{
+			AddToTagValueIndex(*Found);
+		}
 	}
 }
 
@@ -1312,6 +1431,15 @@ uint32 FAssetRegistryState::GetAllocatedSize(bool bLogDetailed) const
 	SubArray(CachedAssetsByPath);
 	SubArray(CachedAssetsByClass);
 	SubArray(CachedAssetsByTag);
+	MapMemory += CachedAssetsByTagValue.GetAllocatedSize();
+	for (const TPair<FName, TMap<FString, TArray<FAssetData*>>>& Pair : CachedAssetsByTagValue)
+	{
+		MapMemory += Pair.Value.GetAllocatedSize();
+		for (const TPair<FString, TArray<FAssetData*>>& ValuePair : Pair.Value)
+		{
+			MapArrayMemory += ValuePair.Key.GetAllocatedSize() + ValuePair.Value.GetAllocatedSize();
+		}
+	}
 
 	if (bLogDetailed)
 	{
@@ -1508,6 +1636,55 @@ void FAssetRegistryState::AddAssetData(FAssetData* AssetData)
 		TArray<FAssetData*>& TagAssets = CachedAssetsByTag.FindOrAdd(Key);
 		TagAssets.Add(AssetData);
 	}
+
+	AddToTagValueIndex(AssetData);
+}
+
+void FAssetRegistryState::SetIndexedTagKeys(const TSet<FName>& InIndexedTagKeys)
+{
+	IndexedTagKeys = InIndexedTagKeys;
+	CachedAssetsByTagValue.Empty(IndexedTagKeys.Num());
+
+	for (const TPair<FName, FAssetData*>& AssetDataPair : CachedAssetsByObjectPath)
+	{
+		if (AssetDataPair.Value)
+		{
+			AddToTagValueIndex(AssetDataPair.Value);
+		}
+	}
+}
+
+void FAssetRegistryState::AddToTagValueIndex(FAssetData* AssetData)
+{
+	for (FName Key : IndexedTagKeys)
+	{
+		FAssetDataTagMapSharedView::FFindTagResult Value = AssetData->TagsAndValues.FindTag(Key);
+		if (Value.IsSet())
+		{
+			CachedAssetsByTagValue.FindOrAdd(Key).FindOrAdd(Value.GetValue()).Add(AssetData);
+		}
+	}
+}
+
+void FAssetRegistryState::RemoveFromTagValueIndex(FAssetData* AssetData)
+{
+	for (FName Key : IndexedTagKeys)
+	{
+		FAssetDataTagMapSharedView::FFindTagResult Value = AssetData->TagsAndValues.FindTag(Key);
+		if (Value.IsSet())
+		{
+			TMap<FString, TArray<FAssetData*>>* ValueIndex = CachedAssetsByTagValue.Find(Key);
+			TArray<FAssetData*>* ValueAssets = ValueIndex ? ValueIndex->Find(Value.GetValue()) : nullptr;
+			if (ValueAssets)
+			{
+				ValueAssets->RemoveSingleSwap(AssetData);
+				if (ValueAssets->Num() == 0)
+				{
+					ValueIndex->Remove(Value.GetValue());
+				}
+			}
+		}
+	}
 }
 
 void FAssetRegistryState::UpdateAssetData(const FAssetData& NewAssetData)
@@ -1599,8 +1776,13 @@ void FAssetRegistryState::UpdateAssetData(FAssetData* AssetData, const FAssetDat
 		}
 	}
 
+	// Values of indexed tags may change even if the keys did not
+	RemoveFromTagValueIndex(AssetData);
+
 	// Copy in new values
 	*AssetData = NewAssetData;
+
+	AddToTagValueIndex(AssetData);
 }
 
 void FAssetRegistryState::RemoveAssetData(FAssetData* AssetData, bool bRemoveDependencyData, bool& bOutRemovedAssetData, bool& bOutRemovedPackageData)
@@ -1624,6 +1806,7 @@ void FAssetRegistryState::RemoveAssetData(FAssetData* AssetData, bool bRemoveDep
 			TArray<FAssetData*>* OldTagAssets = CachedAssetsByTag.Find(TagIt.Key());
 			OldTagAssets->RemoveSingleSwap(AssetData);
 		}
+		RemoveFromTagValueIndex(AssetData);
 
 		// Only remove dependencies and package data if there are no other known assets in the package
 		if (OldPackageAssets->Num() == 0)
@@ -1745,6 +1928,15 @@ void FAssetRegistryState::Shrink()
 	ShrinkIn(CachedAssetsByClass);
 	ShrinkIn(CachedAssetsByTag);
 	ShrinkIn(CachedAssetsByPackageName);
+	CachedAssetsByTagValue.Shrink();
+	for (auto& Pair : CachedAssetsByTagValue)
+	{
+		Pair.Value.Shrink();
+		for (auto& ValuePair : Pair.Value)
+		{
+			ValuePair.Value.Shrink();
+		}
+	}
 	CachedDependsNodes.Shrink();
 	CachedPackageData.Shrink();
 	CachedAssetsByObjectPath.Shrink();
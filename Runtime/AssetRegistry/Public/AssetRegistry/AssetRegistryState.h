@@ -233,6 +233,20 @@ public:
 		return InvalidArray;
 	}
 
+	/**
+	 * Sets the tag keys that maintain a secondary Value->AssetData index, so TagsAndValues filters on those keys
+	 * resolve without comparing values of every asset carrying the tag. Rebuilds the index for existing assets.
+	 *
+	 * @param InIndexedTagKeys the tag keys to index by value, replaces any previous set
+	 */
+	void SetIndexedTagKeys(const TSet<FName>& InIndexedTagKeys);
+
+	/** Returns the tag keys that are currently indexed by value */
+	const TSet<FName>& GetIndexedTagKeys() const
+	{
+		return IndexedTagKeys;
+	}
+
 	/** Returns const version of internal ObjectPath->AssetData map for fast iteration */
 	const TMap<FName, const FAssetData*>& GetObjectPathToAssetDataMap() const
 	{
@@ -361,6 +375,12 @@ private:
 	/** Removes the depends node and updates the dependencies to no longer contain it as as a referencer. */
 	bool RemoveDependsNode(const FAssetIdentifier& Identifier);
 
+	/** Adds the asset to the value index of every indexed tag key it carries */
+	void AddToTagValueIndex(FAssetData* AssetData);
+
+	/** Removes the asset from the value index of every indexed tag key it carries */
+	void RemoveFromTagValueIndex(FAssetData* AssetData);
+
 	/** Shrink all contained data structures. */
 	void Shrink();
 
@@ -387,6 +407,12 @@ private:
 	/** The map of asset tag to asset data for assets saved to disk */
 	TMap<FName, TArray<FAssetData*> > CachedAssetsByTag;
 
+	/** The set of tag keys that get a value index in CachedAssetsByTagValue */
+	TSet<FName> IndexedTagKeys;
+
+	/** The map of indexed asset tag to tag value to asset data for assets saved to disk. Values compare case insensitively, like ContainsKeyValue */
+	TMap<FName, TMap<FString, TArray<FAssetData*>>> CachedAssetsByTagValue;
+
 	/** A map of object names to dependency data */
 	TMap<FAssetIdentifier, FDependsNode*> CachedDependsNodes;
 
@@ -132,6 +132,9 @@ struct CORE_API FExternalPhysicsCustomObjectVersion
 		// Removed unused full bounds from AABBTree
 		RemovedAABBTreeFullBounds,
 
+		// Added the dynamic AABB tree acceleration structure, which the default acceleration collection can hold
+		DynamicAABBTreeAcceleration,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
@@ -2,6 +2,7 @@
 
 #include "Serialization/UnversionedPropertySerialization.h"
 #include "Serialization/UnversionedPropertySerializationTest.h"
+#include "Serialization/UnversionedPropertyRecord.h"
 #include "Interfaces/ITargetPlatform.h"
 #include "Misc/ScopeRWLock.h"
 #include "UObject/UnrealType.h"
@@ -758,8 +759,24 @@ bool CanUseUnversionedPropertySerialization(const ITargetPlatform* Target)
 	return bTargetValue;
 }
 
+// Set while serializing unversioned property records, which are allowed regardless of the cooked package settings
+static thread_local int32 GUnversionedPropertyRecordDepth = 0;
+
+static struct
+{
+	FRWLock Lock;
+	TMap<const UStruct*, uint32> StructHashes;
+}
+GUnversionedSchemaHashCache;
+
 void DestroyUnversionedSchema(const UStruct* Struct)
 {
+	{
+		// Hashes of outer structs fold in the hash of this one
+		FWriteScopeLock Scope(GUnversionedSchemaHashCache.Lock);
+		GUnversionedSchemaHashCache.StructHashes.Reset();
+	}
+
 #if CACHE_UNVERSIONED_PROPERTY_SCHEMA
 	delete Struct->UnversionedSchema;
 	Struct->UnversionedSchema = nullptr;
@@ -773,7 +790,7 @@ void SerializeUnversionedProperties(const UStruct* Struct, FStructuredArchive::F
 
 	if (UnderlyingArchive.IsLoading())
 	{
-		check(CanUseUnversionedPropertySerialization());
+		check(GUnversionedPropertyRecordDepth > 0 || CanUseUnversionedPropertySerialization());
 
 		FUnversionedHeader Header;
 		Header.Load(StructRecord.EnterStream(SA_FIELD_NAME(TEXT("Header"))));
@@ -851,3 +868,239 @@ void SerializeUnversionedProperties(const UStruct* Struct, FStructuredArchive::F
 		}
 	}
 }
+
+struct FSchemaHashContext
+{
+	/** Structs whose hash is being computed */
+	TArray<const UStruct*, TInlineAllocator<8>> Visiting;
+	/** Number of references to a struct in Visiting met so far, hashes that depend on them can't be cached */
+	int32 NumCycles = 0;
+};
+
+static uint32 GetStructSchemaHash(const UStruct* Struct, FSchemaHashContext& Context);
+
+static uint32 HashPropertySchema(FProperty* Property, uint32 Hash, FSchemaHashContext& Context)
+{
+	Hash = FCrc::StrCrc32(*Property->GetName(), Hash);
+	Hash = FCrc::StrCrc32(*Property->GetClass()->GetName(), Hash);
+	Hash = FCrc::MemCrc32(&Property->ArrayDim, sizeof(Property->ArrayDim), Hash);
+
+	if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		Hash = HashCombine(Hash, GetStructSchemaHash(StructProperty->Struct, Context));
+	}
+
+	// Container elements and enum underlying types
+	TArray<FField*> InnerFields;
+	Property->GetInnerFields(InnerFields);
+	for (FField* InnerField : InnerFields)
+	{
+		if (FProperty* InnerProperty = CastField<FProperty>(InnerField))
+		{
+			Hash = HashPropertySchema(InnerProperty, Hash, Context);
+		}
+	}
+
+	return Hash;
+}
+
+static uint32 GetStructSchemaHash(const UStruct* Struct, FSchemaHashContext& Context)
+{
+	if (!Struct)
+	{
+		return 0;
+	}
+
+	{
+		FReadScopeLock Scope(GUnversionedSchemaHashCache.Lock);
+		if (const uint32* CachedHash = GUnversionedSchemaHashCache.StructHashes.Find(Struct))
+		{
+			return *CachedHash;
+		}
+	}
+
+	// Structs can reference themselves through containers, their name is enough to identify them the second time
+	uint32 Hash = FCrc::StrCrc32(*Struct->GetName());
+	if (Context.Visiting.Contains(Struct))
+	{
+		++Context.NumCycles;
+		return Hash;
+	}
+
+	const int32 NumCyclesBefore = Context.NumCycles;
+
+	Context.Visiting.Push(Struct);
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (!Property->IsEditorOnlyProperty())
+		{
+			Hash = HashPropertySchema(Property, Hash, Context);
+		}
+	}
+	Context.Visiting.Pop(/* allow shrink */ false);
+
+	// The hash of a struct that is part of a cycle depends on where the cycle was entered, so it's only cached when it doesn't
+	if (Context.NumCycles == NumCyclesBefore)
+	{
+		FWriteScopeLock Scope(GUnversionedSchemaHashCache.Lock);
+		GUnversionedSchemaHashCache.StructHashes.Add(Struct, Hash);
+	}
+
+	return Hash;
+}
+
+uint32 GetUnversionedPropertySchemaHash(const UStruct* Struct)
+{
+	check(Struct);
+
+	FSchemaHashContext Context;
+	return GetStructSchemaHash(Struct, Context);
+}
+
+static constexpr uint32 UnversionedPropertyRecordMagic = 0x55505231; // 'UPR1'
+
+/**
+ * Serializes a payload preceded by its size, which is patched in after saving.
+ * @return false if the payload didn't read back to its saved size, the archive is then flagged as errored
+ */
+static bool SerializeRecordPayload(FArchive& Ar, const UStruct* Schema, bool bUnversioned, TFunctionRef<void(FArchive&)> SerializePayload)
+{
+	int64 PayloadSize = 0;
+	const int64 PayloadSizeOffset = Ar.Tell();
+	Ar << PayloadSize;
+	const int64 PayloadOffset = Ar.Tell();
+
+	if (Ar.IsLoading() && PayloadSize < 0)
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	{
+		const bool bWasUnversioned = Ar.UseUnversionedPropertySerialization();
+		Ar.SetUseUnversionedPropertySerialization(bUnversioned);
+		++GUnversionedPropertyRecordDepth;
+
+		SerializePayload(Ar);
+
+		--GUnversionedPropertyRecordDepth;
+		Ar.SetUseUnversionedPropertySerialization(bWasUnversioned);
+	}
+
+	const int64 PayloadEnd = Ar.Tell();
+	if (Ar.IsSaving())
+	{
+		PayloadSize = PayloadEnd - PayloadOffset;
+		Ar.Seek(PayloadSizeOffset);
+		Ar << PayloadSize;
+		Ar.Seek(PayloadEnd);
+	}
+	else if (PayloadEnd != PayloadOffset + PayloadSize)
+	{
+		// The target was partly deserialized from a corrupt or misaligned payload
+		UE_LOG(LogScriptSerialization, Warning, TEXT("Unversioned property record for %s read %lld bytes, expected %lld"), *Schema->GetName(), PayloadEnd - PayloadOffset, PayloadSize);
+		Ar.SetError();
+		return false;
+	}
+
+	return !Ar.IsError();
+}
+
+/** Skips a payload preceded by its size */
+static bool SkipRecordPayload(FArchive& Ar)
+{
+	int64 PayloadSize = 0;
+	Ar << PayloadSize;
+	if (PayloadSize < 0 || Ar.IsError())
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	Ar.Seek(Ar.Tell() + PayloadSize);
+	return !Ar.IsError();
+}
+
+static EUnversionedPropertyRecordResult SerializePropertyRecord(FArchive& Ar, const UStruct* Schema, EUnversionedPropertyRecordFormat SaveFormat, TFunctionRef<void(FArchive&)> SerializePayload)
+{
+	uint32 Magic = UnversionedPropertyRecordMagic;
+	uint8 Format = static_cast<uint8>(SaveFormat);
+	uint32 SchemaHash = SaveFormat != EUnversionedPropertyRecordFormat::Tagged ? GetUnversionedPropertySchemaHash(Schema) : 0;
+
+	// Payload sizes are patched in after saving each payload and unreadable payloads are skipped on load
+	if (Ar.Tell() == INDEX_NONE)
+	{
+		UE_LOG(LogScriptSerialization, Warning, TEXT("Can't serialize unversioned property record for %s, archive %s is not seekable"), *Schema->GetName(), *Ar.GetArchiveName());
+		Ar.SetError();
+		return EUnversionedPropertyRecordResult::Error;
+	}
+
+	Ar << Magic;
+	if (Magic != UnversionedPropertyRecordMagic || Ar.IsError())
+	{
+		UE_LOG(LogScriptSerialization, Warning, TEXT("Invalid unversioned property record for %s"), *Schema->GetName());
+		Ar.SetError();
+		return EUnversionedPropertyRecordResult::Error;
+	}
+
+	Ar << Format;
+	Ar << SchemaHash;
+
+	if (Format > static_cast<uint8>(EUnversionedPropertyRecordFormat::UnversionedWithTaggedFallback))
+	{
+		Ar.SetError();
+		return EUnversionedPropertyRecordResult::Error;
+	}
+
+	const EUnversionedPropertyRecordFormat RecordFormat = static_cast<EUnversionedPropertyRecordFormat>(Format);
+	const bool bHasUnversionedPayload = RecordFormat != EUnversionedPropertyRecordFormat::Tagged;
+	const bool bHasTaggedPayload = RecordFormat != EUnversionedPropertyRecordFormat::Unversioned;
+	bool bOk = true;
+
+	if (Ar.IsSaving())
+	{
+		bOk = (!bHasUnversionedPayload || SerializeRecordPayload(Ar, Schema, true, SerializePayload))
+			&& (!bHasTaggedPayload || SerializeRecordPayload(Ar, Schema, false, SerializePayload));
+	}
+	else if (!bHasUnversionedPayload)
+	{
+		bOk = SerializeRecordPayload(Ar, Schema, false, SerializePayload);
+	}
+	else if (SchemaHash == GetUnversionedPropertySchemaHash(Schema))
+	{
+		bOk = SerializeRecordPayload(Ar, Schema, true, SerializePayload)
+			&& (!bHasTaggedPayload || SkipRecordPayload(Ar));
+	}
+	else if (bHasTaggedPayload)
+	{
+		UE_LOG(LogScriptSerialization, Log, TEXT("Loading tagged copy of unversioned property record for %s, property layout changed since it was saved"), *Schema->GetName());
+		bOk = SkipRecordPayload(Ar) && SerializeRecordPayload(Ar, Schema, false, SerializePayload);
+	}
+	else
+	{
+		UE_LOG(LogScriptSerialization, Warning, TEXT("Skipping unversioned property record for %s, property layout changed since it was saved and the record has no tagged copy"), *Schema->GetName());
+		return SkipRecordPayload(Ar) ? EUnversionedPropertyRecordResult::SchemaMismatch : EUnversionedPropertyRecordResult::Error;
+	}
+
+	return bOk ? EUnversionedPropertyRecordResult::Success : EUnversionedPropertyRecordResult::Error;
+}
+
+EUnversionedPropertyRecordResult SerializeUnversionedPropertyRecord(FArchive& Ar, UObject* Object, EUnversionedPropertyRecordFormat SaveFormat)
+{
+	check(Object);
+
+	return SerializePropertyRecord(Ar, Object->GetClass(), SaveFormat, [Object](FArchive& PayloadAr)
+	{
+		Object->SerializeScriptProperties(PayloadAr);
+	});
+}
+
+EUnversionedPropertyRecordResult SerializeUnversionedPropertyRecord(FArchive& Ar, UStruct* Struct, void* Data, const void* Defaults, EUnversionedPropertyRecordFormat SaveFormat)
+{
+	check(Struct && Data);
+
+	return SerializePropertyRecord(Ar, Struct, SaveFormat, [Struct, Data, Defaults](FArchive& PayloadAr)
+	{
+		Struct->SerializeTaggedProperties(PayloadAr, static_cast<uint8*>(Data), Struct, static_cast<uint8*>(const_cast<void*>(Defaults)));
+	});
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/UnversionedPropertyRecord.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/Class.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnversionedPropertyRecordTest
+{
+	#define TEST_NAME_ROOT "System.CoreUObject.Serialization.UnversionedPropertyRecord"
+	constexpr const uint32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Records are loaded into the struct they were saved from
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnversionedPropertyRecordTestRoundTrip, TEST_NAME_ROOT ".RoundTrip", TestFlags)
+	bool FUnversionedPropertyRecordTestRoundTrip::RunTest(const FString& Parameters)
+	{
+		UScriptStruct* Struct = TBaseStructure<FVector>::Get();
+
+		for (EUnversionedPropertyRecordFormat Format : { EUnversionedPropertyRecordFormat::Tagged, EUnversionedPropertyRecordFormat::Unversioned, EUnversionedPropertyRecordFormat::UnversionedWithTaggedFallback })
+		{
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			FVector Saved(1.f, 2.f, 3.f);
+			TestEqual(TEXT("Saving a record should succeed"), SerializeUnversionedPropertyRecord(Writer, Struct, &Saved, nullptr, Format), EUnversionedPropertyRecordResult::Success);
+
+			FMemoryReader Reader(Bytes);
+			FVector Loaded(0.f, 0.f, 0.f);
+			TestEqual(TEXT("Loading a record with an unchanged layout should succeed"), SerializeUnversionedPropertyRecord(Reader, Struct, &Loaded), EUnversionedPropertyRecordResult::Success);
+			TestEqual(TEXT("Loading a record with an unchanged layout should restore the properties"), Loaded, Saved);
+			TestEqual(TEXT("Loading a record should consume all of it"), Reader.Tell(), Reader.TotalSize());
+		}
+
+		return true;
+	}
+
+	// A record saved against another property layout is recovered from its tagged copy, property by property
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnversionedPropertyRecordTestLayoutChange, TEST_NAME_ROOT ".LayoutChange", TestFlags)
+	bool FUnversionedPropertyRecordTestLayoutChange::RunTest(const FString& Parameters)
+	{
+		// FVector stands in for a later version of FVector2D that gained a Z property
+		UScriptStruct* SavedStruct = TBaseStructure<FVector2D>::Get();
+		UScriptStruct* LoadedStruct = TBaseStructure<FVector>::Get();
+		TestNotEqual(TEXT("The test structs should have different schemas"), GetUnversionedPropertySchemaHash(SavedStruct), GetUnversionedPropertySchemaHash(LoadedStruct));
+
+		FVector2D Saved(1.f, 2.f);
+
+		{
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			SerializeUnversionedPropertyRecord(Writer, SavedStruct, &Saved);
+
+			FMemoryReader Reader(Bytes);
+			FVector Loaded(0.f, 0.f, 5.f);
+			TestEqual(TEXT("Loading a record with a changed layout should fall back to its tagged copy"), SerializeUnversionedPropertyRecord(Reader, LoadedStruct, &Loaded), EUnversionedPropertyRecordResult::Success);
+			TestEqual(TEXT("Properties present in both layouts should be recovered"), FVector2D(Loaded.X, Loaded.Y), Saved);
+			TestEqual(TEXT("Properties missing from the saved layout should be left untouched"), Loaded.Z, 5.f);
+			TestEqual(TEXT("Loading a record should consume all of it"), Reader.Tell(), Reader.TotalSize());
+		}
+
+		{
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			SerializeUnversionedPropertyRecord(Writer, SavedStruct, &Saved, nullptr, EUnversionedPropertyRecordFormat::Unversioned);
+
+			FMemoryReader Reader(Bytes);
+			FVector Loaded(0.f, 0.f, 5.f);
+			TestEqual(TEXT("Loading an unversioned only record with a changed layout should report the mismatch"), SerializeUnversionedPropertyRecord(Reader, LoadedStruct, &Loaded), EUnversionedPropertyRecordResult::SchemaMismatch);
+			TestEqual(TEXT("A mismatched record should leave the target untouched"), Loaded, FVector(0.f, 0.f, 5.f));
+			TestEqual(TEXT("A mismatched record should be skipped"), Reader.Tell(), Reader.TotalSize());
+		}
+
+		return true;
+	}
+
+	// A payload that doesn't read back to its saved size is an error, not a successful load
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnversionedPropertyRecordTestCorruptPayload, TEST_NAME_ROOT ".CorruptPayload", TestFlags)
+	bool FUnversionedPropertyRecordTestCorruptPayload::RunTest(const FString& Parameters)
+	{
+		UScriptStruct* Struct = TBaseStructure<FVector>::Get();
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FVector Saved(1.f, 2.f, 3.f);
+		SerializeUnversionedPropertyRecord(Writer, Struct, &Saved, nullptr, EUnversionedPropertyRecordFormat::Tagged);
+
+		// Grow the payload size stored after the magic, format and schema hash
+		int64 PayloadSize = 0;
+		const int32 PayloadSizeOffset = sizeof(uint32) + sizeof(uint8) + sizeof(uint32);
+		FMemory::Memcpy(&PayloadSize, &Bytes[PayloadSizeOffset], sizeof(PayloadSize));
+		PayloadSize += 4;
+		FMemory::Memcpy(&Bytes[PayloadSizeOffset], &PayloadSize, sizeof(PayloadSize));
+		Bytes.AddZeroed(4);
+
+		FMemoryReader Reader(Bytes);
+		FVector Loaded(0.f, 0.f, 0.f);
+		TestEqual(TEXT("Loading a record whose payload size doesn't match should fail"), SerializeUnversionedPropertyRecord(Reader, Struct, &Loaded), EUnversionedPropertyRecordResult::Error);
+		TestTrue(TEXT("Loading a record whose payload size doesn't match should flag the archive"), Reader.IsError());
+
+		return true;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
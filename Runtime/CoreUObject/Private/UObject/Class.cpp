@@ -2680,6 +2680,11 @@ void UScriptStruct::PrepareCppStructOps()
 		UE_LOG(LogClass, Verbose, TEXT("Native struct %s has native SerializeFromMismatchedTag."),*GetName());
 		StructFlags = EStructFlags(StructFlags | STRUCT_SerializeFromMismatchedTag);
 	}
+	if (CppStructOps->HasGeneratedPropertyOps())
+	{
+		UE_LOG(LogClass, Verbose, TEXT("Native struct %s has generated property ops."),*GetName());
+		StructFlags = EStructFlags(StructFlags | STRUCT_GeneratedPropertyOps);
+	}
 
 	check(!bPrepareCppStructOpsCompleted); // recursion is unacceptable
 	bPrepareCppStructOpsCompleted = true;
@@ -2701,6 +2706,23 @@ void UScriptStruct::Serialize( FArchive& Ar )
 	}
 }
 
+/**
+ * Generated property serialization writes the properties densely without tags or an unversioned header,
+ * so it is limited to cooked unversioned archives where every property selected by the mask is serialized.
+ */
+static bool CanUseGeneratedPropertySerialization(const FArchive& Ar)
+{
+	return Ar.UseUnversionedPropertySerialization()
+		&& Ar.IsPersistent()
+		&& Ar.IsFilterEditorOnly()
+		&& !Ar.IsTextFormat()
+		&& !Ar.IsSaveGame()
+		&& !Ar.IsTransacting()
+		&& !Ar.IsSerializingDefaults()
+		&& !Ar.ArUseCustomPropertyList
+		&& Ar.GetPortFlags() == 0;
+}
+
 bool UScriptStruct::UseBinarySerialization(const FArchive& Ar) const
 {
 	return !(Ar.IsLoading() || Ar.IsSaving())
@@ -2753,6 +2775,23 @@ void UScriptStruct::SerializeItem(FStructuredArchive::FSlot Slot, void* Value, v
 #endif
 		}		
 	}
+	else if ((StructFlags & STRUCT_GeneratedPropertyOps) && !bUseBinarySerialization && CanUseGeneratedPropertySerialization(UnderlyingArchive))
+	{
+		UScriptStruct::ICppStructOps* TheCppStructOps = GetCppStructOps();
+		check(TheCppStructOps); // else should not have STRUCT_GeneratedPropertyOps
+#if WITH_TEXT_ARCHIVE_SUPPORT
+		FArchiveUObjectFromStructuredArchive Adapter(Slot);
+		FArchive& Ar = Adapter.GetArchive();
+		bItemSerialized = TheCppStructOps->SerializeGeneratedProperties(Ar, Value, GeneratedPropertySerializeMask);
+		if (bItemSerialized && !Slot.IsFilled())
+		{
+			Slot.EnterRecord();
+		}
+		Adapter.Close();
+#else
+		bItemSerialized = TheCppStructOps->SerializeGeneratedProperties(UnderlyingArchive, Value, GeneratedPropertySerializeMask);
+#endif
+	}
 
 	if (!bItemSerialized)
 	{
@@ -2984,6 +3023,65 @@ void UScriptStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 			UE_LOG(LogClass, Verbose, TEXT("Non-Native struct %s has zero construction."),*GetName());
 		}
 	}
+
+	ValidateGeneratedPropertyOps();
+}
+
+void UScriptStruct::ValidateGeneratedPropertyOps()
+{
+	GeneratedPropertySerializeMask.Empty();
+	if (!(StructFlags & STRUCT_GeneratedPropertyOps))
+	{
+		return;
+	}
+
+	UScriptStruct::ICppStructOps* TheCppStructOps = GetCppStructOps();
+	check(TheCppStructOps); // else should not have STRUCT_GeneratedPropertyOps
+
+	TArray<int32> Offsets;
+	TArray<int32> Sizes;
+	TheCppStructOps->GetGeneratedPropertyLayout(Offsets, Sizes);
+
+	// Every reflected property has to be visited exactly once with a matching offset and size
+	int32 NumProperties = 0;
+	bool bMatches = true;
+	GeneratedPropertySerializeMask.Init(false, Offsets.Num());
+	for (FProperty* Property = PropertyLink; Property && bMatches; Property = Property->PropertyLinkNext)
+	{
+		++NumProperties;
+		const int32 Index = Offsets.IndexOfByKey(Property->GetOffset_ForInternal());
+		if (Index == INDEX_NONE || Sizes[Index] != Property->GetSize() || GeneratedPropertySerializeMask[Index])
+		{
+			UE_LOG(LogClass, Warning, TEXT("Native struct %s generated property ops don't match property %s, using property serialization instead."), *GetName(), *Property->GetName());
+			bMatches = false;
+			break;
+		}
+
+		// Flag the property as visited, then clear it again if it's never saved to cooked data
+		GeneratedPropertySerializeMask[Index] = true;
+		if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated | CPF_SkipSerialization) || Property->IsEditorOnlyProperty())
+		{
+			Offsets[Index] = INDEX_NONE;
+		}
+	}
+
+	if (bMatches && NumProperties != Offsets.Num())
+	{
+		UE_LOG(LogClass, Warning, TEXT("Native struct %s generated property ops visit %d properties but it has %d, using property serialization instead."), *GetName(), Offsets.Num(), NumProperties);
+		bMatches = false;
+	}
+
+	if (!bMatches)
+	{
+		GeneratedPropertySerializeMask.Empty();
+		StructFlags = EStructFlags(StructFlags & ~STRUCT_GeneratedPropertyOps);
+		return;
+	}
+
+	for (int32 Index = 0; Index < Offsets.Num(); ++Index)
+	{
+		GeneratedPropertySerializeMask[Index] = Offsets[Index] != INDEX_NONE;
+	}
 }
 
 bool UScriptStruct::CompareScriptStruct(const void* A, const void* B, uint32 PortFlags) const
@@ -3005,6 +3103,16 @@ bool UScriptStruct::CompareScriptStruct(const void* A, const void* B, uint32 Por
 			return bResult;
 		}
 	}
+	else if (StructFlags & STRUCT_GeneratedPropertyOps)
+	{
+		UScriptStruct::ICppStructOps* TheCppStructOps = GetCppStructOps();
+		check(TheCppStructOps);
+		bool bResult = false;
+		if (TheCppStructOps->IdenticalGeneratedProperties(A, B, PortFlags, bResult))
+		{
+			return bResult;
+		}
+	}
 
 	for( TFieldIterator<FProperty> It(this); It; ++It )
 	{
@@ -65,9 +65,9 @@ UObject* GetArchetypeFromRequiredInfoImpl(const UClass* Class, const UObject* Ou
 		if (Outer
 			&& Outer->GetClass() != UPackage::StaticClass()) // packages cannot have subobjects
 		{
-			// Get a lock on the UObject hash tables for the duration of the GetArchetype operation
-			void LockUObjectHashTables();
-			LockUObjectHashTables();
+			// Get a lock on the UObject hash maps for the duration of the GetArchetype operation, name hash lookups only lock their shard
+			void LockUObjectHashMaps();
+			LockUObjectHashMaps();
 
 			UObject* ArchetypeToSearch = nullptr;
 #if UE_CACHE_ARCHETYPE
@@ -121,8 +121,8 @@ UObject* GetArchetypeFromRequiredInfoImpl(const UClass* Class, const UObject* Ou
 				Result = ArchetypeToSearch->GetClass()->FindArchetype(Class, Name);
 			}
 
-			void UnlockUObjectHashTables();
-			UnlockUObjectHashTables();
+			void UnlockUObjectHashMaps();
+			UnlockUObjectHashMaps();
 		}
 
 		if (!Result)
@@ -3205,6 +3205,63 @@ UObject* StaticConstructObject_Internal(const FStaticConstructObjectParameters&
 	return Result;
 }
 
+void StaticConstructObjects_Internal(const FStaticConstructObjectParameters& Params, int32 NumObjects, TArray<UObject*>& OutObjects)
+{
+	const UClass* InClass = Params.Class;
+	UObject* InOuter = Params.Outer;
+	EObjectFlags InFlags = Params.SetFlags;
+	UObject* InTemplate = Params.Template;
+
+	LLM_SCOPE(ELLMTag::UObject);
+
+	SCOPE_CYCLE_COUNTER(STAT_ConstructObject);
+
+	if (NumObjects <= 0)
+	{
+		return;
+	}
+
+#if WITH_EDITORONLY_DATA
+	UE_CLOG(GIsSavingPackage && InOuter != GetTransientPackage(), LogUObjectGlobals, Fatal, TEXT("Illegal call to StaticConstructObjects() while serializing object data! (Object will not be saved!)"));
+#endif
+
+	checkf(Params.Name == NAME_None, TEXT("StaticConstructObjects can't create objects with the explicit name %s, every object is given a unique name."), *Params.Name.ToString());
+	checkf(!(InFlags & RF_ClassDefaultObject), TEXT("StaticConstructObjects can't create class default objects of %s."), *GetFullNameSafe(InClass));
+	checkf(!InTemplate || InTemplate->IsA(InClass), TEXT("StaticConstructObjects %s is not an instance of class %s."), *GetFullNameSafe(InTemplate), *GetFullNameSafe(InClass)); // template must be an instance of the class we are creating
+
+	const int32 FirstResultIndex = OutObjects.Num();
+	OutObjects.Reserve(FirstResultIndex + NumObjects);
+	{
+		// Unnamed objects never replace or recycle existing objects, so they can all be allocated up front
+		// and added to the hash tables in one batch before running any constructor
+		FScopedUObjectHashBatch HashBatch;
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			UObject* Result = StaticAllocateObject(InClass, InOuter, NAME_None, InFlags, Params.InternalSetFlags, false, nullptr, Params.ExternalPackage);
+			check(Result != NULL);
+			OutObjects.Add(Result);
+		}
+	}
+
+	const bool bSaveToTransactionBuffer = GIsEditor && GUndo && (InFlags & RF_Transactional) && !(InFlags & RF_NeedLoad) && !InClass->IsChildOf(UField::StaticClass());
+	for (int32 Index = FirstResultIndex; Index < OutObjects.Num(); ++Index)
+	{
+		UObject* Result = OutObjects[Index];
+		{
+			STAT(FScopeCycleCounterUObject ConstructorScope(InClass->GetFName().IsNone() ? nullptr : InClass, GET_STATID(STAT_ConstructObject)));
+			(*InClass->ClassConstructor)( FObjectInitializer(Result, InTemplate, Params.bCopyTransientsFromClassDefaults, true, Params.InstanceGraph) );
+		}
+
+		if (bSaveToTransactionBuffer)
+		{
+			// Set RF_PendingKill and update the undo buffer so an undo operation will set RF_PendingKill on the newly constructed object.
+			Result->MarkPendingKill();
+			SaveToTransactionBuffer(Result, false);
+			Result->ClearPendingKill();
+		}
+	}
+}
+
 void FObjectInitializer::AssertIfInConstructor(UObject* Outer, const TCHAR* ErrorMessage)
 {
 	FUObjectThreadContext& ThreadContext = FUObjectThreadContext::Get();
@@ -10,6 +10,8 @@
 #include "Misc/AsciiSet.h"
 #include "Misc/PackageName.h"
 #include "HAL/IConsoleManager.h"
+#include "Misc/ScopeRWLock.h"
+#include "Algo/Sort.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUObjectHash, Log, All);
 
@@ -273,16 +275,72 @@ struct FHashBucketIterator
 	}
 };
 
+/**
+ * One shard of the object name hashes. Objects are spread over the shards by name hash so that lookups
+ * (StaticFindObjectFast etc.) only contend with adds and removes of objects landing in the same shard.
+ */
+struct FUObjectHashShard
+{
+	/** Readers (object lookups) share the shard, HashObject/UnhashObject take it exclusively */
+	FRWLock Lock;
+
+	/** Hash sets */
+	TMap<int32, FHashBucket> Hash;
+	TMultiMap<int32, class UObjectBase*> HashOuter;
+
+	/** Checks if the Hash/Object pair exists in the FName hash table */
+	FORCEINLINE bool PairExistsInHash(int32 InHash, UObjectBase* Object)
+	{
+		bool bResult = false;
+		FHashBucket* Bucket = Hash.Find(InHash);
+		if (Bucket)
+		{
+			bResult = Bucket->Contains(Object);
+		}
+		return bResult;
+	}
+	/** Adds the Hash/Object pair to the FName hash table */
+	FORCEINLINE void AddToHash(int32 InHash, UObjectBase* Object)
+	{
+		FHashBucket& Bucket = Hash.FindOrAdd(InHash);
+		Bucket.Add(Object);
+	}
+	/** Removes the Hash/Object pair from the FName hash table */
+	FORCEINLINE int32 RemoveFromHash(int32 InHash, UObjectBase* Object)
+	{
+		int32 NumRemoved = 0;
+		FHashBucket* Bucket = Hash.Find(InHash);
+		if (Bucket)
+		{
+			NumRemoved = Bucket->Remove(Object);
+			if (Bucket->Num() == 0)
+			{
+				Hash.Remove(InHash);
+			}
+		}
+		return NumRemoved;
+	}
+};
+
 class FUObjectHashTables
 {
-	/** Critical section that guards against concurrent adds from multiple threads */
+	/** Critical section that guards the outer, class and package maps against concurrent access from multiple threads */
 	FCriticalSection CriticalSection;
 
+	/** Number of nested LockAll calls, only accessed while CriticalSection is held */
+	int32 LockAllDepth;
+
+	/** Id of the thread that holds all the shards through LockAll, 0 if none does */
+	TAtomic<uint32> LockAllOwnerThreadId;
+
 public:
 
-	/** Hash sets */
-	TMap<int32, FHashBucket> Hash;
-	TMultiMap<int32, class UObjectBase*> HashOuter;
+	/** Number of object name hash shards, must be a power of two */
+	static constexpr int32 NumShardsBits = 5;
+	static constexpr int32 NumShards = 1 << NumShardsBits;
+
+	/** Object name hashes, sharded by hash */
+	FUObjectHashShard Shards[NumShards];
 
 	/** Map of object to their outers, used to avoid an object iterator to find such things. **/
 	TMap<UObjectBase*, FHashBucket> ObjectOuterMap;
@@ -296,19 +354,43 @@ public:
 	TMap<UObjectBase*, UPackage*> ObjectToPackageMap;
 
 	FUObjectHashTables()
-		: ClassToChildListMapVersion(0)
+		: LockAllDepth(0)
+		, LockAllOwnerThreadId(0)
+		, ClassToChildListMapVersion(0)
+	{
+	}
+
+	/** Returns the index of the name hash shard an object hash belongs to */
+	static FORCEINLINE int32 GetShardIndex(int32 InHash)
+	{
+		// Object hashes are mostly sequential name indices, spread them over the shards with a multiplicative hash
+		return int32(((uint32)InHash * 0x9E3779B1u) >> (32 - NumShardsBits));
+	}
+
+	/** Returns the name hash shard an object hash belongs to */
+	FORCEINLINE FUObjectHashShard& GetShard(int32 InHash)
+	{
+		return Shards[GetShardIndex(InHash)];
+	}
+
+	/** Returns true if the current thread holds all the tables through LockAll, in which case the shards must not be locked again */
+	FORCEINLINE bool IsLockedAllByCurrentThread() const
 	{
+		return LockAllOwnerThreadId.Load(EMemoryOrder::Relaxed) == FPlatformTLS::GetCurrentThreadId();
 	}
 
 	void ShrinkMaps()
 	{
 		double StartTime = FPlatformTime::Seconds();
-		Hash.Compact();
-		for (auto& Pair : Hash)
+		for (FUObjectHashShard& Shard : Shards)
 		{
-			Pair.Value.Compact();
+			Shard.Hash.Compact();
+			for (auto& Pair : Shard.Hash)
+			{
+				Pair.Value.Compact();
+			}
+			Shard.HashOuter.Compact();
 		}
-		HashOuter.Compact();
 		ObjectOuterMap.Compact();
 		for (auto& Pair : ObjectOuterMap)
 		{
@@ -333,47 +415,42 @@ public:
 		UE_LOG(LogUObjectHash, Log, TEXT("Compacting FUObjectHashTables data took %6.2fms"), 1000.0f * float(FPlatformTime::Seconds() - StartTime));
 	}
 
-	/** Checks if the Hash/Object pair exists in the FName hash table */
-	FORCEINLINE bool PairExistsInHash(int32 InHash, UObjectBase* Object)
+	FORCEINLINE void Lock()
 	{
-		bool bResult = false;
-		FHashBucket* Bucket = Hash.Find(InHash);
-		if (Bucket)
-		{
-			bResult = Bucket->Contains(Object);
-		}
-		return bResult;
+		CriticalSection.Lock();
 	}
-	/** Adds the Hash/Object pair to the FName hash table */
-	FORCEINLINE void AddToHash(int32 InHash, UObjectBase* Object)
+
+	FORCEINLINE void Unlock()
 	{
-		FHashBucket& Bucket = Hash.FindOrAdd(InHash);
-		Bucket.Add(Object);
+		CriticalSection.Unlock();
 	}
-	/** Removes the Hash/Object pair from the FName hash table */
-	FORCEINLINE int32 RemoveFromHash(int32 InHash, UObjectBase* Object)
+
+	/** Locks the maps and all the name hash shards, so that no other thread can find, add or remove objects */
+	void LockAll()
 	{
-		int32 NumRemoved = 0;
-		FHashBucket* Bucket = Hash.Find(InHash);
-		if (Bucket)
+		Lock();
+		if (LockAllDepth++ == 0)
 		{
-			NumRemoved = Bucket->Remove(Object);
-			if (Bucket->Num() == 0)
+			for (FUObjectHashShard& Shard : Shards)
 			{
-				Hash.Remove(InHash);
+				Shard.Lock.WriteLock();
 			}
+			LockAllOwnerThreadId = FPlatformTLS::GetCurrentThreadId();
 		}
-		return NumRemoved;
-	}
-
-	FORCEINLINE void Lock()
-	{
-		CriticalSection.Lock();
 	}
 
-	FORCEINLINE void Unlock()
+	void UnlockAll()
 	{
-		CriticalSection.Unlock();
+		check(LockAllDepth > 0);
+		if (--LockAllDepth == 0)
+		{
+			LockAllOwnerThreadId = 0;
+			for (FUObjectHashShard& Shard : Shards)
+			{
+				Shard.Lock.WriteUnlock();
+			}
+		}
+		Unlock();
 	}
 
 	static FUObjectHashTables& Get()
@@ -416,6 +493,92 @@ public:
 	}
 };
 
+/** Scoped lock of the maps and all the name hash shards */
+class FHashTableLockAll
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashTables* Tables;
+#endif
+public:
+	FORCEINLINE FHashTableLockAll(FUObjectHashTables& InTables)
+	{
+#if THREADSAFE_UOBJECTS
+		if (!(IsGarbageCollecting() && IsInGameThread()))
+		{
+			Tables = &InTables;
+			InTables.LockAll();
+		}
+		else
+		{
+			Tables = nullptr;
+		}
+#else
+		check(IsInGameThread());
+#endif
+	}
+	FORCEINLINE ~FHashTableLockAll()
+	{
+#if THREADSAFE_UOBJECTS
+		if (Tables)
+		{
+			Tables->UnlockAll();
+		}
+#endif
+	}
+};
+
+/** Scoped lock of a single name hash shard, skipped when the current thread already holds all the tables */
+template<FRWScopeLockType LockType>
+class THashShardLock
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashShard* Shard;
+#endif
+public:
+	FORCEINLINE THashShardLock(FUObjectHashTables& InTables, FUObjectHashShard& InShard)
+	{
+#if THREADSAFE_UOBJECTS
+		if (!InTables.IsLockedAllByCurrentThread())
+		{
+			Shard = &InShard;
+			if (LockType == SLT_ReadOnly)
+			{
+				InShard.Lock.ReadLock();
+			}
+			else
+			{
+				InShard.Lock.WriteLock();
+			}
+		}
+		else
+		{
+			Shard = nullptr;
+		}
+#else
+		check(IsInGameThread());
+#endif
+	}
+	FORCEINLINE ~THashShardLock()
+	{
+#if THREADSAFE_UOBJECTS
+		if (Shard)
+		{
+			if (LockType == SLT_ReadOnly)
+			{
+				Shard->Lock.ReadUnlock();
+			}
+			else
+			{
+				Shard->Lock.WriteUnlock();
+			}
+		}
+#endif
+	}
+};
+
+typedef THashShardLock<SLT_ReadOnly> FHashShardReadLock;
+typedef THashShardLock<SLT_Write> FHashShardWriteLock;
+
 /**
  * Calculates the object's hash just using the object's name index
  *
@@ -446,8 +609,9 @@ UObject* StaticFindObjectFastExplicitThreadSafe(FUObjectHashTables& ThreadHash,
 
 	// Find an object with the specified name and (optional) class, in any package; if bAnyPackage is false, only matches top-level packages
 	int32 Hash = GetObjectHash(ObjectName);
-	FHashTableLock HashLock(ThreadHash);
-	FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+	FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+	FHashShardReadLock HashLock(ThreadHash, Shard);
+	FHashBucket* Bucket = Shard.Hash.Find(Hash);
 	if (Bucket)
 	{
 		for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -574,6 +738,7 @@ UObject* StaticFindObjectInPackageInternal(FUObjectHashTables& ThreadHash, const
 {
 	ExclusiveInternalFlags |= EInternalObjectFlags::Unreachable;
 	UObject* Result = nullptr;
+	FHashTableLock HashLock(ThreadHash);
 	if (FHashBucket* Inners = ThreadHash.PackageToObjectListMap.Find(ObjectPackage))
 	{
 #if !UE_BUILD_SHIPPING
@@ -619,43 +784,47 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 	if (ObjectPackage != nullptr)
 	{
 		int32 Hash = GetObjectOuterHash(ObjectName, (PTRINT)ObjectPackage);
-		FHashTableLock HashLock(ThreadHash);
-		for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(ThreadHash.HashOuter, Hash); HashIt; ++HashIt)
+		FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
 		{
-			UObject *Object = (UObject *)HashIt.Value();
-			if
-				/* check that the name matches the name we're searching for */
-				((Object->GetFName() == ObjectName)
+			FHashShardReadLock HashLock(ThreadHash, Shard);
+			for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(Shard.HashOuter, Hash); HashIt; ++HashIt)
+			{
+				UObject *Object = (UObject *)HashIt.Value();
+				if
+					/* check that the name matches the name we're searching for */
+					((Object->GetFName() == ObjectName)
 
-				/* Don't return objects that have any of the exclusive flags set */
-				&& !Object->HasAnyFlags(ExcludeFlags)
+					/* Don't return objects that have any of the exclusive flags set */
+					&& !Object->HasAnyFlags(ExcludeFlags)
 
-				/* check that the object has the correct Outer */
-				&& Object->GetOuter() == ObjectPackage
+					/* check that the object has the correct Outer */
+					&& Object->GetOuter() == ObjectPackage
 
-				/** If a class was specified, check that the object is of the correct class */
-				&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
-				
-				/** Include (or not) pending kill objects */
-				&& !Object->HasAnyInternalFlags(ExclusiveInternalFlags))
-			{
-				checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
-				if (Result)
-				{
-					UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
-				}
-				else
+					/** If a class was specified, check that the object is of the correct class */
+					&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
+					
+					/** Include (or not) pending kill objects */
+					&& !Object->HasAnyInternalFlags(ExclusiveInternalFlags))
 				{
-					Result = Object;
-				}
+					checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
+					if (Result)
+					{
+						UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
+					}
+					else
+					{
+						Result = Object;
+					}
 #if (UE_BUILD_SHIPPING || UE_BUILD_TEST)
-				break;
+					break;
 #endif
+				}
 			}
 		}
 
 #if WITH_EDITOR
 		// if the search fail and the OuterPackage is a UPackage, lookup potential external package
+		// The shard lock has been released, the package map is guarded by the tables lock
 		if (Result == nullptr && ObjectPackage->IsA(UPackage::StaticClass()))
 		{
 			Result = StaticFindObjectInPackageInternal(ThreadHash, ObjectClass, static_cast<const UPackage*>(ObjectPackage), ObjectName, bExactClass, ExcludeFlags, ExclusiveInternalFlags);
@@ -667,9 +836,10 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 		FObjectSearchPath SearchPath(ObjectName);
 
 		const int32 Hash = GetObjectHash(SearchPath.Inner);
-		FHashTableLock HashLock(ThreadHash);
+		FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+		FHashShardReadLock HashLock(ThreadHash, Shard);
 
-		FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+		FHashBucket* Bucket = Shard.Hash.Find(Hash);
 		if (Bucket)
 		{
 			for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -859,7 +1029,7 @@ FORCEINLINE static UPackage* UnassignExternalPackageFromObject(FUObjectHashTable
 void ShrinkUObjectHashTables()
 {
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	FHashTableLockAll HashLock(ThreadHash);
 	ThreadHash.ShrinkMaps();
 }
 
@@ -1255,28 +1425,127 @@ void AllocateUObjectIndexForCurrentThread(UObjectBase* Object)
 	GUObjectArray.AllocateUObjectIndex(Object);
 }
 
-void HashObject(UObjectBase* Object)
+/** Batch the current thread's HashObject calls are deferred to, see FScopedUObjectHashBatch */
+static thread_local TArray<UObjectBase*>* GUObjectHashBatch = nullptr;
+
+FScopedUObjectHashBatch::FScopedUObjectHashBatch()
+	: OuterBatch(GUObjectHashBatch)
+{
+	GUObjectHashBatch = &Objects;
+}
+
+/** Adds a batch of objects to the hash tables, locking each name hash shard and the maps once */
+static void HashObjectBatch(TArrayView<UObjectBase* const> Objects)
 {
 	SCOPE_CYCLE_COUNTER( STAT_Hash_HashObject );
 
+	struct FBatchEntry
+	{
+		UObjectBase* Object;
+		int32 Hash;
+		int32 ShardIndex;
+		bool bOuterHash;
+	};
+
+	TArray<FBatchEntry> Entries;
+	Entries.Reserve(Objects.Num() * 2);
+	for (UObjectBase* Object : Objects)
+	{
+		const FName Name = Object->GetFName();
+		const int32 Hash = GetObjectHash(Name);
+		Entries.Add({ Object, Hash, FUObjectHashTables::GetShardIndex(Hash), false });
+		if (PTRINT Outer = (PTRINT)Object->GetOuter())
+		{
+			const int32 OuterHash = GetObjectOuterHash(Name, Outer);
+			Entries.Add({ Object, OuterHash, FUObjectHashTables::GetShardIndex(OuterHash), true });
+		}
+	}
+	Algo::SortBy(Entries, &FBatchEntry::ShardIndex);
+
+	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
+	for (int32 RangeStart = 0; RangeStart < Entries.Num(); )
+	{
+		const int32 ShardIndex = Entries[RangeStart].ShardIndex;
+		FUObjectHashShard& Shard = ThreadHash.Shards[ShardIndex];
+		FHashShardWriteLock ShardLock(ThreadHash, Shard);
+		int32 Index = RangeStart;
+		for (; Index < Entries.Num() && Entries[Index].ShardIndex == ShardIndex; ++Index)
+		{
+			const FBatchEntry& Entry = Entries[Index];
+			if (Entry.bOuterHash)
+			{
+				checkSlow(!Shard.HashOuter.FindPair(Entry.Hash, Entry.Object));  // if it already exists, something is wrong with the external code
+				Shard.HashOuter.Add(Entry.Hash, Entry.Object);
+			}
+			else
+			{
+				checkSlow(!Shard.PairExistsInHash(Entry.Hash, Entry.Object));  // if it already exists, something is wrong with the external code
+				Shard.AddToHash(Entry.Hash, Entry.Object);
+			}
+		}
+		RangeStart = Index;
+	}
+
+	FHashTableLock HashLock(ThreadHash);
+	for (UObjectBase* Object : Objects)
+	{
+		if (Object->GetOuter())
+		{
+			AddToOuterMap(ThreadHash, Object);
+		}
+		AddToClassMap(ThreadHash, Object);
+	}
+}
+
+FScopedUObjectHashBatch::~FScopedUObjectHashBatch()
+{
+	check(GUObjectHashBatch == &Objects);
+	GUObjectHashBatch = OuterBatch;
+	if (Objects.Num())
+	{
+		HashObjectBatch(Objects);
+	}
+}
+
+void HashObject(UObjectBase* Object)
+{
 	FName Name = Object->GetFName();
+	if (Name != NAME_None && GUObjectHashBatch)
+	{
+		GUObjectHashBatch->Add(Object);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER( STAT_Hash_HashObject );
+
 	if (Name != NAME_None)
 	{
 		int32 Hash = 0;
 
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
 
-		Hash = GetObjectHash(Name);				
-		checkSlow(!ThreadHash.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
-		ThreadHash.AddToHash(Hash, Object);
+		// Shard locks are never held while acquiring another lock, so each one is taken in its own scope
+		{
+			Hash = GetObjectHash(Name);
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardWriteLock ShardLock(ThreadHash, Shard);
+			checkSlow(!Shard.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
+			Shard.AddToHash(Hash, Object);
+		}
 
-		if (PTRINT Outer = (PTRINT)Object->GetOuter())
+		PTRINT Outer = (PTRINT)Object->GetOuter();
+		if (Outer)
 		{
 			Hash = GetObjectOuterHash(Name, Outer);
-			checkSlow(!ThreadHash.HashOuter.FindPair(Hash, Object));  // if it already exists, something is wrong with the external code
-			ThreadHash.HashOuter.Add(Hash, Object);
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardWriteLock ShardLock(ThreadHash, Shard);
+			checkSlow(!Shard.HashOuter.FindPair(Hash, Object));  // if it already exists, something is wrong with the external code
+			Shard.HashOuter.Add(Hash, Object);
+		}
 
+		FHashTableLock HashLock(ThreadHash);
+		if (Outer)
+		{
 			AddToOuterMap(ThreadHash, Object);
 		}
 
@@ -1300,22 +1569,32 @@ void UnhashObject(UObjectBase* Object)
 		int32 NumRemoved = 0;
 
 		FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock LockHash(ThreadHash);
 
-		Hash = GetObjectHash(Name);
-		NumRemoved = ThreadHash.RemoveFromHash(Hash, Object);
+		{
+			Hash = GetObjectHash(Name);
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardWriteLock ShardLock(ThreadHash, Shard);
+			NumRemoved = Shard.RemoveFromHash(Hash, Object);
+		}
 
 		// must have existed, else something is wrong with the external code
 		UE_CLOG(NumRemoved != 1, LogUObjectHash, Fatal, TEXT("Internal Error: RemoveFromHash NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
 
-		if (PTRINT Outer = (PTRINT)Object->GetOuter())
+		PTRINT Outer = (PTRINT)Object->GetOuter();
+		if (Outer)
 		{
 			Hash = GetObjectOuterHash(Name, Outer);
-			NumRemoved = ThreadHash.HashOuter.RemoveSingle(Hash, Object);
+			FUObjectHashShard& Shard = ThreadHash.GetShard(Hash);
+			FHashShardWriteLock ShardLock(ThreadHash, Shard);
+			NumRemoved = Shard.HashOuter.RemoveSingle(Hash, Object);
+		}
 
-			// must have existed, else something is wrong with the external code
-			UE_CLOG(NumRemoved != 1, LogUObjectHash, Fatal, TEXT("Internal Error: Remove from HashOuter NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
+		// must have existed, else something is wrong with the external code
+		UE_CLOG(Outer && NumRemoved != 1, LogUObjectHash, Fatal, TEXT("Internal Error: Remove from HashOuter NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
 
+		FHashTableLock LockHash(ThreadHash);
+		if (Outer)
+		{
 			RemoveFromOuterMap(ThreadHash, Object);
 		}
 
@@ -1371,11 +1650,12 @@ UPackage* GetObjectExternalPackageInternal(const UObjectBase* Object)
 
 /**
  * Prevents any other threads from finding/adding UObjects (e.g. while GC is running)
+ * Write locks every name hash shard, so only use it when lookups from other threads have to be blocked too.
 */
 void LockUObjectHashTables()
 {
 #if THREADSAFE_UOBJECTS
-	FUObjectHashTables::Get().Lock();
+	FUObjectHashTables::Get().LockAll();
 #else
 	check(IsInGameThread());
 #endif
@@ -1386,6 +1666,31 @@ void LockUObjectHashTables()
  */
 void UnlockUObjectHashTables()
 {
+#if THREADSAFE_UOBJECTS
+	FUObjectHashTables::Get().UnlockAll();
+#else
+	check(IsInGameThread());
+#endif
+}
+
+/**
+ * Prevents any other threads from adding/removing UObjects to the outer, class and package maps (e.g. while resolving archetypes)
+ * Name hash lookups and updates of other threads go on, they only lock the shard they touch.
+ */
+void LockUObjectHashMaps()
+{
+#if THREADSAFE_UOBJECTS
+	FUObjectHashTables::Get().Lock();
+#else
+	check(IsInGameThread());
+#endif
+}
+
+/**
+ * Releases the UObject hash maps lock
+ */
+void UnlockUObjectHashMaps()
+{
 #if THREADSAFE_UOBJECTS
 	FUObjectHashTables::Get().Unlock();
 #else
@@ -1534,9 +1839,17 @@ void LogHashStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInf
 	Ar.Logf(TEXT("Hash efficiency statistics for the Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().Hash, Ar, bShowHashBucketCollisionInfo);
-	Ar.Logf(TEXT(""));
+	FHashTableLockAll HashLock(FUObjectHashTables::Get());
+	for (int32 ShardIndex = 0; ShardIndex < FUObjectHashTables::NumShards; ++ShardIndex)
+	{
+		FUObjectHashShard& Shard = FUObjectHashTables::Get().Shards[ShardIndex];
+		if (Shard.Hash.Num())
+		{
+			Ar.Logf(TEXT("Shard %d:"), ShardIndex);
+			LogHashStatisticsInternal(Shard.Hash, Ar, bShowHashBucketCollisionInfo);
+			Ar.Logf(TEXT(""));
+		}
+	}
 }
 
 void LogHashOuterStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
@@ -1544,9 +1857,17 @@ void LogHashOuterStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisi
 	Ar.Logf(TEXT("Hash efficiency statistics for the Outer Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().HashOuter, Ar, bShowHashBucketCollisionInfo);
-	Ar.Logf(TEXT(""));
+	FHashTableLockAll HashLock(FUObjectHashTables::Get());
+	for (int32 ShardIndex = 0; ShardIndex < FUObjectHashTables::NumShards; ++ShardIndex)
+	{
+		FUObjectHashShard& Shard = FUObjectHashTables::Get().Shards[ShardIndex];
+		if (Shard.HashOuter.Num())
+		{
+			Ar.Logf(TEXT("Shard %d:"), ShardIndex);
+			LogHashStatisticsInternal(Shard.HashOuter, Ar, bShowHashBucketCollisionInfo);
+			Ar.Logf(TEXT(""));
+		}
+	}
 
 	uint32 HashOuterMapSize = 0;
 	for (TPair<UObjectBase*, FHashBucket>& OuterMapEntry : FUObjectHashTables::Get().ObjectOuterMap)
@@ -1563,15 +1884,19 @@ void LogHashMemoryOverheadStatistics(FOutputDevice& Ar, const bool bShowIndividu
 	Ar.Logf(TEXT("-------------------------------------------------"));
 
 	FUObjectHashTables& HashTables = FUObjectHashTables::Get();
-	FHashTableLock HashLock(HashTables);
+	FHashTableLockAll HashLock(HashTables);
 
 	int64 TotalSize = 0;
 	
 	{
-		int64 Size = HashTables.Hash.GetAllocatedSize();
-		for (const TPair<int32, FHashBucket>& Pair : HashTables.Hash)
+		int64 Size = 0;
+		for (const FUObjectHashShard& Shard : HashTables.Shards)
 		{
-			Size += Pair.Value.GetItemsSize();
+			Size += Shard.Hash.GetAllocatedSize();
+			for (const TPair<int32, FHashBucket>& Pair : Shard.Hash)
+			{
+				Size += Pair.Value.GetItemsSize();
+			}
 		}
 		if (bShowIndividualStats)
 		{
@@ -1581,7 +1906,11 @@ void LogHashMemoryOverheadStatistics(FOutputDevice& Ar, const bool bShowIndividu
 	}
 
 	{
-		int64 Size = HashTables.HashOuter.GetAllocatedSize();
+		int64 Size = 0;
+		for (const FUObjectHashShard& Shard : HashTables.Shards)
+		{
+			Size += Shard.HashOuter.GetAllocatedSize();
+		}
 		if (bShowIndividualStats)
 		{
 			Ar.Logf(TEXT("Memory used by UObject Outer Hash: %lld bytes."), Size);
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+class UStruct;
+
+/** How the properties inside an unversioned property record are encoded */
+enum class EUnversionedPropertyRecordFormat : uint8
+{
+	/** Regular tagged property serialization, tolerant to property changes */
+	Tagged,
+	/** Compact schema based encoding used by cooked packages, requires identical property layout on load */
+	Unversioned,
+	/** Unversioned payload followed by a tagged copy, which is loaded instead when the property layout changed since saving */
+	UnversionedWithTaggedFallback,
+};
+
+/** Outcome of serializing an unversioned property record */
+enum class EUnversionedPropertyRecordResult : uint8
+{
+	/** The record was saved or loaded */
+	Success,
+	/** The record was written unversioned only against a different property layout, its payload was skipped and the target left untouched */
+	SchemaMismatch,
+	/** The archive does not contain a valid record or errored */
+	Error,
+};
+
+/**
+ * Returns a hash of the property layout that unversioned property serialization of Struct depends on.
+ * Covers property names, property types, static array dimensions, container elements and the schema hashes of nested structs.
+ * Editor only properties are excluded like they are from the unversioned schema itself. The hash is stable across runs and builds.
+ */
+COREUOBJECT_API uint32 GetUnversionedPropertySchemaHash(const UStruct* Struct);
+
+/**
+ * Serializes the script properties of an object as a self contained record for save games and other non-package archives,
+ * e.g. through a FObjectAndNameAsStringProxyArchive.
+ *
+ * The record starts with a header holding the encoding, the schema hash of the object's class and the payload size.
+ * Unversioned payloads skip FPropertyTag names, types and sizes entirely. On load, an unversioned payload is only read
+ * if the schema hash still matches the class. Otherwise the tagged copy written by UnversionedWithTaggedFallback is
+ * loaded property by property, or, for Unversioned records, the payload is skipped and SchemaMismatch is returned.
+ * Tagged records are always loaded.
+ *
+ * The archive must be seekable (Tell() != INDEX_NONE), payload sizes are patched in after each payload and are used to skip
+ * payloads on load. Non seekable archives are flagged as errored and nothing is serialized. A payload that doesn't read
+ * back to its saved size flags the archive as errored.
+ *
+ * @param Ar		Archive to save to or load from. Its unversioned flag is restored afterwards.
+ * @param Object	Object whose script properties are serialized
+ * @param SaveFormat	Encoding to use when saving, ignored when loading
+ * @return Success, or why the record was not serialized
+ */
+COREUOBJECT_API EUnversionedPropertyRecordResult SerializeUnversionedPropertyRecord(FArchive& Ar, UObject* Object, EUnversionedPropertyRecordFormat SaveFormat = EUnversionedPropertyRecordFormat::UnversionedWithTaggedFallback);
+
+/**
+ * Serializes the properties of a struct instance as a self contained record, see the UObject overload.
+ *
+ * @param Ar		Archive to save to or load from, must be seekable
+ * @param Struct	Type of Data
+ * @param Data		Struct instance to serialize
+ * @param Defaults	Optional instance of Struct to delta against when saving
+ * @param SaveFormat	Encoding to use when saving, ignored when loading
+ * @return Success, or why the record was not serialized
+ */
+COREUOBJECT_API EUnversionedPropertyRecordResult SerializeUnversionedPropertyRecord(FArchive& Ar, UStruct* Struct, void* Data, const void* Defaults = nullptr, EUnversionedPropertyRecordFormat SaveFormat = EUnversionedPropertyRecordFormat::UnversionedWithTaggedFallback);
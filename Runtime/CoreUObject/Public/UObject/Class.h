@@ -674,11 +674,14 @@ enum EStructFlags
 	/** If set, this struct has been cleaned and sanitized (trashed) and should not be used */
 	STRUCT_Trashed = 0x00800000,
 
+	/** If set, this struct has compile time generated property serialization and comparison that matched its reflected properties when linked */
+	STRUCT_GeneratedPropertyOps = 0x01000000,
+
 	/** Struct flags that are automatically inherited */
 	STRUCT_Inherit				= STRUCT_HasInstancedReference|STRUCT_Atomic,
 
 	/** Flags that are always computed, never loaded or done with code generation */
-	STRUCT_ComputedFlags		= STRUCT_NetDeltaSerializeNative | STRUCT_NetSerializeNative | STRUCT_SerializeNative | STRUCT_PostSerializeNative | STRUCT_CopyNative | STRUCT_IsPlainOldData | STRUCT_NoDestructor | STRUCT_ZeroConstructor | STRUCT_IdenticalNative | STRUCT_AddStructReferencedObjects | STRUCT_ExportTextItemNative | STRUCT_ImportTextItemNative | STRUCT_SerializeFromMismatchedTag | STRUCT_PostScriptConstruct | STRUCT_NetSharedSerialization
+	STRUCT_ComputedFlags		= STRUCT_NetDeltaSerializeNative | STRUCT_NetSerializeNative | STRUCT_SerializeNative | STRUCT_PostSerializeNative | STRUCT_CopyNative | STRUCT_IsPlainOldData | STRUCT_NoDestructor | STRUCT_ZeroConstructor | STRUCT_IdenticalNative | STRUCT_AddStructReferencedObjects | STRUCT_ExportTextItemNative | STRUCT_ImportTextItemNative | STRUCT_SerializeFromMismatchedTag | STRUCT_PostScriptConstruct | STRUCT_NetSharedSerialization | STRUCT_GeneratedPropertyOps
 };
 
 
@@ -706,6 +709,7 @@ struct TStructOpsTypeTraitsBase2
 		WithStructuredSerializeFromMismatchedTag = false,               // struct has an FStructuredArchive-based SerializeFromMismatchedTag function for converting from other property tags.
 		WithPostScriptConstruct        = false,				// struct has a PostScriptConstruct function which is called after it is constructed in blueprints
 		WithNetSharedSerialization     = false,                         // struct has a NetSerialize function that does not require the package map to serialize its state.
+		WithGeneratedPropertyOps       = false,                         // struct has a static VisitGeneratedProperties function listing all its reflected properties, see UObject/GeneratedStructOps.h.
 	};
 };
 
@@ -714,6 +718,10 @@ struct TStructOpsTypeTraits : public TStructOpsTypeTraitsBase2<CPPSTRUCT>
 {
 };
 
+/** Compile time generated property operations for structs with WithGeneratedPropertyOps, defined in UObject/GeneratedStructOps.h */
+template<class CPPSTRUCT>
+struct TGeneratedStructOps;
+
 
 #if !PLATFORM_COMPILER_HAS_IF_CONSTEXPR
 
@@ -953,6 +961,46 @@ struct TStructOpsTypeTraits : public TStructOpsTypeTraitsBase2<CPPSTRUCT>
 		return GetTypeHash(*Data);
 	}
 
+
+	/**
+	 * Selection of generated property operations.
+	 */
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<!TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps>::Type GetGeneratedPropertyLayoutOrNot(TArray<int32>& OutOffsets, TArray<int32>& OutSizes)
+	{
+	}
+
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps>::Type GetGeneratedPropertyLayoutOrNot(TArray<int32>& OutOffsets, TArray<int32>& OutSizes)
+	{
+		TGeneratedStructOps<CPPSTRUCT>::GetPropertyLayout(OutOffsets, OutSizes);
+	}
+
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<!TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps, bool>::Type SerializeGeneratedPropertiesOrNot(FArchive& Ar, CPPSTRUCT* Data, const TBitArray<>& SerializedMask)
+	{
+		return false;
+	}
+
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps, bool>::Type SerializeGeneratedPropertiesOrNot(FArchive& Ar, CPPSTRUCT* Data, const TBitArray<>& SerializedMask)
+	{
+		return TGeneratedStructOps<CPPSTRUCT>::Serialize(Ar, Data, SerializedMask);
+	}
+
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<!TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps, bool>::Type IdenticalGeneratedPropertiesOrNot(const CPPSTRUCT* A, const CPPSTRUCT* B, uint32 PortFlags, bool& bOutResult)
+	{
+		bOutResult = false;
+		return false;
+	}
+
+	template<class CPPSTRUCT>
+	FORCEINLINE typename TEnableIf<TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps, bool>::Type IdenticalGeneratedPropertiesOrNot(const CPPSTRUCT* A, const CPPSTRUCT* B, uint32 PortFlags, bool& bOutResult)
+	{
+		return TGeneratedStructOps<CPPSTRUCT>::Identical(A, B, PortFlags, bOutResult);
+	}
+
 #endif
 
 #if PLATFORM_COMPILER_HAS_IF_CONSTEXPR
@@ -1128,6 +1176,22 @@ public:
 		/** Calls GetTypeHash if enabled */
 		virtual uint32 GetStructTypeHash(const void* Src) = 0;
 
+		/** return true if this struct has property serialization and comparison generated at compile time **/
+		virtual bool HasGeneratedPropertyOps() = 0;
+		/** Fills in the offsets and sizes of the properties visited by the generated code, in visiting order */
+		virtual void GetGeneratedPropertyLayout(TArray<int32>& OutOffsets, TArray<int32>& OutSizes) = 0;
+		/** 
+		 * Serialize the generated properties selected by SerializedMask, densely and without tags.
+		 * Only valid for archives where writer and reader share the property layout.
+		 * @return true if the struct was serialized, otherwise it will fall back to ordinary script struct serialization
+		 */
+		virtual bool SerializeGeneratedProperties(FArchive& Ar, void* Data, const TBitArray<>& SerializedMask) = 0;
+		/** 
+		 * Compare this structure with the generated property comparison
+		 * @return true if the compare was handled, otherwise it will fall back to comparing properties
+		 */
+		virtual bool IdenticalGeneratedProperties(const void* A, const void* B, uint32 PortFlags, bool& bOutResult) = 0;
+
 		/** Returns property flag values that can be computed at compile time */
 		virtual EPropertyFlags GetComputedPropertyFlags() const = 0;
 
@@ -1473,6 +1537,54 @@ public:
 			}
 #else
 			return GetTypeHashOrNot((const CPPSTRUCT*)Src);
+#endif
+		}
+		virtual bool HasGeneratedPropertyOps() override
+		{
+			return TTraits::WithGeneratedPropertyOps;
+		}
+		virtual void GetGeneratedPropertyLayout(TArray<int32>& OutOffsets, TArray<int32>& OutSizes) override
+		{
+#if PLATFORM_COMPILER_HAS_IF_CONSTEXPR
+			if constexpr (TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps)
+			{
+				TGeneratedStructOps<CPPSTRUCT>::GetPropertyLayout(OutOffsets, OutSizes);
+			}
+#else
+			GetGeneratedPropertyLayoutOrNot<CPPSTRUCT>(OutOffsets, OutSizes);
+#endif
+		}
+		virtual bool SerializeGeneratedProperties(FArchive& Ar, void* Data, const TBitArray<>& SerializedMask) override
+		{
+			check(TTraits::WithGeneratedPropertyOps); // don't call this if we have indicated it is not necessary
+#if PLATFORM_COMPILER_HAS_IF_CONSTEXPR
+			if constexpr (TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps)
+			{
+				return TGeneratedStructOps<CPPSTRUCT>::Serialize(Ar, (CPPSTRUCT*)Data, SerializedMask);
+			}
+			else
+			{
+				return false;
+			}
+#else
+			return SerializeGeneratedPropertiesOrNot(Ar, (CPPSTRUCT*)Data, SerializedMask);
+#endif
+		}
+		virtual bool IdenticalGeneratedProperties(const void* A, const void* B, uint32 PortFlags, bool& bOutResult) override
+		{
+			check(TTraits::WithGeneratedPropertyOps); // don't call this if we have indicated it is not necessary
+#if PLATFORM_COMPILER_HAS_IF_CONSTEXPR
+			if constexpr (TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps)
+			{
+				return TGeneratedStructOps<CPPSTRUCT>::Identical((const CPPSTRUCT*)A, (const CPPSTRUCT*)B, PortFlags, bOutResult);
+			}
+			else
+			{
+				bOutResult = false;
+				return false;
+			}
+#else
+			return IdenticalGeneratedPropertiesOrNot((const CPPSTRUCT*)A, (const CPPSTRUCT*)B, PortFlags, bOutResult);
 #endif
 		}
 		virtual EPropertyFlags GetComputedPropertyFlags() const override
@@ -1523,6 +1635,11 @@ protected:
 	bool bPrepareCppStructOpsCompleted;
 	/** Holds the Cpp ctors and dtors, sizeof, etc. Is not owned by this and is not released. **/
 	ICppStructOps* CppStructOps;
+	/** For STRUCT_GeneratedPropertyOps, which of the generated properties are saved to persistent archives, in visiting order **/
+	TBitArray<> GeneratedPropertySerializeMask;
+
+	/** Checks the generated property operations against the linked properties and clears STRUCT_GeneratedPropertyOps if they don't match */
+	void ValidateGeneratedPropertyOps();
 public:
 
 	// UObject Interface
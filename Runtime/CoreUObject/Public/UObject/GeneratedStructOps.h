@@ -0,0 +1,199 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Models.h"
+#include "UObject/Class.h"
+#include "UObject/PropertyPortFlags.h"
+#include "UObject/TextProperty.h"
+
+/**
+ * Compile time generated property operations for native structs.
+ *
+ * A struct opts in by setting WithGeneratedPropertyOps in its TStructOpsTypeTraits and providing a static function that
+ * visits a member pointer for each of its reflected properties, including the ones of its super structs:
+ *
+ *	template<typename VisitorType>
+ *	static void VisitGeneratedProperties(VisitorType&& Visitor)
+ *	{
+ *		Visitor(&FMyStruct::Count);
+ *		Visitor(&FMyStruct::Name);
+ *	}
+ *
+ * The visited members are checked against the reflected properties when the struct is linked. If they don't match,
+ * e.g. because a property is missing or is a bitfield bool, the struct keeps using reflection based serialization and comparison.
+ * Supported member types are the ones with an FArchive operator<< and operator==, UObject pointers, USTRUCTs, C arrays and TArrays of these.
+ */
+template<class CPPSTRUCT>
+struct TGeneratedStructOps
+{
+	static_assert(TStructOpsTypeTraits<CPPSTRUCT>::WithGeneratedPropertyOps, "TGeneratedStructOps is only available for structs with WithGeneratedPropertyOps");
+
+	/** Fills in the offsets and sizes of the visited properties, in visiting order */
+	static void GetPropertyLayout(TArray<int32>& OutOffsets, TArray<int32>& OutSizes)
+	{
+		OutOffsets.Reset();
+		OutSizes.Reset();
+
+		TTypeCompatibleBytes<CPPSTRUCT> Layout;
+		const CPPSTRUCT* LayoutPtr = Layout.GetTypedPtr();
+		CPPSTRUCT::VisitGeneratedProperties([LayoutPtr, &OutOffsets, &OutSizes](auto Member)
+		{
+			const auto& Value = LayoutPtr->*Member;
+			OutOffsets.Add(int32((const uint8*)&Value - (const uint8*)LayoutPtr));
+			OutSizes.Add(int32(sizeof(Value)));
+		});
+	}
+
+	/** Serializes the visited properties that are set in SerializedMask, without any tags */
+	static bool Serialize(FArchive& Ar, CPPSTRUCT* Data, const TBitArray<>& SerializedMask)
+	{
+		int32 Index = 0;
+		CPPSTRUCT::VisitGeneratedProperties([&Ar, Data, &SerializedMask, &Index](auto Member)
+		{
+			if (SerializedMask[Index++])
+			{
+				SerializeValue(Ar, Data->*Member);
+			}
+		});
+		return !Ar.IsError();
+	}
+
+	/**
+	 * Compares the visited properties.
+	 * @return false if the comparison has to be done by reflection for these port flags
+	 */
+	static bool Identical(const CPPSTRUCT* A, const CPPSTRUCT* B, uint32 PortFlags, bool& bOutResult)
+	{
+		if (PortFlags & (PPF_DeepComparison | PPF_DeepCompareInstances | PPF_DuplicateForPIE))
+		{
+			// Object references need instance aware comparison
+			return false;
+		}
+
+		bool bIdentical = true;
+		CPPSTRUCT::VisitGeneratedProperties([A, B, PortFlags, &bIdentical](auto Member)
+		{
+			bIdentical = bIdentical && IdenticalValue(A->*Member, B->*Member, PortFlags);
+		});
+		bOutResult = bIdentical;
+		return true;
+	}
+
+private:
+	struct CScriptStruct
+	{
+		template <typename T>
+		auto Requires(UScriptStruct*& Result) -> decltype(
+			Result = T::StaticStruct()
+		);
+	};
+
+	template <typename T>
+	using TIsScriptStruct = TModels<CScriptStruct, T>;
+
+	template <typename T>
+	using TIsObjectPointer = TAnd<TIsPointer<T>, TIsDerivedFrom<typename TRemovePointer<T>::Type, UObject>>;
+
+	template <typename T, int32 Num>
+	static void SerializeValue(FArchive& Ar, T (&Value)[Num])
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			SerializeValue(Ar, Value[Index]);
+		}
+	}
+
+	template <typename T, typename AllocatorType>
+	static void SerializeValue(FArchive& Ar, TArray<T, AllocatorType>& Value)
+	{
+		int32 Num = Value.Num();
+		Ar << Num;
+		if (Ar.IsLoading())
+		{
+			if (Num < 0)
+			{
+				Ar.SetError();
+				return;
+			}
+			Value.Empty(Num);
+			Value.AddDefaulted(Num);
+		}
+		for (T& Element : Value)
+		{
+			SerializeValue(Ar, Element);
+		}
+	}
+
+	template <typename T>
+	static typename TEnableIf<TIsScriptStruct<T>::Value>::Type SerializeValue(FArchive& Ar, T& Value)
+	{
+		T::StaticStruct()->SerializeItem(Ar, &Value, nullptr);
+	}
+
+	template <typename T>
+	static typename TEnableIf<TIsObjectPointer<T>::Value>::Type SerializeValue(FArchive& Ar, T& Value)
+	{
+		Ar << (UObject*&)Value;
+	}
+
+	template <typename T>
+	static typename TEnableIf<!TIsScriptStruct<T>::Value && !TIsObjectPointer<T>::Value>::Type SerializeValue(FArchive& Ar, T& Value)
+	{
+		Ar << Value;
+	}
+
+	template <typename T, int32 Num>
+	static bool IdenticalValue(const T (&A)[Num], const T (&B)[Num], uint32 PortFlags)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (!IdenticalValue(A[Index], B[Index], PortFlags))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T, typename AllocatorType>
+	static bool IdenticalValue(const TArray<T, AllocatorType>& A, const TArray<T, AllocatorType>& B, uint32 PortFlags)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (!IdenticalValue(A[Index], B[Index], PortFlags))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool IdenticalValue(const FString& A, const FString& B, uint32 PortFlags)
+	{
+		// Matches FStrProperty, which is case sensitive
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static bool IdenticalValue(const FText& A, const FText& B, uint32 PortFlags)
+	{
+		return FTextProperty::Identical_Implementation(A, B, PortFlags);
+	}
+
+	template <typename T>
+	static typename TEnableIf<TIsScriptStruct<T>::Value, bool>::Type IdenticalValue(const T& A, const T& B, uint32 PortFlags)
+	{
+		return T::StaticStruct()->CompareScriptStruct(&A, &B, PortFlags);
+	}
+
+	template <typename T>
+	static typename TEnableIf<!TIsScriptStruct<T>::Value, bool>::Type IdenticalValue(const T& A, const T& B, uint32 PortFlags)
+	{
+		return A == B;
+	}
+};
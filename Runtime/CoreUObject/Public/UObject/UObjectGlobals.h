@@ -298,6 +298,18 @@ COREUOBJECT_API UClass* StaticLoadClass(UClass* BaseClass, UObject* InOuter, con
  */
 COREUOBJECT_API UObject* StaticConstructObject_Internal(const FStaticConstructObjectParameters& Params);
 
+/**
+ * Create NumObjects new instances of the same class, outer, flags and template. This is equivalent to calling StaticConstructObject_Internal
+ * NumObjects times, but the per call validation is done once and all the objects are added to the UObject hash tables in one batch
+ * before any of their constructors run. Without a template, each object still resolves its own archetype when constructed,
+ * as the archetype depends on its unique name.
+ *
+ * @param	Params		The parameters to use when construction the objects, Name must be NAME_None as every object gets a unique name. @see FStaticConstructObjectParameters
+ * @param	NumObjects	Number of objects to create
+ * @param	OutObjects	Array the fully initialized objects are appended to
+ */
+COREUOBJECT_API void StaticConstructObjects_Internal(const FStaticConstructObjectParameters& Params, int32 NumObjects, TArray<UObject*>& OutObjects);
+
 /**
  * Create a new instance of an object.  The returned object will be fully initialized.  If InFlags contains RF_NeedsLoad (indicating that the object still needs to load its object data from disk), components
  * are not instanced (this will instead occur in PostLoad()).  The different between StaticConstructObject and StaticAllocateObject is that StaticConstructObject will also call the class constructor on the object
@@ -1193,6 +1205,41 @@ FUNCTION_NON_NULL_RETURN_END
 	return static_cast<T*>(StaticConstructObject_Internal(Params));
 }
 
+/**
+ * Convenience template for constructing many gameplay objects of the same class at once, @see StaticConstructObjects_Internal
+ *
+ * @param	Outer		the outer for the new objects
+ * @param	Class		the class of objects to construct
+ * @param	NumObjects	the number of objects to construct
+ * @param	OutObjects	array the new objects are appended to
+ * @param	Flags		the object flags to apply to the new objects
+ * @param	Template	the object to use for initializing the new objects.  If not specified, the class's default object will be used
+ */
+template< class T >
+void NewObjects(UObject* Outer, const UClass* Class, int32 NumObjects, TArray<T*>& OutObjects, EObjectFlags Flags = RF_NoFlags, UObject* Template = nullptr)
+{
+	FObjectInitializer::AssertIfInConstructor(Outer, TEXT("NewObjects can't be used to create default subobjects (inside of UObject derived class constructor) as it produces inconsistent object names. Use ObjectInitializer.CreateDefaultSubobject<> instead."));
+
+#if DO_CHECK
+	// Class was specified explicitly, so needs to be validated
+	CheckIsClassChildOf_Internal(T::StaticClass(), Class);
+#endif
+
+	FStaticConstructObjectParameters Params(Class);
+	Params.Outer = Outer;
+	Params.SetFlags = Flags;
+	Params.Template = Template;
+
+	TArray<UObject*> Objects;
+	StaticConstructObjects_Internal(Params, NumObjects, Objects);
+
+	OutObjects.Reserve(OutObjects.Num() + Objects.Num());
+	for (UObject* Object : Objects)
+	{
+		OutObjects.Add(static_cast<T*>(Object));
+	}
+}
+
 /**
  * Convenience template for duplicating an object
  *
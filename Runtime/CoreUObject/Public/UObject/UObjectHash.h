@@ -157,6 +157,22 @@ void HashObject(class UObjectBase* Object);
  */
 void UnhashObject(class UObjectBase* Object);
 
+/**
+ * Defers the HashObject calls made by the current thread while in scope and adds the objects to the hash tables
+ * in one batch when the scope ends, so the hash table locks are taken once per batch instead of once per object.
+ * Objects allocated in the scope can't be found by name until it ends, so it must not run any object constructors.
+ */
+class FScopedUObjectHashBatch
+{
+public:
+	FScopedUObjectHashBatch();
+	~FScopedUObjectHashBatch();
+
+private:
+	TArray<class UObjectBase*> Objects;
+	TArray<class UObjectBase*>* OuterBatch;
+};
+
 
 /**
  * Assign an external package directly to an object in the hash tables
@@ -965,6 +965,18 @@ public:
 	 */
 	virtual bool UpdateOverlapsImpl(const TOverlapArrayView* NewPendingOverlaps=nullptr, bool bDoNotifies=true, const TOverlapArrayView* OverlapsAtEndLocation=nullptr) override;
 
+	/**
+	 * Queries the overlaps that UpdateOverlapsImpl() would find at the current location, without changing any overlap state.
+	 * Only reads the component and the scene, so it can run on worker threads while the game thread is waiting for it.
+	 */
+	void QueryOverlapsAtCurrentLocation(TInlineOverlapInfoArray& OutOverlaps) const;
+
+	/**
+	 * Queues the overlap update following a move of this component in the FScopedOverlapUpdateBatch of its world, if one is open.
+	 * @return True if the update was queued, false if UpdateOverlaps() has to be called now.
+	 */
+	bool QueueOverlapUpdateInBatch(const TOverlapArrayView* PendingOverlaps, const TOverlapArrayView* OverlapsAtEndLocation);
+
 #if WITH_EDITOR
 	/**
 	 * Whether or not the bounds of this component should be considered when focusing the editor camera to an actor with this component in it.
@@ -2412,6 +2424,53 @@ public:
 	void DispatchOnInputTouchEnd(const ETouchIndex::Type Key);
 };
 
+/**
+ * Batches the overlap updates of the primitive components moved within its scope.
+ *
+ * Instead of querying the scene and dispatching begin/end overlap events on each move, moved components are recorded,
+ * then when the scope ends the overlap queries of all of them run in parallel, and the overlap events are dispatched
+ * on the game thread in the order the components first moved. Components moved again by overlap events are updated immediately.
+ *
+ * Only one batch is open at a time, inner scopes do nothing. UWorld opens one per tick group when p.BatchOverlapUpdates is enabled.
+ */
+class ENGINE_API FScopedOverlapUpdateBatch : private FNoncopyable
+{
+public:
+	FScopedOverlapUpdateBatch(UWorld* InWorld);
+	~FScopedOverlapUpdateBatch();
+
+	/** Returns the open batch for the world, if any */
+	static FScopedOverlapUpdateBatch* Get(const UWorld* InWorld);
+
+private:
+	friend class UPrimitiveComponent;
+
+	struct FPendingUpdate
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+
+		/** Overlaps found along the moves, accumulated if the component moved more than once */
+		TInlineOverlapInfoArray PendingOverlaps;
+
+		/** Overlaps at the end location, either known from the last move or queried when the batch is flushed */
+		TInlineOverlapInfoArray OverlapsAtEndLocation;
+		bool bHasOverlapsAtEndLocation = false;
+
+		/** Transform OverlapsAtEndLocation is valid for */
+		FTransform EndTransform;
+	};
+
+	void AddUpdate(UPrimitiveComponent& Component, const TOverlapArrayView* PendingOverlaps, const TOverlapArrayView* OverlapsAtEndLocation);
+	void Flush();
+
+	UWorld* World;
+	bool bIsOwner;
+	TArray<FPendingUpdate> PendingUpdates;
+	TMap<const UPrimitiveComponent*, int32> ComponentToUpdate;
+
+	static FScopedOverlapUpdateBatch* Current;
+};
+
 /** 
  *  Component instance cached data base class for primitive components. 
  *  Stores a list of instance components attached to the 
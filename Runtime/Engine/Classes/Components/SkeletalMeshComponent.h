@@ -578,6 +578,20 @@ public:
 	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = SkeletalMesh)
 	uint8 bEnablePhysicsOnDedicatedServer:1;
 
+	/**
+	 *  If true, on a dedicated server only the bones used by the physics asset, root motion, the sockets children are attached to
+	 *  and ServerRequiredSockets are evaluated. Can be forced for all components with a.ForceLightweightServerAnimation.
+	 */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Optimization)
+	uint8 bLightweightServerAnimation:1;
+
+	/**
+	 *  If true, on a dedicated server the anim instances report the highest LOD level, so anim graph nodes with a LOD threshold
+	 *  are skipped as cosmetic. Only enable it when none of those nodes affect bones gameplay reads on the server.
+	 */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Optimization)
+	uint8 bSkipLODThresholdNodesOnServer:1;
+
 	/**
 	 *	If we should pass joint position to joints each frame, so that they can be used by motorized joints to drive the
 	 *	ragdoll based on the animation.
@@ -589,6 +603,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Clothing)
 	uint8 bDisableClothSimulation:1;
 
+	/** Sockets or bones whose transforms are used by gameplay on a dedicated server, kept animated by lightweight server animation */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Optimization)
+	TArray<FName> ServerRequiredSockets;
+
 	/** Indicates that this SkeletalMeshComponent has deferred kinematic bone updates until next physics sim if not INDEX_NONE. */
 	int32 DeferredKinematicUpdateIndex;
 #if PHYSICS_INTERFACE_PHYSX
@@ -1605,6 +1623,12 @@ public:
 	*/
 	void ComputeRequiredBones(TArray<FBoneIndexType>& OutRequiredBones, TArray<FBoneIndexType>& OutFillComponentSpaceTransformsRequiredBones, int32 LODIndex, bool bIgnorePhysicsAsset) const;
 
+	/** Whether only the bones needed by the server are evaluated, see bLightweightServerAnimation */
+	bool IsUsingLightweightServerAnimation() const;
+
+	/** Whether anim graph nodes with a LOD threshold are skipped, see bSkipLODThresholdNodesOnServer */
+	bool ShouldSkipLODThresholdNodesOnServer() const;
+
 	/**
 	* Recalculates the AnimCurveUids array in RequiredBone of this SkeletalMeshComponent based on current required bone set
 	* Is called when Skeleton->IsRequiredCurvesUpToDate() = false
@@ -1664,6 +1688,10 @@ public:
 	virtual bool IsAnySimulatingPhysics() const override;
 	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 	virtual bool UpdateOverlapsImpl(const TOverlapArrayView* PendingOverlaps=NULL, bool bDoNotifies=true, const TOverlapArrayView* OverlapsAtEndLocation=NULL) override;
+protected:
+	virtual void OnChildAttached(USceneComponent* ChildComponent) override;
+	virtual void OnChildDetached(USceneComponent* ChildComponent) override;
+public:
 	//~ End USceneComponent Interface.
 
 	//~ Begin UPrimitiveComponent Interface.
@@ -105,6 +105,29 @@ enum ETickingGroup
 	TG_MAX,
 };
 
+/** State a tick function executed in a parallel tick batch may access, @see FTickFunction::bRunInParallelBatch */
+enum class ETickParallelAccess : uint8
+{
+	/** Reads and writes only state owned by the tick target, the batch runs concurrently with the game thread */
+	TargetOnly,
+
+	/** Writes only state owned by the tick target, but reads state of other objects (owner, attach parent, world...), the batch runs while the game thread waits for it */
+	ReadsExternal,
+};
+
+/** 
+ * Returns true if the calling thread is executing a tick function of a parallel tick batch.
+ * Used by non-shipping builds to flag game thread only operations done by batched ticks, always false in shipping builds.
+ */
+ENGINE_API bool IsInParallelTickBatch();
+
+#if !UE_BUILD_SHIPPING
+/** Flags game thread only operations done from ticks of a parallel tick batch */
+#define ensureNotInParallelTickBatch(Operation) ensureMsgf(!IsInParallelTickBatch(), TEXT("%s is not allowed from a tick function running in a parallel tick batch"), Operation)
+#else
+#define ensureNotInParallelTickBatch(Operation)
+#endif
+
 /**
  * This is small structure to hold prerequisite tick functions
  */
@@ -213,6 +236,31 @@ public:
 	/** If false, this tick will run on the game thread, otherwise it will run on any thread in parallel with the game thread and in parallel with other "async ticks" **/
 	uint8 bRunOnAnyThread:1;
 
+	/**
+	 * If true, this tick is executed together with other batched ticks of the same target class and tick group, in ParallelFor chunks
+	 * instead of a task of its own. This is a per class contract: ExecuteTick may only write state owned by the tick target, may read
+	 * other objects only as declared by ParallelTickAccess, and must not call game thread only engine functions (spawning, registration,
+	 * render state, tick enabling...), which is validated in non-shipping builds. Ticks with prerequisites or delayed to a later tick
+	 * group are queued as regular tasks.
+	 */
+	uint8 bRunInParallelBatch:1;
+
+	/** State accessed by this tick when it's executed in a parallel tick batch */
+	ETickParallelAccess ParallelTickAccess;
+
+	/**
+	 * Batched tick entry point, called for contiguous runs of enabled tick functions sharing it, the target class and tick groups.
+	 * DeltaTimes holds the frame time to advance for each function. Runs on the game thread, unless bRunInParallelBatch is also set.
+	 * @see FActorComponentTickFunction::ExecuteTickBatch
+	 */
+	typedef void (*FExecuteTickBatchFunction)(TArrayView<FTickFunction* const> TickFunctions, TArrayView<const float> DeltaTimes, ELevelTick TickType);
+
+	/**
+	 * If set, this tick is executed through a single call per batch of ticks of the same class and tick group instead of ExecuteTick,
+	 * removing per tick virtual dispatch and task overhead. Ticks with prerequisites or delayed to a later tick group keep using ExecuteTick.
+	 */
+	FExecuteTickBatchFunction ExecuteTickBatchFunction;
+
 private:
 
 	enum class ETickState : uint8
@@ -250,6 +298,9 @@ private:
 		/** Cache whether this function was rescheduled as an interval function during StartParallel */
 		bool bWasInterval:1;
 
+		/** Whether TaskPointer is the task of a parallel tick batch this frame */
+		bool bInTickBatch:1;
+
 		/** Internal data that indicates the tick group we actually started in (it may have been delayed due to prerequisites) **/
 		TEnumAsByte<enum ETickingGroup> ActualStartTickGroup;
 
@@ -418,11 +469,17 @@ private:
 	{
 		return NAME_None;
 	}
+	/** Class of the tick target, ticks are only put in tick batches with ticks of the same class. Null disables batching. */
+	virtual UClass* GetTickBatchClass() const
+	{
+		return nullptr;
+	}
 	
 	friend class FTickTaskSequencer;
 	friend class FTickTaskManager;
 	friend class FTickTaskLevel;
 	friend class FTickFunctionTask;
+	friend class FTickBatchTask;
 
 	// It is unsafe to copy FTickFunctions and any subclasses of FTickFunction should specify the type trait WithCopy = false
 	FTickFunction& operator=(const FTickFunction&) = delete;
@@ -459,6 +516,7 @@ struct FActorTickFunction : public FTickFunction
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage() override;
 	ENGINE_API virtual FName DiagnosticContext(bool bDetailed) override;
+	ENGINE_API virtual UClass* GetTickBatchClass() const override;
 };
 
 template<>
@@ -492,6 +550,7 @@ struct FActorComponentTickFunction : public FTickFunction
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage() override;
 	ENGINE_API virtual FName DiagnosticContext(bool bDetailed) override;
+	ENGINE_API virtual UClass* GetTickBatchClass() const override;
 
 	/**
 	 * Conditionally calls ExecuteTickFunc if registered and a bunch of other criteria are met
@@ -506,6 +565,22 @@ struct FActorComponentTickFunction : public FTickFunction
 
 	template <typename ExecuteTickLambda>
 	static void ExecuteTickHelper(UActorComponent* Target, bool bTickInEditor, float DeltaTime, ELevelTick TickType, const ExecuteTickLambda& ExecuteTickFunc);	
+
+	/**
+	 * Whether the target meets the normal conditions to tick, shared by ExecuteTickHelper and ExecuteTickBatch
+	 * @param OutTimeDilation - set to the time dilation of the target's owner when it ticks
+	 */
+	static bool CanExecuteTick(const UActorComponent* Target, bool bTickInEditor, ELevelTick TickType, float& OutTimeDilation);
+
+	/**
+	 * Batched tick entry point for components of ComponentType, to be assigned to ExecuteTickBatchFunction of their primary tick function:
+	 *	PrimaryComponentTick.ExecuteTickBatchFunction = &FActorComponentTickFunction::ExecuteTickBatch<UMyComponent>;
+	 * Filters the targets with CanExecuteTick like ExecuteTickHelper and makes a single call to the static
+	 *	void ComponentType::TickComponentsBatch(TArrayView<ComponentType* const> Components, TArrayView<const float> DeltaTimes, ELevelTick TickType)
+	 * with time dilated delta times.
+	 */
+	template <typename ComponentType>
+	static void ExecuteTickBatch(TArrayView<FTickFunction* const> TickFunctions, TArrayView<const float> DeltaTimes, ELevelTick TickType);
 };
 
 
@@ -2380,6 +2380,11 @@ public:
 	UPROPERTY()
 	int32 MaxEvalRateForInterpolation;
 
+	/** Minimum update and evaluation rate set from the owner's significance (see UTickSignificanceSubsystem), not applied to human controlled characters.
+	 * 1 = no throttling */
+	UPROPERTY(Transient)
+	int32 SignificanceUpdateRate;
+
 	/** Array of MaxDistanceFactor to use for AnimUpdateRate when mesh is visible (rendered).
 	 * MaxDistanceFactor is size on screen, as used by LODs
 	 * Example:
@@ -2428,6 +2433,7 @@ public:
 		, ThisTickDelta(0.f)
 		, BaseNonRenderedUpdateRate(4)
 		, MaxEvalRateForInterpolation(4)
+		, SignificanceUpdateRate(1)
 		, SkippedUpdateFrames(0)
 		, SkippedEvalFrames(0)
 	{ 
@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Stats/Stats.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "TickSignificanceSubsystem.generated.h"
+
+class AActor;
+class UActorComponent;
+
+/** Update rates applied to actors within a range of significance */
+USTRUCT()
+struct FTickSignificanceLevel
+{
+	GENERATED_BODY()
+
+	/** Lowest significance, in [0,1], of the actors using this level */
+	UPROPERTY(config)
+	float MinSignificance = 0.f;
+
+	/** Minimum tick interval of the actor and its components, in seconds. 0 keeps their own interval. */
+	UPROPERTY(config)
+	float TickInterval = 0.f;
+
+	/** Scale applied to the actor's NetUpdateFrequency on the server */
+	UPROPERTY(config)
+	float NetUpdateFrequencyScale = 1.f;
+
+	/** Minimum animation update rate of the actor's skinned meshes using update rate optimizations. 1 = every frame. */
+	UPROPERTY(config)
+	int32 AnimUpdateRate = 1;
+};
+
+/** Limits how many actors of a tick group can run at the most significant level */
+USTRUCT()
+struct FTickSignificanceBudget
+{
+	GENERATED_BODY()
+
+	/** Tick group of the actors' primary tick function */
+	UPROPERTY(config)
+	TEnumAsByte<ETickingGroup> TickGroup = TG_PrePhysics;
+
+	/** Number of actors of the group allowed at the most significant level, the least significant ones over budget are moved to the next level */
+	UPROPERTY(config)
+	int32 MaxActors = 0;
+};
+
+/**
+ * The tick significance subsystem scales the update rates of registered actors by their significance to the viewers.
+ * Significance is computed from the distance to the closest player view point, which on a server covers the viewers of all connections.
+ * Each actor is then assigned a significance level, which drives in one place the tick interval of the actor and its components,
+ * the update rate of its skinned meshes (see FAnimUpdateRateParameters::SignificanceUpdateRate) and its net update frequency.
+ *
+ * Actors with bManageTickSignificance are registered when they begin play, others can be registered explicitly.
+ */
+UCLASS(config=Engine)
+class ENGINE_API UTickSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Computes the significance of an actor, in [0,1], from the player view points */
+	typedef TFunction<float(const AActor* Actor, TArrayView<const FTransform> Viewers)> FSignificanceFunction;
+
+	UTickSignificanceSubsystem();
+
+	/**
+	* Starts managing the update rates of the given actor.
+	* The actor's current tick intervals and net update frequency are used as the base values the significance levels are applied to.
+	*
+	* @param SignificanceFunction	Optional override of the distance based significance
+	* @return True if actor registered
+	*/
+	bool RegisterActor(AActor* ActorToRegister, FSignificanceFunction SignificanceFunction = nullptr);
+
+	/**
+	* Stops managing the given actor and restores its base update rates
+	*
+	* @return	True if this actor was removed
+	*/
+	bool UnregisterActor(AActor* ActorToRemove);
+
+	/** Returns the last computed significance of the actor, or 1 if it's not registered */
+	float GetActorSignificance(const AActor* Actor) const;
+
+protected:
+
+	//~FTickableGameObject interface
+
+	ETickableTickType GetTickableTickType() const override;
+
+	/** Updates the significance of the registered actors and applies the update rates of their level */
+	void Tick(float DeltaTime) override;
+
+	TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UTickSignificanceSubsystem, STATGROUP_Tickables); }
+
+	//~End of FTickableGameObject interface
+
+
+	//~USubsystem interface
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~UWorldSubsystem interface
+	bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	/** Significance levels, sorted from the most significant one when the subsystem is created. The most significant level should keep full update rates. */
+	UPROPERTY(config)
+	TArray<FTickSignificanceLevel> SignificanceLevels;
+
+	/** Budgets of the most significant level, per tick group */
+	UPROPERTY(config)
+	TArray<FTickSignificanceBudget> TickGroupBudgets;
+
+	/** Distance to the closest viewer at which the significance reaches 0 */
+	UPROPERTY(config)
+	float MaxSignificanceDistance;
+
+	/** How often significance is updated, in seconds */
+	UPROPERTY(config)
+	float UpdateInterval;
+
+private:
+
+	struct FManagedComponent
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+		float BaseTickInterval;
+	};
+
+	struct FManagedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FSignificanceFunction SignificanceFunction;
+		TArray<FManagedComponent> Components;
+		float BaseTickInterval = 0.f;
+		float BaseNetUpdateFrequency = 0.f;
+		float Significance = 1.f;
+		int32 Level = INDEX_NONE;
+	};
+
+	/** Callback for a registered actor's End Play so we can remove it from our known actors */
+	UFUNCTION()
+	void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	/** Gathers the view points of all player controllers */
+	void GatherViewers(TArray<FTransform>& OutViewers) const;
+
+	/** Returns the level matching the significance */
+	int32 GetSignificanceLevel(float Significance) const;
+
+	/** Moves actors over the budget of their tick group to the next level */
+	void ApplyTickGroupBudgets(TArray<int32>& InOutLevels) const;
+
+	/** Applies the rates of the level to the actor, or its base rates for INDEX_NONE */
+	void ApplyLevel(FManagedActor& ManagedActor, int32 Level) const;
+
+	TArray<FManagedActor> ManagedActors;
+
+	float TimeSinceUpdate;
+};
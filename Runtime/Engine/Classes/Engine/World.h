@@ -2132,6 +2132,34 @@ public:
 	 */ 
 	FTraceHandle	AsyncOverlapByObjectType(const FVector& Pos, const FQuat& Rot, const FCollisionObjectQueryParams& ObjectQueryParams, const FCollisionShape& CollisionShape, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam, FOverlapDelegate * InDelegate = NULL, uint32 UserData = 0);
 
+	/**
+	 * Runs a batch of line traces sharing the same channel and parameters, spread over worker threads.
+	 * Unlike async traces, results are available when the function returns. They are stored contiguously in OutResults, in request order.
+	 *
+	 *  @param  InTraceType     Whether each trace returns a test result, a single or multiple hits
+	 *  @param  Requests        Start and end of each trace
+	 *  @param  TraceChannel    The 'channel' that this trace is in, used to determine which components to hit
+	 *  @param  OutResults      Hits of all the traces
+	 *  @param  Params          Additional parameters used for the traces
+	 *  @param  ResponseParam   ResponseContainer to be used for the traces
+	 */
+	void BatchLineTraceByChannel(EAsyncTraceType InTraceType, TArrayView<const FBatchTraceRequest> Requests, ECollisionChannel TraceChannel, FBatchTraceResults& OutResults, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam, const FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+
+	/**
+	 * Runs a batch of sweeps of the same shape, channel and parameters, spread over worker threads. See BatchLineTraceByChannel.
+	 *
+	 *  @param  CollisionShape  CollisionShape - supports Box, Sphere, Capsule. Line traces are used if nearly zero.
+	 */
+	void BatchSweepByChannel(EAsyncTraceType InTraceType, TArrayView<const FBatchTraceRequest> Requests, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, FBatchTraceResults& OutResults, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam, const FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+
+	/**
+	 * Runs a batch of overlap tests of the same shape, channel and parameters, spread over worker threads. See BatchLineTraceByChannel.
+	 *
+	 *  @param  Requests        Location and rotation of the shape for each test
+	 *  @param  CollisionShape  CollisionShape - supports Box, Sphere, Capsule
+	 */
+	void BatchOverlapByChannel(TArrayView<const FBatchOverlapRequest> Requests, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, FBatchOverlapResults& OutResults, const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam, const FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+
 	/**
 	 * Query function 
 	 * return true if already done and returning valid result - can be hit or no hit
@@ -253,6 +253,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Tick)
 	uint8 bAllowTickBeforeBeginPlay:1;
 
+	/**
+	 * Whether the tick interval, animation update rate and net update frequency of this Actor are scaled by its significance to the viewers.
+	 * The Actor is registered with the UTickSignificanceSubsystem when it begins play, using its current rates as the full rates.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category=Tick)
+	uint8 bManageTickSignificance:1;
+
 private:
 	/** If true then destroy self when "finished", meaning all relevant components report that they are done and no timelines or timers are in flight. */
 	UPROPERTY(BlueprintSetter=SetAutoDestroyWhenFinished, Category=Actor)
@@ -3551,29 +3558,67 @@ private:
 };
 #endif
 
+FORCEINLINE bool FActorComponentTickFunction::CanExecuteTick(const UActorComponent* Target, bool bTickInEditor, ELevelTick TickType, float& OutTimeDilation)
+{
+	if (Target && Target->bRegistered && !Target->IsPendingKillOrUnreachable())
+	{
+		AActor* MyOwner = Target->GetOwner();
+		//@optimization, I imagine this is all unnecessary in a shipping game with no editor
+		if (TickType != LEVELTICK_ViewportsOnly ||
+			(bTickInEditor && TickType == LEVELTICK_ViewportsOnly) ||
+			(MyOwner && MyOwner->ShouldTickIfViewportsOnly())
+			)
+		{
+			OutTimeDilation = (MyOwner ? MyOwner->CustomTimeDilation : 1.f);
+			return true;
+		}
+	}
+	return false;
+}
+
 /** Helper function for executing tick functions based on the normal conditions previous found in UActorComponent::ConditionalTick */
 template <typename ExecuteTickLambda>
 void FActorComponentTickFunction::ExecuteTickHelper(UActorComponent* Target, bool bTickInEditor, float DeltaTime, ELevelTick TickType, const ExecuteTickLambda& ExecuteTickFunc)
 {
-	if (Target && !Target->IsPendingKillOrUnreachable())
+	float TimeDilation = 1.f;
+	if (CanExecuteTick(Target, bTickInEditor, TickType, TimeDilation))
 	{
 		FScopeCycleCounterUObject ComponentScope(Target);
 		FScopeCycleCounterUObject AdditionalScope(Target->AdditionalStatObject());
 
-		if (Target->bRegistered)
+		ExecuteTickFunc(DeltaTime * TimeDilation);
+	}
+}
+
+/** Batched counterpart of ExecuteTickHelper, see FTickFunction::ExecuteTickBatchFunction */
+template <typename ComponentType>
+void FActorComponentTickFunction::ExecuteTickBatch(TArrayView<FTickFunction* const> TickFunctions, TArrayView<const float> DeltaTimes, ELevelTick TickType)
+{
+	TArray<ComponentType*, TInlineAllocator<256>> Components;
+	TArray<float, TInlineAllocator<256>> DilatedDeltaTimes;
+	Components.Reserve(TickFunctions.Num());
+	DilatedDeltaTimes.Reserve(TickFunctions.Num());
+
+	for (int32 Index = 0; Index < TickFunctions.Num(); Index++)
+	{
+		UActorComponent* Target = static_cast<const FActorComponentTickFunction*>(TickFunctions[Index])->Target;
+		float TimeDilation = 1.f;
+		if (CanExecuteTick(Target, Target && Target->bTickInEditor, TickType, TimeDilation))
 		{
-			AActor* MyOwner = Target->GetOwner();
-			//@optimization, I imagine this is all unnecessary in a shipping game with no editor
-			if (TickType != LEVELTICK_ViewportsOnly ||
-				(bTickInEditor && TickType == LEVELTICK_ViewportsOnly) ||
-				(MyOwner && MyOwner->ShouldTickIfViewportsOnly())
-				)
-			{
-				const float TimeDilation = (MyOwner ? MyOwner->CustomTimeDilation : 1.f);
-				ExecuteTickFunc(DeltaTime * TimeDilation);
-			}
+			checkSlow(Target->IsA<ComponentType>());
+			Components.Add(static_cast<ComponentType*>(Target));
+			DilatedDeltaTimes.Add(DeltaTimes[Index] * TimeDilation);
 		}
 	}
+
+	if (Components.Num())
+	{
+		// a single call can't be split per object, the whole batch is counted for the class. Single ticks keep their object stats.
+		FScopeCycleCounterUObject ClassScope(Components.Num() > 1 ? (const UObject*)ComponentType::StaticClass() : Components[0]);
+		FScopeCycleCounterUObject AdditionalScope(Components.Num() > 1 ? nullptr : Components[0]->AdditionalStatObject());
+
+		ComponentType::TickComponentsBatch(Components, DilatedDeltaTimes, TickType);
+	}
 }
 
 template<class T, uint32 NumElements>
@@ -38,6 +38,13 @@ class ENGINE_API URotatingMovementComponent : public UMovementComponent
 	/** Applies rotation to UpdatedComponent. */
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	//End UActorComponent Interface
+
+	/** Batched tick of components of this exact class, see FActorComponentTickFunction::ExecuteTickBatch */
+	static void TickComponentsBatch(TArrayView<URotatingMovementComponent* const> Components, TArrayView<const float> DeltaTimes, ELevelTick TickType);
+
+private:
+	/** Rotates UpdatedComponent, and moves it around the pivot */
+	void ApplyRotation(float DeltaTime);
 };
 
 
@@ -43,6 +43,7 @@
 #include "ObjectTrace.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "Engine/AutoDestroySubsystem.h"
+#include "Engine/TickSignificanceSubsystem.h"
 #include "LevelUtils.h"
 #include "GameFramework/InputSettings.h"
 
@@ -194,6 +195,11 @@ FName FActorTickFunction::DiagnosticContext(bool bDetailed)
 	}
 }
 
+UClass* FActorTickFunction::GetTickBatchClass() const
+{
+	return Target ? Target->GetClass() : nullptr;
+}
+
 bool AActor::CheckDefaultSubobjectsInternal() const
 {
 	bool Result = Super::CheckDefaultSubobjectsInternal();
@@ -3572,6 +3578,17 @@ void AActor::BeginPlay()
 		}
 	}
 
+	if (bManageTickSignificance)
+	{
+		if (UWorld* MyWorld = GetWorld())
+		{
+			if (UTickSignificanceSubsystem* TickSignificanceSys = MyWorld->GetSubsystem<UTickSignificanceSubsystem>())
+			{
+				TickSignificanceSys->RegisterActor(this);
+			}
+		}
+	}
+
 	ReceiveBeginPlay();
 
 	ActorHasBegunPlay = EActorBeginPlayState::HasBegunPlay;
@@ -1181,6 +1181,12 @@ int32 UAnimInstance::GetLODLevel() const
 	USkeletalMeshComponent* SkelMeshComp = GetSkelMeshComponent();
 	check(SkelMeshComp)
 
+	// Nodes with a LOD threshold are treated as cosmetic, skip them all on the server when asked to
+	if (SkelMeshComp->ShouldSkipLODThresholdNodesOnServer())
+	{
+		return MAX_int32;
+	}
+
 	return SkelMeshComp->PredictedLODLevel;
 }
 
@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Animation/AnimPoseCache.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimationPoseData.h"
+#include "BonePose.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Cache Hits"), STAT_AnimPoseCacheHits, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Cache Misses"), STAT_AnimPoseCacheMisses, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Cache Rejected"), STAT_AnimPoseCacheRejected, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pose Cache Entries"), STAT_AnimPoseCacheEntries, STATGROUP_Anim);
+
+static int32 GAnimPoseCacheEnable = 0;
+static FAutoConsoleVariableRef CVarAnimPoseCacheEnable(
+	TEXT("a.AnimPoseCache.Enable"),
+	GAnimPoseCacheEnable,
+	TEXT("If 1, poses decompressed from anim sequences are cached for the frame and shared by all the components sampling the same sequence at the same quantized time."));
+
+static float GAnimPoseCacheTimeQuantum = 1.f / 60.f;
+static FAutoConsoleVariableRef CVarAnimPoseCacheTimeQuantum(
+	TEXT("a.AnimPoseCache.TimeQuantum"),
+	GAnimPoseCacheTimeQuantum,
+	TEXT("Sample times of cached poses are rounded to multiples of this many seconds. 0 only shares poses sampled at exactly the same time."));
+
+static int32 GAnimPoseCacheMaxPoses = 512;
+static FAutoConsoleVariableRef CVarAnimPoseCacheMaxPoses(
+	TEXT("a.AnimPoseCache.MaxPoses"),
+	GAnimPoseCacheMaxPoses,
+	TEXT("Maximum number of poses in the anim pose cache. Poses decompressed once the cache is full are not cached until the end of the frame."));
+
+static FAutoConsoleCommand CmdAnimPoseCacheDumpStats(
+	TEXT("a.AnimPoseCache.DumpStats"),
+	TEXT("Logs the hit rate and size of the anim pose cache"),
+	FConsoleCommandDelegate::CreateLambda([]() { FAnimPoseCache::Get().DumpStats(); }));
+
+static thread_local int32 GAnimPoseCacheBatchScopeDepth = 0;
+
+// Entries are only evicted once the delegates are registered
+static bool GAnimPoseCacheStarted = false;
+
+FAnimPoseCache::FBatchScope::FBatchScope()
+{
+	++GAnimPoseCacheBatchScopeDepth;
+}
+
+FAnimPoseCache::FBatchScope::~FBatchScope()
+{
+	check(GAnimPoseCacheBatchScopeDepth > 0);
+	--GAnimPoseCacheBatchScopeDepth;
+}
+
+FAnimPoseCache& FAnimPoseCache::Get()
+{
+	static FAnimPoseCache Instance;
+	return Instance;
+}
+
+FAnimPoseCache::FAnimPoseCache()
+	: TotalHits(0)
+	, TotalMisses(0)
+	, TotalEvictions(0)
+{
+}
+
+void FAnimPoseCache::OnStartup()
+{
+	// Multicast delegates aren't thread safe, register them here rather than on first use, which is usually on a worker
+	check(IsInGameThread());
+
+	FAnimPoseCache& Cache = Get();
+	FCoreDelegates::OnEndFrame.AddRaw(&Cache, &FAnimPoseCache::EndFrame);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(&Cache, &FAnimPoseCache::Flush);
+	GAnimPoseCacheStarted = true;
+}
+
+void FAnimPoseCache::OnShutdown()
+{
+	check(IsInGameThread());
+
+	FAnimPoseCache& Cache = Get();
+	GAnimPoseCacheStarted = false;
+	FCoreDelegates::OnEndFrame.RemoveAll(&Cache);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().RemoveAll(&Cache);
+	Cache.Flush();
+}
+
+bool FAnimPoseCache::IsEnabled()
+{
+	return (GAnimPoseCacheEnable != 0 || GAnimPoseCacheBatchScopeDepth > 0) && GAnimPoseCacheMaxPoses > 0 && GAnimPoseCacheStarted && !GIsEditor;
+}
+
+uint32 FAnimPoseCache::HashRequiredBones(const FBoneContainer& RequiredBones)
+{
+	const TArray<FBoneIndexType>& BoneIndices = RequiredBones.GetBoneIndicesArray();
+	const TArray<uint16>& CurveUIDToArrayIndexLUT = RequiredBones.GetUIDToArrayLookupTable();
+	uint32 Hash = FCrc::MemCrc32(BoneIndices.GetData(), BoneIndices.Num() * sizeof(FBoneIndexType));
+	Hash = FCrc::MemCrc32(CurveUIDToArrayIndexLUT.GetData(), CurveUIDToArrayIndexLUT.Num() * sizeof(uint16), Hash);
+	Hash = HashCombine(Hash, ::GetTypeHash(RequiredBones.GetAsset()));
+	return HashCombine(Hash, RequiredBones.GetDisableRetargeting() ? 1u : 0u);
+}
+
+bool FAnimPoseCache::MakeKey(const UAnimSequence* Sequence, const FAnimExtractContext& ExtractionContext, const FBoneContainer& RequiredBones, FKey& OutKey, float& OutSampleTime) const
+{
+	// Partial extractions depend on the node requesting them
+	if (ExtractionContext.BonesRequired.Num() > 0 || ExtractionContext.PoseCurves.Num() > 0)
+	{
+		return false;
+	}
+
+	// Batch scopes only share poses sampled at exactly the same time, unless the cache is enabled for everyone
+	const float TimeQuantum = GAnimPoseCacheEnable != 0 ? GAnimPoseCacheTimeQuantum : 0.f;
+	OutKey.bExactTime = TimeQuantum <= 0.f;
+	if (!OutKey.bExactTime)
+	{
+		OutKey.TimeIndex = FMath::RoundToInt(ExtractionContext.CurrentTime / TimeQuantum);
+		OutSampleTime = FMath::Min(OutKey.TimeIndex * TimeQuantum, Sequence->SequenceLength);
+	}
+	else
+	{
+		OutKey.TimeIndex = *reinterpret_cast<const int32*>(&ExtractionContext.CurrentTime);
+		OutSampleTime = ExtractionContext.CurrentTime;
+	}
+
+	OutKey.Sequence = Sequence;
+	OutKey.RequiredBonesHash = HashRequiredBones(RequiredBones);
+	OutKey.bExtractRootMotion = ExtractionContext.bExtractRootMotion;
+	return true;
+}
+
+bool FAnimPoseCache::FindPose(const FKey& Key, FAnimationPoseData& OutAnimationPoseData)
+{
+	FCompactPose& OutPose = OutAnimationPoseData.GetPose();
+	FBlendedCurve& OutCurve = OutAnimationPoseData.GetCurve();
+
+	{
+		FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+
+		const TUniquePtr<FEntry>* Entry = Entries.Find(Key);
+		if (Entry && (*Entry)->Bones.Num() == OutPose.GetNumBones() && (*Entry)->CurveWeights.Num() == OutCurve.CurveWeights.Num()
+			&& (*Entry)->BoneIndices == OutPose.GetBoneContainer().GetBoneIndicesArray()
+			&& (*Entry)->CurveUIDToArrayIndexLUT == OutPose.GetBoneContainer().GetUIDToArrayLookupTable())
+		{
+			OutPose.CopyBonesFrom((*Entry)->Bones);
+			FMemory::Memcpy(OutCurve.CurveWeights.GetData(), (*Entry)->CurveWeights.GetData(), (*Entry)->CurveWeights.Num() * sizeof(float));
+			OutCurve.ValidCurveWeights = (*Entry)->ValidCurveWeights;
+			(*Entry)->bUsedThisFrame = true;
+
+			FrameHits.Increment();
+			return true;
+		}
+	}
+
+	FrameMisses.Increment();
+	return false;
+}
+
+void FAnimPoseCache::AddPose(const FKey& Key, const FAnimationPoseData& AnimationPoseData)
+{
+	const FCompactPose& Pose = AnimationPoseData.GetPose();
+	const FBlendedCurve& Curve = AnimationPoseData.GetCurve();
+
+	// Build the entry outside of the lock
+	TUniquePtr<FEntry> NewEntry = MakeUnique<FEntry>();
+	NewEntry->BoneIndices = Pose.GetBoneContainer().GetBoneIndicesArray();
+	NewEntry->CurveUIDToArrayIndexLUT = Pose.GetBoneContainer().GetUIDToArrayLookupTable();
+	NewEntry->Bones = Pose.GetBones();
+	NewEntry->CurveWeights = Curve.CurveWeights;
+	NewEntry->ValidCurveWeights = Curve.ValidCurveWeights;
+	NewEntry->bUsedThisFrame = true;
+
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+
+	// Another component may have decompressed the same pose in the meantime, or collided on the required bones hash
+	if (Entries.Contains(Key))
+	{
+		return;
+	}
+
+	if (Entries.Num() >= GAnimPoseCacheMaxPoses)
+	{
+		FrameRejected.Increment();
+		return;
+	}
+
+	Entries.Add(Key, MoveTemp(NewEntry));
+}
+
+void FAnimPoseCache::EndFrame()
+{
+	check(IsInGameThread());
+
+	const int32 NumHits = FrameHits.Reset();
+	const int32 NumMisses = FrameMisses.Reset();
+	const int32 NumRejected = FrameRejected.Reset();
+
+	int32 NumEntries;
+	{
+		FRWScopeLock WriteLock(Lock, SLT_Write);
+
+		for (TMap<FKey, TUniquePtr<FEntry>>::TIterator It = Entries.CreateIterator(); It; ++It)
+		{
+			if (It.Value()->bUsedThisFrame)
+			{
+				It.Value()->bUsedThisFrame = false;
+			}
+			else
+			{
+				It.RemoveCurrent();
+				++TotalEvictions;
+			}
+		}
+
+		NumEntries = Entries.Num();
+	}
+
+	TotalHits += NumHits;
+	TotalMisses += NumMisses;
+
+	SET_DWORD_STAT(STAT_AnimPoseCacheHits, NumHits);
+	SET_DWORD_STAT(STAT_AnimPoseCacheMisses, NumMisses);
+	SET_DWORD_STAT(STAT_AnimPoseCacheRejected, NumRejected);
+	SET_DWORD_STAT(STAT_AnimPoseCacheEntries, NumEntries);
+}
+
+void FAnimPoseCache::Flush()
+{
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+
+	TotalEvictions += Entries.Num();
+	Entries.Reset();
+}
+
+void FAnimPoseCache::DumpStats() const
+{
+	const uint64 NumHits = TotalHits + FrameHits.GetValue();
+	const uint64 NumRequests = NumHits + TotalMisses + FrameMisses.GetValue();
+
+	int32 NumEntries;
+	{
+		FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+		NumEntries = Entries.Num();
+	}
+
+	UE_LOG(LogAnimation, Log, TEXT("Anim pose cache: %s, %d / %d poses, %llu hits for %llu requests (%.1f%%), %llu evictions"),
+		IsEnabled() ? TEXT("enabled") : TEXT("disabled"), NumEntries, GAnimPoseCacheMaxPoses, NumHits, NumRequests, NumRequests > 0 ? 100.0 * NumHits / NumRequests : 0.0, TotalEvictions);
+}
@@ -48,6 +48,7 @@
 #include "Animation/CustomAttributesRuntime.h"
 #include "Stats/StatsHierarchical.h"
 #include "Animation/AnimationPoseData.h"
+#include "Animation/AnimPoseCache.h"
 
 #define USE_SLERP 0
 #define LOCTEXT_NAMESPACE "AnimSequence"
@@ -1583,6 +1584,19 @@ void UAnimSequence::GetBonePose(FAnimationPoseData& OutAnimationPoseData, const
 		return;
 	}
 
+	// Cached poses may be sampled at quantized times, so that components sampling close times share them
+	FAnimPoseCache::FKey PoseCacheKey;
+	float PoseCacheSampleTime = 0.f;
+	const bool bUsePoseCache = !bUseRawDataForPoseExtraction && FAnimPoseCache::IsEnabled() && FAnimPoseCache::Get().MakeKey(this, ExtractionContext, RequiredBones, PoseCacheKey, PoseCacheSampleTime);
+	const FAnimExtractContext PoseCacheExtractionContext(PoseCacheSampleTime, ExtractionContext.bExtractRootMotion);
+	const FAnimExtractContext& PoseExtractionContext = bUsePoseCache ? PoseCacheExtractionContext : ExtractionContext;
+
+	if (bUsePoseCache && FAnimPoseCache::Get().FindPose(PoseCacheKey, OutAnimationPoseData))
+	{
+		GetCustomAttributes(OutAnimationPoseData, ExtractionContext, false);
+		return;
+	}
+
 	const bool bDisableRetargeting = RequiredBones.GetDisableRetargeting();
 
 	// initialize with ref-pose
@@ -1616,7 +1630,7 @@ void UAnimSequence::GetBonePose(FAnimationPoseData& OutAnimationPoseData, const
 	}
 
 	// extract curve data . Even if no track, it can contain curve data
-	EvaluateCurveData(OutAnimationPoseData.GetCurve(), ExtractionContext.CurrentTime, bUseRawDataForPoseExtraction);
+	EvaluateCurveData(OutAnimationPoseData.GetCurve(), PoseExtractionContext.CurrentTime, bUseRawDataForPoseExtraction);
 
 	const int32 NumTracks = bUseRawDataForPoseExtraction ? TrackToSkeletonMapTable.Num() : CompressedData.CompressedTrackToSkeletonMapTable.Num();
 	if (NumTracks == 0)
@@ -1661,7 +1675,13 @@ void UAnimSequence::GetBonePose(FAnimationPoseData& OutAnimationPoseData, const
 	}
 #endif // WITH_EDITOR
 
-	DecompressPose(OutPose, CompressedData, ExtractionContext, GetSkeleton(), SequenceLength, Interpolation, bIsBakedAdditive, RetargetSource, GetFName(), RootMotionReset);
+	DecompressPose(OutPose, CompressedData, PoseExtractionContext, GetSkeleton(), SequenceLength, Interpolation, bIsBakedAdditive, RetargetSource, GetFName(), RootMotionReset);
+
+	if (bUsePoseCache)
+	{
+		FAnimPoseCache::Get().AddPose(PoseCacheKey, OutAnimationPoseData);
+	}
+
 	GetCustomAttributes(OutAnimationPoseData, ExtractionContext, false);
 }
 
@@ -461,22 +461,37 @@ void FAnimationRuntime::BlendTwoPosesTogetherPerBone(const FAnimationPoseData& S
 	const FCompactPose& SourcePoseOne = SourcePoseOneData.GetPose();
 	const FCompactPose& SourcePoseTwo = SourcePoseTwoData.GetPose();
 
-	for (FCompactPoseBoneIndex BoneIndex : OutPose.ForEachBoneIndex())
+	if (INTEL_ISPC)
 	{
-		const float BlendWeight = WeightsOfSource2[BoneIndex.GetInt()];
-		if (FAnimationRuntime::IsFullWeight(BlendWeight))
-		{
-			OutPose[BoneIndex] = SourcePoseTwo[BoneIndex];
-		}
-		// if it doens't have weight, take source pose 1
-		else if (FAnimationRuntime::HasWeight(BlendWeight))
-		{
-			BlendTransform<ETransformBlendMode::Overwrite>(SourcePoseOne[BoneIndex], OutPose[BoneIndex], 1.f - BlendWeight);
-			BlendTransform<ETransformBlendMode::Accumulate>(SourcePoseTwo[BoneIndex], OutPose[BoneIndex], BlendWeight);
-		}
-		else
+#if INTEL_ISPC
+		check(WeightsOfSource2.Num() >= OutPose.GetNumBones());
+		ispc::BlendTransformsPerBone(
+			(ispc::FTransform*)&SourcePoseOne.GetBones()[0],
+			(ispc::FTransform*)&SourcePoseTwo.GetBones()[0],
+			(ispc::FTransform*)&OutPose.GetBones()[0],
+			WeightsOfSource2.GetData(),
+			OutPose.GetNumBones());
+#endif
+	}
+	else
+	{
+		for (FCompactPoseBoneIndex BoneIndex : OutPose.ForEachBoneIndex())
 		{
-			OutPose[BoneIndex] = SourcePoseOne[BoneIndex];
+			const float BlendWeight = WeightsOfSource2[BoneIndex.GetInt()];
+			if (FAnimationRuntime::IsFullWeight(BlendWeight))
+			{
+				OutPose[BoneIndex] = SourcePoseTwo[BoneIndex];
+			}
+			// if it doens't have weight, take source pose 1
+			else if (FAnimationRuntime::HasWeight(BlendWeight))
+			{
+				BlendTransform<ETransformBlendMode::Overwrite>(SourcePoseOne[BoneIndex], OutPose[BoneIndex], 1.f - BlendWeight);
+				BlendTransform<ETransformBlendMode::Accumulate>(SourcePoseTwo[BoneIndex], OutPose[BoneIndex], BlendWeight);
+			}
+			else
+			{
+				OutPose[BoneIndex] = SourcePoseOne[BoneIndex];
+			}
 		}
 	}
 
@@ -1089,12 +1104,25 @@ void FAnimationRuntime::AccumulateLocalSpaceAdditivePoseInternal(FCompactPose& B
 		}
 		else
 		{
-			// Slower path w/ weighting
-			for (FCompactPoseBoneIndex BoneIndex : BasePose.ForEachBoneIndex())
+			if (INTEL_ISPC)
+			{
+#if INTEL_ISPC
+				ispc::BlendFromIdentityAndAccumulate(
+					(ispc::FTransform*)&BasePose.GetBones()[0],
+					(ispc::FTransform*)&AdditivePose.GetBones()[0],
+					Weight,
+					BasePose.GetNumBones());
+#endif
+			}
+			else
 			{
-				// copy additive, because BlendFromIdentityAndAccumulate modifies it.
-				FTransform Additive = AdditivePose[BoneIndex];
-				FTransform::BlendFromIdentityAndAccumulate(BasePose[BoneIndex], Additive, VBlendWeight);
+				// Slower path w/ weighting
+				for (FCompactPoseBoneIndex BoneIndex : BasePose.ForEachBoneIndex())
+				{
+					// copy additive, because BlendFromIdentityAndAccumulate modifies it.
+					FTransform Additive = AdditivePose[BoneIndex];
+					FTransform::BlendFromIdentityAndAccumulate(BasePose[BoneIndex], Additive, VBlendWeight);
+				}
 			}
 		}
 	}
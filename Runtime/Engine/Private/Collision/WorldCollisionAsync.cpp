@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "Stats/Stats.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Async/ParallelFor.h"
 #include "EngineDefines.h"
 #include "Engine/EngineTypes.h"
 #include "CollisionQueryParams.h"
@@ -49,6 +50,13 @@ namespace AsyncTraceCVars
 	{
 		return RunAsyncTraceOnWorkerThread != 0 && (FApp::ShouldUseThreadingForPerformance() || FForkProcessHelper::IsForkedMultithreadInstance());
 	}
+
+	static int32 BatchSceneQueryChunkSize = 32;
+	static FAutoConsoleVariableRef CVarBatchSceneQueryChunkSize(
+		TEXT("BatchSceneQueryChunkSize"),
+		BatchSceneQueryChunkSize,
+		TEXT("Number of queries of a batched scene query run by each worker thread task."),
+		ECVF_Default);
 }
 
 namespace
@@ -106,6 +114,81 @@ namespace
 		}
 	};
 
+	/** Runs a single trace or sweep, shared by async and batched traces */
+	void RunTrace(const UWorld* World, EAsyncTraceType TraceType, const FCollisionParameters& CollisionParams, ECollisionChannel TraceChannel, const FVector& Start, const FVector& End, const FQuat& Rot, TArray<FHitResult>& OutHits)
+	{
+		if ((CollisionParams.CollisionShape.ShapeType == ECollisionShape::Line) || CollisionParams.CollisionShape.IsNearlyZero())
+		{
+			// MULTI
+			if (TraceType == EAsyncTraceType::Multi)
+			{
+				FPhysicsInterface::RaycastMulti(World, OutHits, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+			}
+			// SINGLE
+			else if(TraceType == EAsyncTraceType::Single)
+			{
+				FHitResult Result;
+
+				bool bHit = FPhysicsInterface::RaycastSingle(World, Result, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+
+				if(bHit)
+				{
+					OutHits.Add(Result);
+				}
+			}
+			// TEST
+			else
+			{
+				bool bHit = FPhysicsInterface::RaycastTest(World, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+
+				if(bHit)
+				{
+					FHitResult Result;
+					Result.bBlockingHit = true;
+					OutHits.Add(Result);
+				}
+			}
+		}
+		else
+		{
+			// MULTI
+			if (TraceType == EAsyncTraceType::Multi)
+			{
+				FPhysicsInterface::GeomSweepMulti(World, CollisionParams.CollisionShape, Rot, OutHits, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+			}
+			// SINGLE
+			else if (TraceType == EAsyncTraceType::Single)
+			{
+				FHitResult Result;
+
+				bool bHit = FPhysicsInterface::GeomSweepSingle(World, CollisionParams.CollisionShape, Rot, Result, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+
+				if(bHit)
+				{
+					OutHits.Add(Result);
+				}
+			}
+			// TEST
+			else
+			{
+				bool bHit = FPhysicsInterface::GeomSweepTest(World, CollisionParams.CollisionShape, Rot, Start, End, TraceChannel,
+					CollisionParams.CollisionQueryParam, CollisionParams.ResponseParam, CollisionParams.ObjectQueryParam);
+
+				if(bHit)
+				{
+					FHitResult Result;
+					Result.bBlockingHit = true;
+					OutHits.Add(Result);
+				}						
+			}
+		}
+	}
+
 	void RunTraceTask(FTraceDatum* TraceDataBuffer, int32 TotalCount)
 	{
 		check(TraceDataBuffer);
@@ -117,76 +200,7 @@ namespace
 
 			if (TraceData.PhysWorld.IsValid())
 			{
-				if ((TraceData.CollisionParams.CollisionShape.ShapeType == ECollisionShape::Line) || TraceData.CollisionParams.CollisionShape.IsNearlyZero())
-				{
-					// MULTI
-					if (TraceData.TraceType == EAsyncTraceType::Multi)
-					{
-						FPhysicsInterface::RaycastMulti(TraceData.PhysWorld.Get(), TraceData.OutHits, TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-					}
-					// SINGLE
-					else if(TraceData.TraceType == EAsyncTraceType::Single)
-					{
-						FHitResult Result;
-
-						bool bHit = FPhysicsInterface::RaycastSingle(TraceData.PhysWorld.Get(), Result, TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-
-						if(bHit)
-						{
-							TraceData.OutHits.Add(Result);
-						}
-					}
-					// TEST
-					else
-					{
-						bool bHit = FPhysicsInterface::RaycastTest(TraceData.PhysWorld.Get(), TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-
-						if(bHit)
-						{
-							FHitResult Result;
-							Result.bBlockingHit = true;
-							TraceData.OutHits.Add(Result);
-						}
-					}
-				}
-				else
-				{
-					// MULTI
-					if (TraceData.TraceType == EAsyncTraceType::Multi)
-					{
-						FPhysicsInterface::GeomSweepMulti(TraceData.PhysWorld.Get(), TraceData.CollisionParams.CollisionShape, TraceData.Rot, TraceData.OutHits, TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-					}
-					// SINGLE
-					else if (TraceData.TraceType == EAsyncTraceType::Single)
-					{
-						FHitResult Result;
-
-						bool bHit = FPhysicsInterface::GeomSweepSingle(TraceData.PhysWorld.Get(), TraceData.CollisionParams.CollisionShape, TraceData.Rot, Result, TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-
-						if(bHit)
-						{
-							TraceData.OutHits.Add(Result);
-						}
-					}
-					// TEST
-					else
-					{
-						bool bHit = FPhysicsInterface::GeomSweepTest(TraceData.PhysWorld.Get(), TraceData.CollisionParams.CollisionShape, TraceData.Rot, TraceData.Start, TraceData.End, TraceData.TraceChannel,
-							TraceData.CollisionParams.CollisionQueryParam, TraceData.CollisionParams.ResponseParam, TraceData.CollisionParams.ObjectQueryParam);
-
-						if(bHit)
-						{
-							FHitResult Result;
-							Result.bBlockingHit = true;
-							TraceData.OutHits.Add(Result);
-						}						
-					}
-				}
+				RunTrace(TraceData.PhysWorld.Get(), TraceData.TraceType, TraceData.CollisionParams, TraceData.TraceChannel, TraceData.Start, TraceData.End, TraceData.Rot, TraceData.OutHits);
 			}
 		}
 	}
@@ -357,6 +371,55 @@ namespace
 
 		return Result;
 	}
+
+	/** Runs the queries of a batch over worker threads, in chunks, then gathers their results in a single buffer in request order */
+	template <typename RequestType, typename ResultType, typename QueryFunctionType>
+	void RunBatchSceneQuery(TArrayView<const RequestType> Requests, TBatchSceneQueryResults<ResultType>& OutResults, const QueryFunctionType& QueryFunction)
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_RunBatchSceneQuery);
+
+		const int32 NumRequests = Requests.Num();
+		OutResults.Results.Reset();
+		OutResults.FirstResult.SetNumUninitialized(NumRequests);
+		OutResults.NumResults.SetNumUninitialized(NumRequests);
+		if (NumRequests == 0)
+		{
+			return;
+		}
+
+		const int32 ChunkSize = FMath::Max(AsyncTraceCVars::BatchSceneQueryChunkSize, 1);
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumRequests, ChunkSize);
+		TArray<TArray<ResultType>> ChunkResults;
+		ChunkResults.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&Requests, &OutResults, &ChunkResults, &QueryFunction, ChunkSize, NumRequests](int32 ChunkIndex)
+		{
+			TArray<ResultType>& Results = ChunkResults[ChunkIndex];
+			TArray<ResultType> QueryResults;
+
+			const int32 LastRequest = FMath::Min((ChunkIndex + 1) * ChunkSize, NumRequests);
+			for (int32 RequestIndex = ChunkIndex * ChunkSize; RequestIndex < LastRequest; ++RequestIndex)
+			{
+				QueryResults.Reset();
+				QueryFunction(Requests[RequestIndex], QueryResults);
+				OutResults.NumResults[RequestIndex] = QueryResults.Num();
+				Results.Append(QueryResults);
+			}
+		}, NumChunks == 1 || !AsyncTraceCVars::IsAsyncTraceOnWorkerThreads());
+
+		int32 NumResults = 0;
+		for (int32 RequestIndex = 0; RequestIndex < NumRequests; ++RequestIndex)
+		{
+			OutResults.FirstResult[RequestIndex] = NumResults;
+			NumResults += OutResults.NumResults[RequestIndex];
+		}
+
+		OutResults.Results.Reserve(NumResults);
+		for (TArray<ResultType>& Results : ChunkResults)
+		{
+			OutResults.Results.Append(MoveTemp(Results));
+		}
+	}
 }
 
 FWorldAsyncTraceState::FWorldAsyncTraceState()
@@ -514,3 +577,29 @@ void UWorld::FinishAsyncTrace()
 
 }
 
+void UWorld::BatchLineTraceByChannel(EAsyncTraceType InTraceType, TArrayView<const FBatchTraceRequest> Requests, ECollisionChannel TraceChannel, FBatchTraceResults& OutResults, const FCollisionQueryParams& Params /* = FCollisionQueryParams::DefaultQueryParam */, const FCollisionResponseParams& ResponseParam /* = FCollisionResponseParams::DefaultResponseParam */) const
+{
+	BatchSweepByChannel(InTraceType, Requests, TraceChannel, FCollisionShape::LineShape, OutResults, Params, ResponseParam);
+}
+
+void UWorld::BatchSweepByChannel(EAsyncTraceType InTraceType, TArrayView<const FBatchTraceRequest> Requests, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, FBatchTraceResults& OutResults, const FCollisionQueryParams& Params /* = FCollisionQueryParams::DefaultQueryParam */, const FCollisionResponseParams& ResponseParam /* = FCollisionResponseParams::DefaultResponseParam */) const
+{
+	FCollisionParameters CollisionParams;
+	CollisionParams.CollisionShape = CollisionShape;
+	CollisionParams.CollisionQueryParam = Params;
+	CollisionParams.ResponseParam = ResponseParam;
+	CollisionParams.ObjectQueryParam = FCollisionObjectQueryParams::DefaultObjectQueryParam;
+
+	RunBatchSceneQuery(Requests, OutResults, [this, InTraceType, &CollisionParams, TraceChannel](const FBatchTraceRequest& Request, TArray<FHitResult>& OutHits)
+	{
+		RunTrace(this, InTraceType, CollisionParams, TraceChannel, Request.Start, Request.End, Request.Rot, OutHits);
+	});
+}
+
+void UWorld::BatchOverlapByChannel(TArrayView<const FBatchOverlapRequest> Requests, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, FBatchOverlapResults& OutResults, const FCollisionQueryParams& Params /* = FCollisionQueryParams::DefaultQueryParam */, const FCollisionResponseParams& ResponseParam /* = FCollisionResponseParams::DefaultResponseParam */) const
+{
+	RunBatchSceneQuery(Requests, OutResults, [this, TraceChannel, &CollisionShape, &Params, &ResponseParam](const FBatchOverlapRequest& Request, TArray<FOverlapResult>& OutOverlaps)
+	{
+		FPhysicsInterface::GeomOverlapMulti(this, CollisionShape, Request.Pos, Request.Rot, OutOverlaps, TraceChannel, Params, ResponseParam, FCollisionObjectQueryParams::DefaultObjectQueryParam);
+	});
+}
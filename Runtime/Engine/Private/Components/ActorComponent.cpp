@@ -1034,6 +1034,11 @@ FName FActorComponentTickFunction::DiagnosticContext(bool bDetailed)
 	}
 }
 
+UClass* FActorComponentTickFunction::GetTickBatchClass() const
+{
+	return Target ? Target->GetClass() : nullptr;
+}
+
 
 bool UActorComponent::SetupActorComponentTickFunction(struct FTickFunction* TickFunction)
 {
@@ -1160,6 +1165,7 @@ void UActorComponent::RegisterComponentWithWorld(UWorld* InWorld, FRegisterCompo
 {
 	SCOPE_CYCLE_COUNTER(STAT_RegisterComponent);
 	FScopeCycleCounterUObject ComponentScope(this);
+	ensureNotInParallelTickBatch(TEXT("RegisterComponent"));
 
 	checkf(!IsUnreachable(), TEXT("%s"), *GetFullName());
 
@@ -1285,6 +1291,7 @@ void UActorComponent::UnregisterComponent()
 {
 	SCOPE_CYCLE_COUNTER(STAT_UnregisterComponent);
 	FScopeCycleCounterUObject ComponentScope(this);
+	ensureNotInParallelTickBatch(TEXT("UnregisterComponent"));
 
 	// Do nothing if not registered
 	if(!IsRegistered())
@@ -1677,6 +1684,8 @@ void UActorComponent::DoDeferredRenderUpdates_Concurrent()
 
 void UActorComponent::MarkRenderStateDirty()
 {
+	ensureNotInParallelTickBatch(TEXT("MarkRenderStateDirty"));
+
 	// If registered and has a render state to mark as dirty
 	if(IsRegistered() && bRenderStateCreated && (!bRenderStateDirty || !GetWorld()))
 	{
@@ -31,6 +31,7 @@
 #include "Streaming/TextureStreamingHelpers.h"
 #include "PrimitiveSceneProxy.h"
 #include "Algo/Copy.h"
+#include "Async/ParallelFor.h"
 #include "UObject/RenderingObjectVersion.h"
 #include "UObject/FortniteMainBranchObjectVersion.h"
 #include "EngineModule.h"
@@ -68,6 +69,21 @@ static FAutoConsoleVariableRef CVarAllowCachedOverlaps(
 	TEXT("0: disable cached overlaps, 1: enable (default)"),
 	ECVF_Default);
 
+static int32 bBatchOverlapUpdatesCVar = 0;
+static FAutoConsoleVariableRef CVarBatchOverlapUpdates(
+	TEXT("p.BatchOverlapUpdates"),
+	bBatchOverlapUpdatesCVar,
+	TEXT("Primitive Component physics\n")
+	TEXT("0: update overlaps when components move (default), 1: update overlaps of the components moved in a tick group together when it completes, querying them in parallel"),
+	ECVF_Default);
+
+static int32 BatchOverlapUpdatesMinParallelCVar = 16;
+static FAutoConsoleVariableRef CVarBatchOverlapUpdatesMinParallel(
+	TEXT("p.BatchOverlapUpdatesMinParallel"),
+	BatchOverlapUpdatesMinParallelCVar,
+	TEXT("Minimum number of overlap queries in a batch to run them in parallel."),
+	ECVF_Default);
+
 static float InitialOverlapToleranceCVar = 0.0f;
 static FAutoConsoleVariableRef CVarInitialOverlapTolerance(
 	TEXT("p.InitialOverlapTolerance"),
@@ -2354,12 +2370,18 @@ bool UPrimitiveComponent::MoveComponentImpl( const FVector& Delta, const FQuat&
 				}
 				TOverlapArrayView PendingOverlapsView(PendingOverlaps);
 				TOverlapArrayView OverlapsAtEndView(OverlapsAtEndLocation);
-				UpdateOverlaps(&PendingOverlapsView, true, bHasEndOverlaps ? &OverlapsAtEndView : nullptr);
+				if (!QueueOverlapUpdateInBatch(&PendingOverlapsView, bHasEndOverlaps ? &OverlapsAtEndView : nullptr))
+				{
+					UpdateOverlaps(&PendingOverlapsView, true, bHasEndOverlaps ? &OverlapsAtEndView : nullptr);
+				}
 			}
 			else
 			{
 				TOverlapArrayView PendingOverlapsView(PendingOverlaps);
-				UpdateOverlaps(&PendingOverlapsView, true, nullptr);
+				if (!QueueOverlapUpdateInBatch(&PendingOverlapsView, nullptr))
+				{
+					UpdateOverlaps(&PendingOverlapsView, true, nullptr);
+				}
 			}
 		}
 	}
@@ -3200,31 +3222,8 @@ bool UPrimitiveComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPending
 				}
 				else
 				{
-					SCOPE_CYCLE_COUNTER(STAT_PerformOverlapQuery);
 					UE_LOG(LogPrimitiveComponent, VeryVerbose, TEXT("%s->%s Performing overlaps!"), *GetNameSafe(GetOwner()), *GetName());
-					UWorld* const MyWorld = GetWorld();
-					TArray<FOverlapResult> Overlaps;
-					// note this will optionally include overlaps with components in the same actor (depending on bIgnoreChildren). 
-					FComponentQueryParams Params(SCENE_QUERY_STAT(UpdateOverlaps), bIgnoreChildren ? MyActor : nullptr);
-					Params.bIgnoreBlocks = true;	//We don't care about blockers since we only route overlap events to real overlaps
-					FCollisionResponseParams ResponseParam;
-					InitSweepCollisionParams(Params, ResponseParam);
-					ComponentOverlapMulti(Overlaps, MyWorld, GetComponentLocation(), GetComponentQuat(), GetCollisionObjectType(), Params);
-
-					for (int32 ResultIdx=0; ResultIdx < Overlaps.Num(); ResultIdx++)
-					{
-						const FOverlapResult& Result = Overlaps[ResultIdx];
-
-						UPrimitiveComponent* const HitComp = Result.Component.Get();
-						if (HitComp && (HitComp != this) && HitComp->GetGenerateOverlapEvents())
-						{
-							const bool bCheckOverlapFlags = false; // Already checked above
-							if (!ShouldIgnoreOverlapResult(MyWorld, MyActor, *this, Result.GetActor(), *HitComp, bCheckOverlapFlags))
-							{
-								OverlapMultiResult.Emplace(HitComp, Result.ItemIndex);		// don't need to add unique unless the overlap check can return dupes
-							}
-						}
-					}
+					QueryOverlapsAtCurrentLocation(OverlapMultiResult);
 
 					// Fill pointers to overlap results. We ensure below that OverlapMultiResult stays in scope so these pointers remain valid.
 					GetPointersToArrayData(NewOverlappingComponentPtrs, OverlapMultiResult);
@@ -3343,6 +3342,161 @@ bool UPrimitiveComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPending
 	return bCanSkipUpdateOverlaps;
 }
 
+void UPrimitiveComponent::QueryOverlapsAtCurrentLocation(TInlineOverlapInfoArray& OutOverlaps) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PerformOverlapQuery);
+
+	OutOverlaps.Reset();
+
+	const AActor* const MyActor = GetOwner();
+	if (!MyActor)
+	{
+		return;
+	}
+
+	// If we are the root component we ignore child components, see UpdateOverlapsImpl()
+	const bool bIgnoreChildren = (MyActor->GetRootComponent() == this);
+
+	UWorld* const MyWorld = GetWorld();
+	TArray<FOverlapResult> Overlaps;
+	// note this will optionally include overlaps with components in the same actor (depending on bIgnoreChildren). 
+	FComponentQueryParams Params(SCENE_QUERY_STAT(UpdateOverlaps), bIgnoreChildren ? MyActor : nullptr);
+	Params.bIgnoreBlocks = true;	//We don't care about blockers since we only route overlap events to real overlaps
+	FCollisionResponseParams ResponseParam;
+	InitSweepCollisionParams(Params, ResponseParam);
+	ComponentOverlapMulti(Overlaps, MyWorld, GetComponentLocation(), GetComponentQuat(), GetCollisionObjectType(), Params);
+
+	for (int32 ResultIdx=0; ResultIdx < Overlaps.Num(); ResultIdx++)
+	{
+		const FOverlapResult& Result = Overlaps[ResultIdx];
+
+		UPrimitiveComponent* const HitComp = Result.Component.Get();
+		if (HitComp && (HitComp != this) && HitComp->GetGenerateOverlapEvents())
+		{
+			const bool bCheckOverlapFlags = false; // Already checked by the caller
+			if (!ShouldIgnoreOverlapResult(MyWorld, MyActor, *this, Result.GetActor(), *HitComp, bCheckOverlapFlags))
+			{
+				OutOverlaps.Emplace(HitComp, Result.ItemIndex);		// don't need to add unique unless the overlap check can return dupes
+			}
+		}
+	}
+}
+
+bool UPrimitiveComponent::QueueOverlapUpdateInBatch(const TOverlapArrayView* PendingOverlaps, const TOverlapArrayView* OverlapsAtEndLocation)
+{
+	FScopedOverlapUpdateBatch* Batch = FScopedOverlapUpdateBatch::Get(GetWorld());
+	if (Batch && !ShouldSkipUpdateOverlaps())
+	{
+		Batch->AddUpdate(*this, PendingOverlaps, OverlapsAtEndLocation);
+		return true;
+	}
+	return false;
+}
+
+FScopedOverlapUpdateBatch* FScopedOverlapUpdateBatch::Current = nullptr;
+
+FScopedOverlapUpdateBatch::FScopedOverlapUpdateBatch(UWorld* InWorld)
+	: World(InWorld)
+	, bIsOwner(bBatchOverlapUpdatesCVar && InWorld && Current == nullptr && IsInGameThread())
+{
+	if (bIsOwner)
+	{
+		Current = this;
+	}
+}
+
+FScopedOverlapUpdateBatch::~FScopedOverlapUpdateBatch()
+{
+	if (bIsOwner)
+	{
+		Flush();
+	}
+}
+
+FScopedOverlapUpdateBatch* FScopedOverlapUpdateBatch::Get(const UWorld* InWorld)
+{
+	return (Current && Current->World == InWorld && IsInGameThread()) ? Current : nullptr;
+}
+
+void FScopedOverlapUpdateBatch::AddUpdate(UPrimitiveComponent& Component, const TOverlapArrayView* PendingOverlaps, const TOverlapArrayView* OverlapsAtEndLocation)
+{
+	int32& UpdateIndex = ComponentToUpdate.FindOrAdd(&Component, INDEX_NONE);
+	if (UpdateIndex == INDEX_NONE)
+	{
+		UpdateIndex = PendingUpdates.AddDefaulted();
+		PendingUpdates[UpdateIndex].Component = &Component;
+	}
+
+	FPendingUpdate& Update = PendingUpdates[UpdateIndex];
+	if (PendingOverlaps)
+	{
+		Update.PendingOverlaps.Append(PendingOverlaps->GetData(), PendingOverlaps->Num());
+	}
+
+	// Only the overlaps at the end of the last move are relevant
+	Update.bHasOverlapsAtEndLocation = (OverlapsAtEndLocation != nullptr);
+	Update.OverlapsAtEndLocation.Reset();
+	if (OverlapsAtEndLocation)
+	{
+		Update.OverlapsAtEndLocation.Append(OverlapsAtEndLocation->GetData(), OverlapsAtEndLocation->Num());
+		Update.EndTransform = Component.GetComponentTransform();
+	}
+}
+
+void FScopedOverlapUpdateBatch::Flush()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UpdateOverlaps);
+
+	// Overlap events dispatched below update overlaps right away
+	Current = nullptr;
+
+	if (PendingUpdates.Num() == 0)
+	{
+		return;
+	}
+
+	struct FOverlapQuery
+	{
+		const UPrimitiveComponent* Component;
+		FPendingUpdate* Update;
+	};
+
+	// Query overlaps at the end location of the components that don't know them from their last move
+	TArray<FOverlapQuery> Queries;
+	for (FPendingUpdate& Update : PendingUpdates)
+	{
+		const UPrimitiveComponent* Component = Update.Component.Get();
+		if (!Update.bHasOverlapsAtEndLocation && Component && !Component->IsPendingKill() && Component->GetGenerateOverlapEvents() && Component->IsQueryCollisionEnabled())
+		{
+			Update.EndTransform = Component->GetComponentTransform();
+			Update.bHasOverlapsAtEndLocation = true;
+			Queries.Add({ Component, &Update });
+		}
+	}
+
+	ParallelFor(Queries.Num(), [&Queries](int32 Index)
+	{
+		Queries[Index].Component->QueryOverlapsAtCurrentLocation(Queries[Index].Update->OverlapsAtEndLocation);
+	}, Queries.Num() < BatchOverlapUpdatesMinParallelCVar);
+
+	// Dispatch the events in the order the components first moved, so results don't depend on how the queries were scheduled
+	for (FPendingUpdate& Update : PendingUpdates)
+	{
+		UPrimitiveComponent* Component = Update.Component.Get();
+		if (Component)
+		{
+			// Overlaps at the end location are stale if the component was moved by events dispatched so far
+			const bool bUseOverlapsAtEndLocation = Update.bHasOverlapsAtEndLocation && Update.EndTransform.Equals(Component->GetComponentTransform());
+			const TOverlapArrayView PendingOverlapsView(Update.PendingOverlaps);
+			const TOverlapArrayView OverlapsAtEndView(Update.OverlapsAtEndLocation);
+			Component->UpdateOverlaps(&PendingOverlapsView, true, bUseOverlapsAtEndLocation ? &OverlapsAtEndView : nullptr);
+		}
+	}
+
+	PendingUpdates.Reset();
+	ComponentToUpdate.Reset();
+}
+
 bool RequiresUpdateOverlaps(bool bGenerateOverlapEvents)
 {
 	return bGenerateOverlapEvents;
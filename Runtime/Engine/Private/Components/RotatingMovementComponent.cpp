@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameFramework/RotatingMovementComponent.h"
+#include "GameFramework/Actor.h"
 
 URotatingMovementComponent::URotatingMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -12,6 +13,12 @@ URotatingMovementComponent::URotatingMovementComponent(const FObjectInitializer&
 
 	RotationRate.Yaw = 180.0f;
 	bRotationInLocalSpace = true;
+
+	// subclasses may override TickComponent, only this exact class is ticked in batches
+	if (GetClass() == URotatingMovementComponent::StaticClass())
+	{
+		PrimaryComponentTick.ExecuteTickBatchFunction = &FActorComponentTickFunction::ExecuteTickBatch<URotatingMovementComponent>;
+	}
 }
 
 
@@ -25,6 +32,29 @@ void URotatingMovementComponent::TickComponent(float DeltaTime, enum ELevelTick
 
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	ApplyRotation(DeltaTime);
+}
+
+void URotatingMovementComponent::TickComponentsBatch(TArrayView<URotatingMovementComponent* const> Components, TArrayView<const float> DeltaTimes, ELevelTick TickType)
+{
+	// Same as TickComponent without virtual dispatch. Components are still moved one after the other,
+	// a rotating component can move the parent of another one's updated component.
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		URotatingMovementComponent* Component = Components[Index];
+		const float DeltaTime = DeltaTimes[Index];
+		if (Component->ShouldSkipUpdate(DeltaTime))
+		{
+			continue;
+		}
+
+		Component->Super::TickComponent(DeltaTime, TickType, &Component->PrimaryComponentTick);
+		Component->ApplyRotation(DeltaTime);
+	}
+}
+
+void URotatingMovementComponent::ApplyRotation(float DeltaTime)
+{
 	if (!IsValid(UpdatedComponent))
 	{
 		return;
@@ -855,7 +855,10 @@ void USceneComponent::EndScopedMovementUpdate(class FScopedMovementUpdate& Compl
 					TInlineOverlapInfoArray EndOverlaps;
 					const TOverlapArrayView PendingOverlaps(CurrentScopedUpdate->GetPendingOverlaps());
 					const TOptional<TOverlapArrayView> EndOverlapsOptional = CurrentScopedUpdate->GetOverlapsAtEnd(*PrimitiveThis, EndOverlaps, bTransformChanged);
-					UpdateOverlaps(&PendingOverlaps, true, EndOverlapsOptional.IsSet() ? &(EndOverlapsOptional.GetValue()) : nullptr);
+					if (!PrimitiveThis->QueueOverlapUpdateInBatch(&PendingOverlaps, EndOverlapsOptional.IsSet() ? &(EndOverlapsOptional.GetValue()) : nullptr))
+					{
+						UpdateOverlaps(&PendingOverlaps, true, EndOverlapsOptional.IsSet() ? &(EndOverlapsOptional.GetValue()) : nullptr);
+					}
 				}
 				else
 				{
@@ -40,6 +40,7 @@
 #include "SkeletalRenderPublic.h"
 #include "ContentStreaming.h"
 #include "Animation/AnimTrace.h"
+#include "Animation/AnimPoseCache.h"
 #if INTEL_ISPC
 #include "SkeletalMeshComponent.ispc.generated.h"
 #endif
@@ -50,6 +51,7 @@ TAutoConsoleVariable<int32> CVarUseParallelAnimationEvaluation(TEXT("a.ParallelA
 TAutoConsoleVariable<int32> CVarUseParallelAnimUpdate(TEXT("a.ParallelAnimUpdate"), 1, TEXT("If != 0, then we update animation blend tree, native update, asset players and montages (is possible) on worker threads."));
 TAutoConsoleVariable<int32> CVarForceUseParallelAnimUpdate(TEXT("a.ForceParallelAnimUpdate"), 0, TEXT("If != 0, then we update animations on worker threads regardless of the setting on the project or anim blueprint."));
 TAutoConsoleVariable<int32> CVarUseParallelAnimationInterpolation(TEXT("a.ParallelAnimInterpolation"), 1, TEXT("If 1, animation interpolation will be run across the task graph system. If 0, interpolation will run purely on the game thread"));
+TAutoConsoleVariable<int32> CVarForceLightweightServerAnimation(TEXT("a.ForceLightweightServerAnimation"), 0, TEXT("If 1, all skeletal mesh components on a dedicated server only evaluate the bones needed by physics, root motion and gameplay sockets, as if bLightweightServerAnimation was set. Applies when required bones are next recomputed."));
 
 static TAutoConsoleVariable<float> CVarStallParallelAnimation(
 	TEXT("CriticalPathStall.ParallelAnimation"),
@@ -171,6 +173,137 @@ public:
 	}
 };
 
+static int32 GParallelAnimEvaluationBatchSize = 0;
+static FAutoConsoleVariableRef CVarParallelAnimEvaluationBatchSize(
+	TEXT("a.ParallelAnimEvaluation.BatchSize"),
+	GParallelAnimEvaluationBatchSize,
+	TEXT("If > 1, parallel evaluation of components sharing a skeletal mesh and anim class is grouped in tasks of up to this many components, which share the poses decompressed from their sequences. ")
+	TEXT("A batch is evaluated serially on one worker, so larger batches trade latency of the last component for less decompression. 0 dispatches a task per component."));
+
+/** Components evaluated by a single task */
+struct FAnimationEvaluationBatch
+{
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>, TInlineAllocator<32>> Components;
+};
+
+class FParallelAnimationEvaluationBatchTask
+{
+	TUniquePtr<FAnimationEvaluationBatch> Batch;
+
+public:
+	FParallelAnimationEvaluationBatchTask(TUniquePtr<FAnimationEvaluationBatch>&& InBatch)
+		: Batch(MoveTemp(InBatch))
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FParallelAnimationEvaluationBatchTask, STATGROUP_TaskGraphTasks);
+	}
+	static FORCEINLINE ENamedThreads::Type GetDesiredThread()
+	{
+		return CPrio_ParallelAnimationEvaluationTask.Get();
+	}
+	static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (CurrentThread != ENamedThreads::GameThread)
+		{
+			GInitRunaway();
+		}
+
+		// Components of a batch often sample the same sequence at the same time
+		FAnimPoseCache::FBatchScope PoseCacheScope;
+		for (const TWeakObjectPtr<USkeletalMeshComponent>& WeakComp : Batch->Components)
+		{
+			if (USkeletalMeshComponent* Comp = WeakComp.Get())
+			{
+				FScopeCycleCounterUObject ContextScope(Comp);
+				Comp->ParallelAnimationEvaluation();
+			}
+		}
+	}
+};
+
+/**
+ * Groups the parallel evaluation tasks of components using the same skeletal mesh and anim class, such as crowds.
+ * A batch task is held while components join it, and dispatched once full or when the game thread flushes the open batches.
+ * The components of a batch are evaluated one after the other on a single worker, so the last one completes up to BatchSize
+ * evaluations later than with a task per component. Keep batches small enough that they still spread over the available
+ * workers, or the game thread ends up waiting on them when it blocks on evaluation completion.
+ * Game thread only.
+ */
+class FAnimationEvaluationBatcher
+{
+public:
+	/** Adds the component to an open batch, returns the completion event of the batch task */
+	static FGraphEventRef AddComponent(USkeletalMeshComponent* Component)
+	{
+		check(IsInGameThread());
+
+		const FBatchKey Key(Component->SkeletalMesh, Component->GetAnimInstance() ? Component->GetAnimInstance()->GetClass() : nullptr);
+		FOpenBatch* OpenBatch = OpenBatches.Find(Key);
+		if (OpenBatch == nullptr)
+		{
+			FAnimationEvaluationBatch* NewBatch = new FAnimationEvaluationBatch();
+			OpenBatch = &OpenBatches.Add(Key);
+			OpenBatch->Batch = NewBatch;
+			OpenBatch->Task = TGraphTask<FParallelAnimationEvaluationBatchTask>::CreateTask().ConstructAndHold(TUniquePtr<FAnimationEvaluationBatch>(NewBatch));
+
+			// Flush once the ticks already queued on the game thread, likely the rest of the crowd, had a chance to join
+			if (!bFlushPending)
+			{
+				bFlushPending = true;
+				FFunctionGraphTask::CreateAndDispatchWhenReady([]() { Flush(); }, TStatId(), nullptr, ENamedThreads::GameThread);
+			}
+		}
+
+		OpenBatch->Batch->Components.Add(Component);
+		FGraphEventRef CompletionEvent = OpenBatch->Task->GetCompletionEvent();
+
+		if (OpenBatch->Batch->Components.Num() >= GParallelAnimEvaluationBatchSize)
+		{
+			OpenBatch->Task->Unlock();
+			OpenBatches.Remove(Key);
+		}
+
+		return CompletionEvent;
+	}
+
+	/** Dispatches all the open batches, must be called before blocking on the evaluation of a component */
+	static void Flush()
+	{
+		check(IsInGameThread());
+
+		for (TPair<FBatchKey, FOpenBatch>& Pair : OpenBatches)
+		{
+			Pair.Value.Task->Unlock();
+		}
+		OpenBatches.Reset();
+		bFlushPending = false;
+	}
+
+private:
+	typedef TPair<const USkeletalMesh*, const UClass*> FBatchKey;
+
+	struct FOpenBatch
+	{
+		/** Owned by the task, only accessed until the task is unlocked */
+		FAnimationEvaluationBatch* Batch = nullptr;
+		TGraphTask<FParallelAnimationEvaluationBatchTask>* Task = nullptr;
+	};
+
+	static TMap<FBatchKey, FOpenBatch> OpenBatches;
+	static bool bFlushPending;
+};
+
+TMap<FAnimationEvaluationBatcher::FBatchKey, FAnimationEvaluationBatcher::FOpenBatch> FAnimationEvaluationBatcher::OpenBatches;
+bool FAnimationEvaluationBatcher::bFlushPending = false;
+
 USkeletalMeshComponent::USkeletalMeshComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -1663,12 +1796,47 @@ void USkeletalMeshComponent::ComputeRequiredBones(TArray<FBoneIndexType>& OutReq
 
 	LODIndex = FMath::Clamp(LODIndex, 0, SkelMeshRenderData->LODRenderData.Num() - 1);
 
-	// The list of bones we want is taken from the predicted LOD level.
-	FSkeletalMeshLODRenderData& LODData = SkelMeshRenderData->LODRenderData[LODIndex];
-	OutRequiredBones = LODData.RequiredBones;
+	if (IsUsingLightweightServerAnimation())
+	{
+		// Nobody sees the mesh, only keep the root for root motion and the bones gameplay reads, the physics asset is merged in below
+		OutRequiredBones.Reset();
+		OutRequiredBones.Add(0);
+
+		TArray<FBoneIndexType> GameplayBones;
+		auto AddSocketBone = [this, &GameplayBones](FName SocketName)
+		{
+			const int32 BoneIndex = SkeletalMesh->RefSkeleton.FindBoneIndex(GetSocketBoneName(SocketName));
+			if (BoneIndex != INDEX_NONE)
+			{
+				GameplayBones.AddUnique(BoneIndex);
+			}
+		};
+
+		for (FName SocketName : ServerRequiredSockets)
+		{
+			AddSocketBone(SocketName);
+		}
+
+		for (const USceneComponent* Child : GetAttachChildren())
+		{
+			if (Child && Child->GetAttachSocketName() != NAME_None)
+			{
+				AddSocketBone(Child->GetAttachSocketName());
+			}
+		}
 
-	// Add virtual bones
-	MergeInBoneIndexArrays(OutRequiredBones, SkeletalMesh->RefSkeleton.GetRequiredVirtualBones());
+		GameplayBones.Sort();
+		MergeInBoneIndexArrays(OutRequiredBones, GameplayBones);
+	}
+	else
+	{
+		// The list of bones we want is taken from the predicted LOD level.
+		FSkeletalMeshLODRenderData& LODData = SkelMeshRenderData->LODRenderData[LODIndex];
+		OutRequiredBones = LODData.RequiredBones;
+
+		// Add virtual bones
+		MergeInBoneIndexArrays(OutRequiredBones, SkeletalMesh->RefSkeleton.GetRequiredVirtualBones());
+	}
 
 	const UPhysicsAsset* const PhysicsAsset = GetPhysicsAsset();
 	// If we have a PhysicsAsset, we also need to make sure that all the bones used by it are always updated, as its used
@@ -1805,6 +1973,37 @@ void USkeletalMeshComponent::ComputeRequiredBones(TArray<FBoneIndexType>& OutReq
 	FAnimationRuntime::EnsureParentsPresent(OutFillComponentSpaceTransformsRequiredBones, SkeletalMesh->RefSkeleton);
 }
 
+bool USkeletalMeshComponent::IsUsingLightweightServerAnimation() const
+{
+	return (bLightweightServerAnimation || CVarForceLightweightServerAnimation.GetValueOnAnyThread() != 0) && IsNetMode(NM_DedicatedServer);
+}
+
+bool USkeletalMeshComponent::ShouldSkipLODThresholdNodesOnServer() const
+{
+	return bSkipLODThresholdNodesOnServer && IsNetMode(NM_DedicatedServer);
+}
+
+void USkeletalMeshComponent::OnChildAttached(USceneComponent* ChildComponent)
+{
+	Super::OnChildAttached(ChildComponent);
+
+	// Lightweight server animation keeps the sockets children are attached to animated
+	if (ChildComponent && ChildComponent->GetAttachSocketName() != NAME_None && IsUsingLightweightServerAnimation())
+	{
+		bRequiredBonesUpToDate = false;
+	}
+}
+
+void USkeletalMeshComponent::OnChildDetached(USceneComponent* ChildComponent)
+{
+	Super::OnChildDetached(ChildComponent);
+
+	if (ChildComponent && ChildComponent->GetAttachSocketName() != NAME_None && IsUsingLightweightServerAnimation())
+	{
+		bRequiredBonesUpToDate = false;
+	}
+}
+
 void USkeletalMeshComponent::RecalcRequiredBones(int32 LODIndex)
 {
 	if (!SkeletalMesh)
@@ -2359,7 +2558,14 @@ void USkeletalMeshComponent::DispatchParallelEvaluationTasks(FActorComponentTick
 
 	// start parallel work
 	check(!IsValidRef(ParallelAnimationEvaluationTask));
-	ParallelAnimationEvaluationTask = TGraphTask<FParallelAnimationEvaluationTask>::CreateTask().ConstructAndDispatchWhenReady(this);
+	if (GParallelAnimEvaluationBatchSize > 1 && IsInGameThread())
+	{
+		ParallelAnimationEvaluationTask = FAnimationEvaluationBatcher::AddComponent(this);
+	}
+	else
+	{
+		ParallelAnimationEvaluationTask = TGraphTask<FParallelAnimationEvaluationTask>::CreateTask().ConstructAndDispatchWhenReady(this);
+	}
 
 	// set up a task to run on the game thread to accept the results
 	FGraphEventArray Prerequistes;
@@ -3863,6 +4069,7 @@ bool USkeletalMeshComponent::HandleExistingParallelEvaluationTask(bool bBlockOnT
 		if (bBlockOnTask)
 		{
 			check(IsInGameThread()); // Only attempt this from game thread!
+			FAnimationEvaluationBatcher::Flush(); // Our task may be held in a batch
 			FTaskGraphInterface::Get().WaitUntilTaskCompletes(ParallelAnimationEvaluationTask, ENamedThreads::GameThread);
 			CompleteParallelAnimationEvaluation(bPerformPostAnimEvaluation); //Perform completion now
 		}
@@ -193,8 +193,9 @@ namespace FAnimUpdateRateManager
 		// Not rendered, including dedicated servers. we can skip the Evaluation part.
 		if (!bRecentlyRendered)
 		{
-			const int32 NewUpdateRate = ((bHumanControlled || bNeedsEveryFrame) ? 1 : Tracker->UpdateRateParameters.BaseNonRenderedUpdateRate);
-			const int32 NewEvaluationRate = Tracker->UpdateRateParameters.BaseNonRenderedUpdateRate;
+			const int32 SignificanceUpdateRate = bHumanControlled ? 1 : Tracker->UpdateRateParameters.SignificanceUpdateRate;
+			const int32 NewUpdateRate = ((bHumanControlled || bNeedsEveryFrame) ? 1 : FMath::Max(Tracker->UpdateRateParameters.BaseNonRenderedUpdateRate, SignificanceUpdateRate));
+			const int32 NewEvaluationRate = FMath::Max(Tracker->UpdateRateParameters.BaseNonRenderedUpdateRate, SignificanceUpdateRate);
 			Tracker->UpdateRateParameters.SetTrailMode(DeltaTime, Tracker->GetAnimUpdateRateShiftTag(Tracker->UpdateRateParameters.ShiftBucket), NewUpdateRate, NewEvaluationRate, false);
 		}
 		// Visible controlled characters or playing root motion. Need evaluation and ticking done every frame.
@@ -252,6 +253,9 @@ namespace FAnimUpdateRateManager
 				}
 			}
 
+			// Less significant actors don't update faster than their significance allows
+			DesiredEvaluationRate = FMath::Max(DesiredEvaluationRate, Tracker->UpdateRateParameters.SignificanceUpdateRate);
+
 			int32 ForceAnimRate = CVarForceAnimRate.GetValueOnGameThread();
 			if (ForceAnimRate)
 			{
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Engine/TickSignificanceSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GTickSignificanceEnabled = 1;
+static FAutoConsoleVariableRef CVarTickSignificanceEnabled(
+	TEXT("tick.SignificanceEnabled"),
+	GTickSignificanceEnabled,
+	TEXT("If 0, actors registered with the tick significance subsystem are kept at their base update rates."),
+	ECVF_Default);
+
+UTickSignificanceSubsystem::UTickSignificanceSubsystem()
+	: MaxSignificanceDistance(10000.f)
+	, UpdateInterval(0.25f)
+	, TimeSinceUpdate(0.f)
+{
+	FTickSignificanceLevel& FullRate = SignificanceLevels.AddDefaulted_GetRef();
+	FullRate.MinSignificance = 0.75f;
+
+	FTickSignificanceLevel& Medium = SignificanceLevels.AddDefaulted_GetRef();
+	Medium.MinSignificance = 0.4f;
+	Medium.TickInterval = 0.1f;
+	Medium.NetUpdateFrequencyScale = 0.5f;
+	Medium.AnimUpdateRate = 2;
+
+	FTickSignificanceLevel& Low = SignificanceLevels.AddDefaulted_GetRef();
+	Low.MinSignificance = 0.f;
+	Low.TickInterval = 0.25f;
+	Low.NetUpdateFrequencyScale = 0.25f;
+	Low.AnimUpdateRate = 4;
+}
+
+void UTickSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SignificanceLevels.Sort([](const FTickSignificanceLevel& A, const FTickSignificanceLevel& B)
+	{
+		return A.MinSignificance > B.MinSignificance;
+	});
+}
+
+void UTickSignificanceSubsystem::Deinitialize()
+{
+	// Restore the base rates of the actors still alive and unregister callbacks
+	for (FManagedActor& ManagedActor : ManagedActors)
+	{
+		if (AActor* Actor = ManagedActor.Actor.Get())
+		{
+			ApplyLevel(ManagedActor, INDEX_NONE);
+			Actor->OnEndPlay.RemoveAll(this);
+		}
+	}
+	ManagedActors.Empty();
+}
+
+bool UTickSignificanceSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UTickSignificanceSubsystem::RegisterActor(AActor* ActorToRegister, FSignificanceFunction SignificanceFunction)
+{
+	if (!ActorToRegister || ManagedActors.ContainsByPredicate([ActorToRegister](const FManagedActor& ManagedActor) { return ManagedActor.Actor.Get() == ActorToRegister; }))
+	{
+		return false;
+	}
+
+	FManagedActor& ManagedActor = ManagedActors.AddDefaulted_GetRef();
+	ManagedActor.Actor = ActorToRegister;
+	ManagedActor.SignificanceFunction = MoveTemp(SignificanceFunction);
+	ManagedActor.BaseTickInterval = ActorToRegister->GetActorTickInterval();
+	ManagedActor.BaseNetUpdateFrequency = ActorToRegister->NetUpdateFrequency;
+
+	for (UActorComponent* Component : ActorToRegister->GetComponents())
+	{
+		if (Component && Component->PrimaryComponentTick.bCanEverTick)
+		{
+			ManagedActor.Components.Add({ Component, Component->GetComponentTickInterval() });
+		}
+	}
+
+	ActorToRegister->OnEndPlay.AddDynamic(this, &UTickSignificanceSubsystem::OnActorEndPlay);
+	return true;
+}
+
+void UTickSignificanceSubsystem::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterActor(Actor);
+}
+
+bool UTickSignificanceSubsystem::UnregisterActor(AActor* ActorToRemove)
+{
+	const int32 Index = ManagedActors.IndexOfByPredicate([ActorToRemove](const FManagedActor& ManagedActor) { return ManagedActor.Actor.Get() == ActorToRemove; });
+	if (ActorToRemove && Index != INDEX_NONE)
+	{
+		ApplyLevel(ManagedActors[Index], INDEX_NONE);
+		ManagedActors.RemoveAtSwap(Index);
+		ActorToRemove->OnEndPlay.RemoveAll(this);
+		return true;
+	}
+	return false;
+}
+
+float UTickSignificanceSubsystem::GetActorSignificance(const AActor* Actor) const
+{
+	const FManagedActor* ManagedActor = ManagedActors.FindByPredicate([Actor](const FManagedActor& Item) { return Item.Actor.Get() == Actor; });
+	return ManagedActor ? ManagedActor->Significance : 1.f;
+}
+
+ETickableTickType UTickSignificanceSubsystem::GetTickableTickType() const
+{
+	// The CDO of this should never tick
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+void UTickSignificanceSubsystem::Tick(float DeltaTime)
+{
+	// Only tick if we know that the outer world is not being destroyed, see UAutoDestroySubsystem::Tick
+	UObject* Outer = GetOuter();
+	if (!Outer || Outer->HasAnyFlags(RF_BeginDestroyed))
+	{
+		return;
+	}
+
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval || ManagedActors.Num() == 0 || SignificanceLevels.Num() == 0)
+	{
+		return;
+	}
+	TimeSinceUpdate = 0.f;
+
+	// Actors destroyed without ending play, e.g. when their level is unloaded
+	ManagedActors.RemoveAllSwap([](const FManagedActor& ManagedActor) { return !ManagedActor.Actor.IsValid(); });
+
+	if (!GTickSignificanceEnabled)
+	{
+		for (FManagedActor& ManagedActor : ManagedActors)
+		{
+			ApplyLevel(ManagedActor, INDEX_NONE);
+		}
+		return;
+	}
+
+	TArray<FTransform> Viewers;
+	GatherViewers(Viewers);
+
+	const float InvMaxDistanceSq = 1.f / FMath::Square(FMath::Max(MaxSignificanceDistance, KINDA_SMALL_NUMBER));
+
+	TArray<int32> Levels;
+	Levels.Reserve(ManagedActors.Num());
+	for (FManagedActor& ManagedActor : ManagedActors)
+	{
+		const AActor* Actor = ManagedActor.Actor.Get();
+		if (ManagedActor.SignificanceFunction)
+		{
+			ManagedActor.Significance = FMath::Clamp(ManagedActor.SignificanceFunction(Actor, Viewers), 0.f, 1.f);
+		}
+		else
+		{
+			// Without any viewer, e.g. on a server with no connections, nothing is significant
+			const FVector ActorLocation = Actor->GetActorLocation();
+			float MinDistanceSq = BIG_NUMBER;
+			for (const FTransform& Viewer : Viewers)
+			{
+				MinDistanceSq = FMath::Min(MinDistanceSq, FVector::DistSquared(Viewer.GetLocation(), ActorLocation));
+			}
+			ManagedActor.Significance = 1.f - FMath::Min(FMath::Sqrt(MinDistanceSq * InvMaxDistanceSq), 1.f);
+		}
+
+		Levels.Add(GetSignificanceLevel(ManagedActor.Significance));
+	}
+
+	ApplyTickGroupBudgets(Levels);
+
+	for (int32 Index = 0; Index < ManagedActors.Num(); ++Index)
+	{
+		if (ManagedActors[Index].Level != Levels[Index])
+		{
+			ApplyLevel(ManagedActors[Index], Levels[Index]);
+		}
+	}
+}
+
+void UTickSignificanceSubsystem::GatherViewers(TArray<FTransform>& OutViewers) const
+{
+	// On a server the world has a player controller per connection, on clients only the local ones
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			OutViewers.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+}
+
+int32 UTickSignificanceSubsystem::GetSignificanceLevel(float Significance) const
+{
+	for (int32 Level = 0; Level < SignificanceLevels.Num(); ++Level)
+	{
+		if (Significance >= SignificanceLevels[Level].MinSignificance)
+		{
+			return Level;
+		}
+	}
+	return SignificanceLevels.Num() - 1;
+}
+
+void UTickSignificanceSubsystem::ApplyTickGroupBudgets(TArray<int32>& InOutLevels) const
+{
+	if (TickGroupBudgets.Num() == 0 || SignificanceLevels.Num() < 2)
+	{
+		return;
+	}
+
+	TArray<int32> SortedActors;
+	SortedActors.Reserve(ManagedActors.Num());
+	for (int32 Index = 0; Index < ManagedActors.Num(); ++Index)
+	{
+		if (InOutLevels[Index] == 0)
+		{
+			SortedActors.Add(Index);
+		}
+	}
+	SortedActors.Sort([this](int32 A, int32 B) { return ManagedActors[A].Significance > ManagedActors[B].Significance; });
+
+	int32 NumActorsInGroup[TG_MAX] = {};
+	for (const int32 Index : SortedActors)
+	{
+		const ETickingGroup TickGroup = ManagedActors[Index].Actor->PrimaryActorTick.TickGroup;
+		const FTickSignificanceBudget* Budget = TickGroupBudgets.FindByPredicate([TickGroup](const FTickSignificanceBudget& Item) { return Item.TickGroup == TickGroup; });
+		if (Budget && NumActorsInGroup[TickGroup]++ >= Budget->MaxActors)
+		{
+			InOutLevels[Index] = 1;
+		}
+	}
+}
+
+void UTickSignificanceSubsystem::ApplyLevel(FManagedActor& ManagedActor, int32 Level) const
+{
+	AActor* Actor = ManagedActor.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	static const FTickSignificanceLevel BaseRates;
+	const FTickSignificanceLevel& Rates = SignificanceLevels.IsValidIndex(Level) ? SignificanceLevels[Level] : BaseRates;
+	ManagedActor.Level = Level;
+
+	Actor->SetActorTickInterval(FMath::Max(ManagedActor.BaseTickInterval, Rates.TickInterval));
+
+	for (const FManagedComponent& ManagedComponent : ManagedActor.Components)
+	{
+		UActorComponent* Component = ManagedComponent.Component.Get();
+		USkinnedMeshComponent* SkinnedMesh = Cast<USkinnedMeshComponent>(Component);
+		if (SkinnedMesh && SkinnedMesh->bEnableUpdateRateOptimizations)
+		{
+			// Skinned meshes keep ticking, the update rate optimization skips the animation work instead
+			if (SkinnedMesh->AnimUpdateRateParams)
+			{
+				SkinnedMesh->AnimUpdateRateParams->SignificanceUpdateRate = FMath::Max(Rates.AnimUpdateRate, 1);
+			}
+		}
+		else if (Component)
+		{
+			Component->SetComponentTickInterval(FMath::Max(ManagedComponent.BaseTickInterval, Rates.TickInterval));
+		}
+	}
+
+	if (Actor->GetIsReplicated() && Actor->HasAuthority() && Actor->GetNetMode() != NM_Standalone)
+	{
+		// Don't go below MinNetUpdateFrequency, unless the actor was set up that way
+		const float MinNetUpdateFrequency = FMath::Min(ManagedActor.BaseNetUpdateFrequency, Actor->MinNetUpdateFrequency);
+		Actor->NetUpdateFrequency = FMath::Max(ManagedActor.BaseNetUpdateFrequency * Rates.NetUpdateFrequencyScale, MinNetUpdateFrequency);
+	}
+}
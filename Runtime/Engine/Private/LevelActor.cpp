@@ -309,6 +309,7 @@ AActor* UWorld::SpawnActor( UClass* Class, FTransform const* UserTransformPtr, c
 {
 	SCOPE_CYCLE_COUNTER(STAT_SpawnActorTime);
 	CSV_SCOPED_TIMING_STAT_EXCLUSIVE(ActorSpawning);
+	ensureNotInParallelTickBatch(TEXT("SpawnActor"));
 
 #if WITH_EDITORONLY_DATA
 	check( CurrentLevel ); 	
@@ -634,6 +635,7 @@ bool UWorld::DestroyActor( AActor* ThisActor, bool bNetForce, bool bShouldModify
 {
 	SCOPE_CYCLE_COUNTER(STAT_DestroyActor);
 	CSV_SCOPED_TIMING_STAT_EXCLUSIVE(ActorDestroying);
+	ensureNotInParallelTickBatch(TEXT("DestroyActor"));
 
 	check(ThisActor);
 	check(ThisActor->IsValidLowLevel());
@@ -24,6 +24,7 @@
 #include "RenderingThread.h"
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
 #include "GameFramework/Controller.h"
 #include "AI/NavigationSystemBase.h"
 #include "GameFramework/PlayerController.h"
@@ -778,7 +779,11 @@ void UWorld::ProcessLevelStreamingVolumes(FVector* OverrideViewLocation)
 void UWorld::RunTickGroup(ETickingGroup Group, bool bBlockTillComplete = true)
 {
 	check(TickGroup == Group); // this should already be at the correct value, but we want to make sure things are happening in the right order
-	FTickTaskManagerInterface::Get().RunTickGroup(Group, bBlockTillComplete);
+	{
+		// Overlaps of the components moved by the group are updated together once it completes, if p.BatchOverlapUpdates is enabled
+		FScopedOverlapUpdateBatch OverlapUpdateBatch(this);
+		FTickTaskManagerInterface::Get().RunTickGroup(Group, bBlockTillComplete);
+	}
 	TickGroup = ETickingGroup(TickGroup + 1); // new actors go into the next tick group because this one is already gone
 }
 
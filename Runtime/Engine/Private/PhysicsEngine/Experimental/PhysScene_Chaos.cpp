@@ -1660,6 +1660,68 @@ void FPhysScene_Chaos::KillVisualDebugger()
 
 }
 
+/** Queues the move of the component of a rigid particle to its new transform, along with any wake event, and clears the particle's events */
+static void AddPendingComponentTransform(FRigidParticlePhysicsProxy* Proxy, const FTransform& NewTransform, TArray<FPhysScenePendingComponentTransform_Chaos>& PendingTransforms)
+{
+	Chaos::TPBDRigidParticle<float, 3>* DirtyParticle = Proxy->GetParticle();
+	if(FBodyInstance* BodyInstance = FPhysicsUserData::Get<FBodyInstance>(DirtyParticle->UserData()))
+	{
+		if(BodyInstance->OwnerComponent.IsValid())
+		{
+			UPrimitiveComponent* OwnerComponent = BodyInstance->OwnerComponent.Get();
+			if(OwnerComponent != nullptr)
+			{
+				bool bPendingMove = false;
+				if(BodyInstance->InstanceBodyIndex == INDEX_NONE)
+				{
+					if(!NewTransform.EqualsNoScale(OwnerComponent->GetComponentTransform()))
+					{
+						bPendingMove = true;
+						const FVector MoveBy = NewTransform.GetLocation() - OwnerComponent->GetComponentTransform().GetLocation();
+						const FQuat NewRotation = NewTransform.GetRotation();
+						PendingTransforms.Add(FPhysScenePendingComponentTransform_Chaos(OwnerComponent,MoveBy,NewRotation,Proxy->GetWakeEvent()));
+					}
+				}
+
+				if(Proxy->GetWakeEvent() != Chaos::EWakeEventEntry::None && !bPendingMove)
+				{
+					PendingTransforms.Add(FPhysScenePendingComponentTransform_Chaos(OwnerComponent,Proxy->GetWakeEvent()));
+				}
+				Proxy->ClearEvents();
+			}
+		}
+	}
+}
+
+static void ApplyPendingComponentTransforms(const TArray<FPhysScenePendingComponentTransform_Chaos>& PendingTransforms)
+{
+	for (const FPhysScenePendingComponentTransform_Chaos& ComponentTransform : PendingTransforms)
+	{
+		if (ComponentTransform.OwningComp != nullptr)
+		{
+			AActor* OwnerPtr = ComponentTransform.OwningComp->GetOwner();
+
+			if (ComponentTransform.bHasValidTransform)
+			{
+				ComponentTransform.OwningComp->MoveComponent(ComponentTransform.NewTranslation, ComponentTransform.NewRotation, false, NULL, MOVECOMP_SkipPhysicsMove);
+			}
+
+			if (OwnerPtr != NULL && !OwnerPtr->IsPendingKill())
+			{
+				OwnerPtr->CheckStillInWorld();
+			}
+		}
+
+		if (ComponentTransform.OwningComp != nullptr)
+		{
+			if (ComponentTransform.WakeEvent != Chaos::EWakeEventEntry::None)
+			{
+				ComponentTransform.OwningComp->DispatchWakeEvents(ComponentTransform.WakeEvent == Chaos::EWakeEventEntry::Awake ? ESleepEvent::SET_Wakeup : ESleepEvent::SET_Sleep, NAME_None);
+			}
+		}
+	}
+}
+
 void FPhysScene_Chaos::OnSyncBodies(const int32 SolverSyncTimestamp, Chaos::FPBDRigidDirtyParticlesBufferAccessor& Accessor)
 {
 	using namespace Chaos;
@@ -1674,36 +1736,7 @@ void FPhysScene_Chaos::OnSyncBodies(const int32 SolverSyncTimestamp, Chaos::FPBD
 			if(Proxy->PullFromPhysicsState(SolverSyncTimestamp))
 			{
 				TPBDRigidParticle<float,3>* DirtyParticle = Proxy->GetParticle();
-
-				if(FBodyInstance* BodyInstance = FPhysicsUserData::Get<FBodyInstance>(DirtyParticle->UserData()))
-				{
-					if(BodyInstance->OwnerComponent.IsValid())
-					{
-						UPrimitiveComponent* OwnerComponent = BodyInstance->OwnerComponent.Get();
-						if(OwnerComponent != nullptr)
-						{
-							bool bPendingMove = false;
-							if(BodyInstance->InstanceBodyIndex == INDEX_NONE)
-							{
-								TRigidTransform<float,3> NewTransform(DirtyParticle->X(),DirtyParticle->R());
-
-								if(!NewTransform.EqualsNoScale(OwnerComponent->GetComponentTransform()))
-								{
-									bPendingMove = true;
-									const FVector MoveBy = NewTransform.GetLocation() - OwnerComponent->GetComponentTransform().GetLocation();
-									const FQuat NewRotation = NewTransform.GetRotation();
-									PendingTransforms.Add(FPhysScenePendingComponentTransform_Chaos(OwnerComponent,MoveBy,NewRotation,Proxy->GetWakeEvent()));
-								}
-							}
-
-							if(Proxy->GetWakeEvent() != Chaos::EWakeEventEntry::None && !bPendingMove)
-							{
-								PendingTransforms.Add(FPhysScenePendingComponentTransform_Chaos(OwnerComponent,Proxy->GetWakeEvent()));
-							}
-							Proxy->ClearEvents();
-						}
-					}
-				}
+				AddPendingComponentTransform(Proxy, TRigidTransform<float,3>(DirtyParticle->X(),DirtyParticle->R()), PendingTransforms);
 			}
 		}
 
@@ -1721,31 +1754,54 @@ void FPhysScene_Chaos::OnSyncBodies(const int32 SolverSyncTimestamp, Chaos::FPBD
 		}
 	}
 
-	for (const FPhysScenePendingComponentTransform_Chaos& ComponentTransform : PendingTransforms)
-	{
-		if (ComponentTransform.OwningComp != nullptr)
-		{
-			AActor* OwnerPtr = ComponentTransform.OwningComp->GetOwner();
+	ApplyPendingComponentTransforms(PendingTransforms);
+}
 
-			if (ComponentTransform.bHasValidTransform)
-			{
-				ComponentTransform.OwningComp->MoveComponent(ComponentTransform.NewTranslation, ComponentTransform.NewRotation, false, NULL, MOVECOMP_SkipPhysicsMove);
-			}
+void FPhysScene_Chaos::OnSyncBodiesAsync(const TArray<Chaos::FPullPhysicsData*>& CommittedData, const Chaos::FPullPhysicsData* NextData, const Chaos::FReal Alpha)
+{
+	using namespace Chaos;
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SyncBodiesAsync"), STAT_SyncBodiesAsyncEngine, STATGROUP_Physics);
 
-			if (OwnerPtr != NULL && !OwnerPtr->IsPendingKill())
+	// Particles end up in the state of the last committed step
+	FChaosScene::OnSyncBodiesAsync(CommittedData, NextData, Alpha);
+
+	// Components go to the committed state, or part of the way to the next results for particles still moving
+	TMap<FRigidParticlePhysicsProxy*, FTransform> ComponentTransforms;
+	for (const FPullPhysicsData* PullData : CommittedData)
+	{
+		for (const FDirtyRigidParticleData& RigidData : PullData->DirtyRigids)
+		{
+			FRigidParticlePhysicsProxy* Proxy = static_cast<FRigidParticlePhysicsProxy*>(RigidData.Proxy);
+			if (Proxy && Proxy->GetSyncTimestamp() <= PullData->ExternalTimestamp)
 			{
-				OwnerPtr->CheckStillInWorld();
+				const TPBDRigidParticle<float, 3>* Particle = Proxy->GetParticle();
+				ComponentTransforms.Add(Proxy, TRigidTransform<float, 3>(Particle->X(), Particle->R()));
 			}
 		}
+	}
 
-		if (ComponentTransform.OwningComp != nullptr)
+	if (NextData)
+	{
+		for (const FDirtyRigidParticleData& RigidData : NextData->DirtyRigids)
 		{
-			if (ComponentTransform.WakeEvent != Chaos::EWakeEventEntry::None)
+			FRigidParticlePhysicsProxy* Proxy = static_cast<FRigidParticlePhysicsProxy*>(RigidData.Proxy);
+			if (Proxy && Proxy->GetSyncTimestamp() <= NextData->ExternalTimestamp)
 			{
-				ComponentTransform.OwningComp->DispatchWakeEvents(ComponentTransform.WakeEvent == EWakeEventEntry::Awake ? ESleepEvent::SET_Wakeup : ESleepEvent::SET_Sleep, NAME_None);
+				const TPBDRigidParticle<float, 3>* Particle = Proxy->GetParticle();
+				const FVector InterpolatedX = FMath::Lerp(Particle->X(), RigidData.X, Alpha);
+				const FQuat InterpolatedR = FQuat::Slerp(Particle->R(), RigidData.R, Alpha);
+				ComponentTransforms.Add(Proxy, FTransform(InterpolatedR, InterpolatedX));
 			}
 		}
 	}
+
+	TArray<FPhysScenePendingComponentTransform_Chaos> PendingTransforms;
+	for (const TPair<FRigidParticlePhysicsProxy*, FTransform>& ComponentTransform : ComponentTransforms)
+	{
+		AddPendingComponentTransform(ComponentTransform.Key, ComponentTransform.Value, PendingTransforms);
+	}
+
+	ApplyPendingComponentTransforms(PendingTransforms);
 }
 
 FPhysicsConstraintHandle 
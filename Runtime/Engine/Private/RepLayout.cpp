@@ -592,6 +592,22 @@ static FORCEINLINE bool CompareNetSerializeStructWithObjectProperties(
 	const void* A,
 	const void* B);
 
+static FORCEINLINE bool CompareGeneratedStruct(
+	const FRepLayoutCmd&	Cmd,
+	const void* 			A,
+	const void* 			B)
+{
+	// Skips the reflected property walk of FStructProperty::Identical, falls back to it if the generated comparison can't handle the struct
+	UScriptStruct* Struct = CastFieldChecked<FStructProperty>(Cmd.Property)->Struct;
+	bool bIdentical = false;
+	if (Struct->GetCppStructOps()->IdenticalGeneratedProperties(A, B, 0, bIdentical))
+	{
+		return bIdentical;
+	}
+
+	return Cmd.Property->Identical(A, B);
+}
+
 template<typename T>
 bool CompareValue(const T * A, const T * B)
 {
@@ -679,6 +695,10 @@ static FORCEINLINE bool PropertiesAreIdenticalNative(
 			return CompareNetSerializeStructWithObjectProperties(NetSerializeLayouts.FindChecked(&Cmd), NetSerializeLayouts, 0, INDEX_NONE, A, B);
 
 		case ERepLayoutCmdType::Property:
+			if (EnumHasAnyFlags(Cmd.Flags, ERepLayoutCmdFlags::HasGeneratedPropertyOps))
+			{
+				return CompareGeneratedStruct(Cmd, A, B);
+			}
 			return Cmd.Property->Identical(A, B);
 
 		default: 
@@ -5073,6 +5093,12 @@ static uint32 AddPropertyCmd(
 		UScriptStruct* Struct = StructProp->Struct;
 		Cmd.Flags |= ERepLayoutCmdFlags::IsStruct;
 
+		// Native Identical functions take precedence, as in UScriptStruct::CompareScriptStruct
+		if ((Struct->StructFlags & (STRUCT_GeneratedPropertyOps | STRUCT_IdenticalNative)) == STRUCT_GeneratedPropertyOps)
+		{
+			Cmd.Flags |= ERepLayoutCmdFlags::HasGeneratedPropertyOps;
+		}
+
 		if (Struct->GetFName() == NAME_Vector)
 		{
 			Cmd.Type = ERepLayoutCmdType::PropertyVector;
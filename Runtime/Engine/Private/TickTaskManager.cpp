@@ -73,6 +73,26 @@ static TAutoConsoleVariable<int32> CVarAllowAsyncTickCleanup(
 	0,
 	TEXT("If true, ticks are cleaned up in a task thread."));
 
+static TAutoConsoleVariable<int32> CVarAllowParallelTickBatches(
+	TEXT("tick.AllowParallelTickBatches"),
+	1,
+	TEXT("If true, tick functions with bRunInParallelBatch are executed in ParallelFor batches per class and tick group."));
+
+static TAutoConsoleVariable<int32> CVarAllowTickBatchFunctions(
+	TEXT("tick.AllowTickBatchFunctions"),
+	1,
+	TEXT("If true, tick functions with an ExecuteTickBatchFunction are executed through it in batches per class and tick group."));
+
+static TAutoConsoleVariable<int32> CVarTickBatchMaxSize(
+	TEXT("tick.TickBatchMaxSize"),
+	1024,
+	TEXT("Maximum number of tick functions in a single tick batch, larger sets are split into several batches."));
+
+static TAutoConsoleVariable<int32> CVarTickBatchMinChunkSize(
+	TEXT("tick.TickBatchMinChunkSize"),
+	32,
+	TEXT("Minimum number of tick functions passed to a batched tick entry point by a single worker of a parallel tick batch."));
+
 static float GTimeguardThresholdMS = 0.0f;
 static FAutoConsoleVariableRef CVarLightweightTimeguardThresholdMS(
 	TEXT("tick.LightweightTimeguardThresholdMS"), 
@@ -289,6 +309,159 @@ public:
 };
 
 
+#if !UE_BUILD_SHIPPING
+/** Set on threads executing ticks of a parallel tick batch, used to validate game thread only operations */
+static thread_local bool GIsInParallelTickBatch = false;
+#endif
+
+bool IsInParallelTickBatch()
+{
+#if !UE_BUILD_SHIPPING
+	return GIsInParallelTickBatch;
+#else
+	return false;
+#endif
+}
+
+class FTickBatchTask;
+
+/** Tick functions sharing target class, tick groups and batching options, executed by a single task */
+struct FTickBatch
+{
+	/** Ticks to execute **/
+	TArray<FTickFunction*> TickFunctions;
+	/** tick context, here thread is desired execution thread of the batch task **/
+	FTickContext Context;
+	/** Task executing the batch, held until the start tick group is released **/
+	TGraphTask<FTickBatchTask>* Task = nullptr;
+	/** Batched entry point called instead of ExecuteTick of each function, if set **/
+	FTickFunction::FExecuteTickBatchFunction ExecuteTickBatchFunction = nullptr;
+	/** Whether ticks of the batch are spread over worker threads **/
+	bool bParallel = false;
+	/** Minimal number of ticks passed to ExecuteTickBatchFunction by a single worker **/
+	int32 MinChunkSize = 1;
+};
+
+/** Helper class define the task of ticking a tick batch **/
+class FTickBatchTask
+{
+	/** Batch to tick **/
+	FTickBatch&		Batch;
+	/** If true, log each tick **/
+	bool					bLogTick;
+
+	/** Executes ticks through the batched entry point, in chunks spread over worker threads for parallel batches */
+	void ExecuteBatchEntryPoint()
+	{
+		// delta times only depend on the tick functions' own data, gather them with the enabled ticks in contiguous arrays
+		TArray<FTickFunction*, TInlineAllocator<256>> EnabledTicks;
+		TArray<float, TInlineAllocator<256>> DeltaTimes;
+		EnabledTicks.Reserve(Batch.TickFunctions.Num());
+		DeltaTimes.Reserve(Batch.TickFunctions.Num());
+		for (FTickFunction* Target : Batch.TickFunctions)
+		{
+			if (bLogTick)
+			{
+				UE_LOG(LogTick, Log, TEXT("tick %s [%1d, %1d] %6llu batch %s"), Target->bHighPriority ? TEXT("*") : TEXT(" "), (int32)Target->GetActualTickGroup(), (int32)Target->GetActualEndTickGroup(), (uint64)GFrameCounter, *Target->DiagnosticMessage());
+			}
+			if (Target->IsTickFunctionEnabled())
+			{
+				EnabledTicks.Add(Target);
+				DeltaTimes.Add(Target->CalculateDeltaTime(Batch.Context));
+			}
+		}
+
+		const int32 NumTicks = EnabledTicks.Num();
+		if (NumTicks == 0)
+		{
+			return;
+		}
+
+		const int32 NumChunks = Batch.bParallel ? FMath::Clamp(NumTicks / Batch.MinChunkSize, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) : 1;
+		if (NumChunks == 1)
+		{
+#if !UE_BUILD_SHIPPING
+			TGuardValue<bool> BatchGuard(GIsInParallelTickBatch, Batch.bParallel);
+#endif
+			Batch.ExecuteTickBatchFunction(EnabledTicks, DeltaTimes, Batch.Context.TickType);
+			return;
+		}
+
+		const int32 ChunkSize = FMath::DivideAndRoundUp(NumTicks, NumChunks);
+		ParallelFor(NumChunks, [this, &EnabledTicks, &DeltaTimes, NumTicks, ChunkSize](int32 ChunkIndex)
+		{
+#if !UE_BUILD_SHIPPING
+			TGuardValue<bool> BatchGuard(GIsInParallelTickBatch, true);
+#endif
+			const int32 StartIndex = ChunkIndex * ChunkSize;
+			const int32 Count = FMath::Min(ChunkSize, NumTicks - StartIndex);
+			if (Count > 0)
+			{
+				Batch.ExecuteTickBatchFunction(MakeArrayView(EnabledTicks.GetData() + StartIndex, Count), MakeArrayView(DeltaTimes.GetData() + StartIndex, Count), Batch.Context.TickType);
+			}
+		});
+	}
+
+public:
+	/** Constructor
+		* @param InBatch - Tick functions to tick
+		* @param InbLogTick - if true, log each tick
+	**/
+	FORCEINLINE FTickBatchTask(FTickBatch& InBatch, bool InbLogTick)
+		: Batch(InBatch)
+		, bLogTick(InbLogTick)
+	{
+	}
+	static FORCEINLINE TStatId GetStatId()
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FTickBatchTask, STATGROUP_TaskGraphTasks);
+	}
+	/** return the thread for this task **/
+	FORCEINLINE ENamedThreads::Type GetDesiredThread()
+	{
+		return Batch.Context.Thread;
+	}
+	static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	/**
+		*	Execute all ticks of the batch.
+		*	Batched ticks must not extend MyCompletionGraphEvent, it's shared by the whole batch.
+		**/
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (Batch.ExecuteTickBatchFunction)
+		{
+			ExecuteBatchEntryPoint();
+			for (FTickFunction* Target : Batch.TickFunctions)
+			{
+				Target->InternalData->TaskPointer = nullptr;  // This is stale and a good time to clear it for safety
+			}
+			return;
+		}
+
+		check(Batch.bParallel);
+		ParallelFor(Batch.TickFunctions.Num(), [this, CurrentThread, &MyCompletionGraphEvent](int32 Index)
+		{
+			FTickFunction* Target = Batch.TickFunctions[Index];
+			if (bLogTick)
+			{
+				UE_LOG(LogTick, Log, TEXT("tick %s [%1d, %1d] %6llu batch %s"), Target->bHighPriority ? TEXT("*") : TEXT(" "), (int32)Target->GetActualTickGroup(), (int32)Target->GetActualEndTickGroup(), (uint64)GFrameCounter, *Target->DiagnosticMessage());
+			}
+			if (Target->IsTickFunctionEnabled())
+			{
+#if !UE_BUILD_SHIPPING
+				TGuardValue<bool> BatchGuard(GIsInParallelTickBatch, true);
+#endif
+				const ENamedThreads::Type TickThread = IsInGameThread() ? CurrentThread : ENamedThreads::AnyThread;
+				Target->ExecuteTick(Target->CalculateDeltaTime(Batch.Context), Batch.Context.TickType, TickThread, MyCompletionGraphEvent);
+			}
+			Target->InternalData->TaskPointer = nullptr;  // This is stale and a good time to clear it for safety
+		});
+	}
+};
+
 /**
  * Class that handles the actual tick tasks and starting and completing tick groups
  */
@@ -379,6 +552,57 @@ class FTickTaskSequencer
 	/** These are waited for at the end of the frame; they are not on the critical path, but they have to be done before we leave the frame. */
 	FGraphEventArray CleanupTasks;
 
+	/** Identifies ticks that can share a tick batch */
+	struct FTickBatchKey
+	{
+		UClass* Class;
+		UWorld* World;
+		FTickFunction::FExecuteTickBatchFunction ExecuteTickBatchFunction;
+		ETickingGroup StartTickGroup;
+		ETickingGroup EndTickGroup;
+		ETickParallelAccess Access;
+		bool bParallel;
+		bool bHighPriority;
+
+		bool operator==(const FTickBatchKey& Other) const
+		{
+			return Class == Other.Class && World == Other.World && ExecuteTickBatchFunction == Other.ExecuteTickBatchFunction
+				&& StartTickGroup == Other.StartTickGroup && EndTickGroup == Other.EndTickGroup
+				&& Access == Other.Access && bParallel == Other.bParallel && bHighPriority == Other.bHighPriority;
+		}
+
+		friend uint32 GetTypeHash(const FTickBatchKey& Key)
+		{
+			uint32 Hash = HashCombine(PointerHash(Key.Class), PointerHash(Key.World));
+			Hash = HashCombine(Hash, PointerHash((const void*)Key.ExecuteTickBatchFunction));
+			return HashCombine(Hash, uint32(Key.StartTickGroup) | (uint32(Key.EndTickGroup) << 8) | (uint32(Key.Access) << 16) | (uint32(Key.bParallel) << 24) | (uint32(Key.bHighPriority) << 25));
+		}
+	};
+
+	/** Tick batches of the current frame **/
+	TArray<TUniquePtr<FTickBatch>> TickBatches;
+
+	/** Batches still accepting ticks, a batch is closed when it's full or its start tick group is dispatched **/
+	TMap<FTickBatchKey, FTickBatch*> OpenTickBatches;
+
+	/** Held batch tasks for each start tick group **/
+	TArray<TGraphTask<FTickBatchTask>*> TickBatchTasks[TG_MAX];
+
+	/** Whether batch tasks of a tick group were already released this frame **/
+	bool bTickBatchesDispatched[TG_MAX];
+
+	/** Guards tick batches when ticks are queued concurrently **/
+	FCriticalSection TickBatchCritical;
+
+	/** If true, allow parallel tick batches **/
+	bool				bAllowParallelTickBatches;
+	/** If true, allow batches executed through batched tick entry points **/
+	bool				bAllowTickBatchFunctions;
+	/** Maximum number of ticks in a tick batch **/
+	int32				TickBatchMaxSize;
+	/** Minimal number of ticks passed to a batched tick entry point by a single worker **/
+	int32				TickBatchMinChunkSize;
+
 	/** we keep track of the last TG we have blocked for so when we do block, we know which TG's to wait for . */
 	ETickingGroup WaitForTickGroup;
 
@@ -450,6 +674,88 @@ public:
 		}
 
 		TickFunction->InternalData->TaskPointer = TGraphTask<FTickFunctionTask>::CreateTask(Prerequisites, TickContext.Thread).ConstructAndHold(TickFunction, &UseContext, bLogTicks, bLogTicksShowPrerequistes);
+		TickFunction->InternalData->bInTickBatch = false;
+	}
+
+	/** Whether a tick function can be executed by a tick batch, instead of a task of its own **/
+	FORCEINLINE bool CanQueueInTickBatch(const FGraphEventArray* Prerequisites, const FTickFunction* TickFunction) const
+	{
+		const ETickingGroup StartTickGroup = TickFunction->InternalData->ActualStartTickGroup;
+		return ((bAllowParallelTickBatches && TickFunction->bRunInParallelBatch) || (bAllowTickBatchFunctions && TickFunction->ExecuteTickBatchFunction))
+			&& (Prerequisites == nullptr || Prerequisites->Num() == 0)
+			&& StartTickGroup == TickFunction->TickGroup
+			&& StartTickGroup < TG_NewlySpawned
+			&& !bTickBatchesDispatched[StartTickGroup];
+	}
+
+	/**
+	 * Adds a tick function to the open tick batch of its class and tick groups, starting a new batch if needed
+	 *
+	 * @param	TickFunction - the tick function to queue
+	 * @param	Context - tick context to tick in. Thread here is the current thread.
+	 * @param	bConcurrentQueue - whether ticks are being queued from several threads
+	 * @return	false if the tick has to be queued as a regular task
+	 */
+	bool QueueTickTaskInBatch(FTickFunction* TickFunction, const FTickContext& TickContext, bool bConcurrentQueue)
+	{
+		UClass* BatchClass = TickFunction->GetTickBatchClass();
+		if (BatchClass == nullptr)
+		{
+			return false;
+		}
+
+		FTickBatchKey Key;
+		Key.Class = BatchClass;
+		Key.World = TickContext.World;
+		Key.ExecuteTickBatchFunction = bAllowTickBatchFunctions ? TickFunction->ExecuteTickBatchFunction : nullptr;
+		Key.bParallel = bAllowParallelTickBatches && TickFunction->bRunInParallelBatch;
+		Key.StartTickGroup = TickFunction->InternalData->ActualStartTickGroup;
+		Key.EndTickGroup = TickFunction->InternalData->ActualEndTickGroup;
+		Key.Access = TickFunction->ParallelTickAccess;
+		Key.bHighPriority = TickFunction->bHighPriority;
+
+		FScopeLock Lock(&TickBatchCritical);
+		if (bTickBatchesDispatched[Key.StartTickGroup])
+		{
+			return false;
+		}
+
+		FTickBatch*& Batch = OpenTickBatches.FindOrAdd(Key);
+		if (Batch == nullptr || Batch->TickFunctions.Num() >= TickBatchMaxSize)
+		{
+			Batch = TickBatches.Add_GetRef(MakeUnique<FTickBatch>()).Get();
+			Batch->Context = TickContext;
+			Batch->ExecuteTickBatchFunction = Key.ExecuteTickBatchFunction;
+			Batch->bParallel = Key.bParallel;
+			Batch->MinChunkSize = TickBatchMinChunkSize;
+
+			// batches reading external state run while the game thread waits for them, otherwise they run alongside game thread ticks.
+			// Batches that are not parallel are regular game thread ticks called through a single entry point.
+			if (Key.bParallel && Key.Access == ETickParallelAccess::TargetOnly && bAllowConcurrentTicks)
+			{
+				Batch->Context.Thread = Key.bHighPriority ? CPrio_HiPriAsyncTickTaskPriority.Get() : CPrio_NormalAsyncTickTaskPriority.Get();
+			}
+			else
+			{
+				Batch->Context.Thread = ENamedThreads::SetTaskPriority(ENamedThreads::GameThread, Key.bHighPriority ? ENamedThreads::HighTaskPriority : ENamedThreads::NormalTaskPriority);
+			}
+
+			Batch->Task = TGraphTask<FTickBatchTask>::CreateTask(nullptr, TickContext.Thread).ConstructAndHold(*Batch, bLogTicks);
+			TickBatchTasks[Key.StartTickGroup].Add(Batch->Task);
+			if (bConcurrentQueue)
+			{
+				TickCompletionEvents[Key.EndTickGroup].AddThreadsafe(Batch->Task->GetCompletionEvent());
+			}
+			else
+			{
+				new (TickCompletionEvents[Key.EndTickGroup]) FGraphEventRef(Batch->Task->GetCompletionEvent());
+			}
+		}
+
+		Batch->TickFunctions.Add(TickFunction);
+		TickFunction->InternalData->TaskPointer = Batch->Task;
+		TickFunction->InternalData->bInTickBatch = true;
+		return true;
 	}
 
 	/** Add a completion handle to a tick group **/
@@ -504,6 +810,10 @@ public:
 	{
 		checkSlow(TickFunction->InternalData);
 		checkSlow(TickContext.Thread == ENamedThreads::GameThread);
+		if (CanQueueInTickBatch(Prerequisites, TickFunction) && QueueTickTaskInBatch(TickFunction, TickContext, false))
+		{
+			return;
+		}
 		StartTickTask(Prerequisites, TickFunction, TickContext);
 		TGraphTask<FTickFunctionTask>* Task = (TGraphTask<FTickFunctionTask>*)TickFunction->InternalData->TaskPointer;
 		AddTickTaskCompletion(TickFunction->InternalData->ActualStartTickGroup, TickFunction->InternalData->ActualEndTickGroup, Task, TickFunction->bHighPriority);
@@ -520,6 +830,10 @@ public:
 	{
 		checkSlow(TickFunction->InternalData);
 		checkSlow(TickContext.Thread == ENamedThreads::GameThread);
+		if (CanQueueInTickBatch(Prerequisites, TickFunction) && QueueTickTaskInBatch(TickFunction, TickContext, true))
+		{
+			return;
+		}
 		StartTickTask(Prerequisites, TickFunction, TickContext);
 		TGraphTask<FTickFunctionTask>* Task = (TGraphTask<FTickFunctionTask>*)TickFunction->InternalData->TaskPointer;
 		AddTickTaskCompletionParallel(TickFunction->InternalData->ActualStartTickGroup, TickFunction->InternalData->ActualEndTickGroup, Task, TickFunction->bHighPriority);
@@ -604,8 +918,18 @@ public:
 			bAllowConcurrentTicks = !!CVarAllowAsyncComponentTicks.GetValueOnGameThread();
 		}
 
+		// batches spread their ticks with ParallelFor, which is also worth it in single threaded mode (e.g. dedicated servers)
+		bAllowParallelTickBatches = !!CVarAllowParallelTickBatches.GetValueOnGameThread();
+		bAllowTickBatchFunctions = !!CVarAllowTickBatchFunctions.GetValueOnGameThread();
+		TickBatchMaxSize = FMath::Max(1, CVarTickBatchMaxSize.GetValueOnGameThread());
+		TickBatchMinChunkSize = FMath::Max(1, CVarTickBatchMinChunkSize.GetValueOnGameThread());
+
 		WaitForCleanup();
 
+		// all batch tasks of the previous frame were completed with their tick groups
+		TickBatches.Reset();
+		OpenTickBatches.Reset();
+
 		for (int32 Index = 0; Index < TG_MAX; Index++)
 		{
 			check(!TickCompletionEvents[Index].Num());  // we should not be adding to these outside of a ticking proper and they were already cleared after they were ticked
@@ -616,6 +940,8 @@ public:
 				TickTasks[Index][IndexInner].Reset();
 				HiPriTickTasks[Index][IndexInner].Reset();
 			}
+			check(!TickBatchTasks[Index].Num());
+			bTickBatchesDispatched[Index] = false;
 		}
 		WaitForTickGroup = (ETickingGroup)0;
 	}
@@ -632,10 +958,16 @@ public:
 private:
 
 	FTickTaskSequencer()
-		: bAllowConcurrentTicks(false)
+		: bAllowParallelTickBatches(false)
+		, bAllowTickBatchFunctions(false)
+		, TickBatchMaxSize(1)
+		, TickBatchMinChunkSize(1)
+		, bAllowConcurrentTicks(false)
 		, bLogTicks(false)
 		, bLogTicksShowPrerequistes(false)
 	{
+		FMemory::Memzero(bTickBatchesDispatched);
+
 		TFunction<void()> ShutdownCallback([this](){WaitForCleanup();});
 		FTaskGraphInterface::Get().AddShutdownCallback(ShutdownCallback);
 	}
@@ -682,6 +1014,23 @@ private:
 			}
 			TickArray.Reset();
 		}
+		{
+			// close batches of this tick group, ticks queued from now on get tasks of their own
+			FScopeLock Lock(&TickBatchCritical);
+			bTickBatchesDispatched[WorldTickGroup] = true;
+			for (TMap<FTickBatchKey, FTickBatch*>::TIterator It(OpenTickBatches); It; ++It)
+			{
+				if (It.Key().StartTickGroup == WorldTickGroup)
+				{
+					It.RemoveCurrent();
+				}
+			}
+			for (TGraphTask<FTickBatchTask>* BatchTask : TickBatchTasks[WorldTickGroup])
+			{
+				BatchTask->Unlock(CurrentThread);
+			}
+			TickBatchTasks[WorldTickGroup].Reset();
+		}
 		for (int32 IndexInner = 0; IndexInner < TG_MAX; IndexInner++)
 		{
 			TArray<TGraphTask<FTickFunctionTask>*>& TickArray = TickTasks[WorldTickGroup][IndexInner];
@@ -1802,6 +2151,9 @@ FTickFunction::FTickFunction()
 	, bAllowTickOnDedicatedServer(true)
 	, bHighPriority(false)
 	, bRunOnAnyThread(false)
+	, bRunInParallelBatch(false)
+	, ParallelTickAccess(ETickParallelAccess::TargetOnly)
+	, ExecuteTickBatchFunction(nullptr)
 	, TickState(ETickState::Enabled)
 	, TickInterval(0.f)
 {
@@ -1810,6 +2162,7 @@ FTickFunction::FTickFunction()
 FTickFunction::FInternalData::FInternalData()
 	: bRegistered(false)
 	, bWasInterval(false)
+	, bInTickBatch(false)
 	, ActualStartTickGroup(TG_PrePhysics)
 	, ActualEndTickGroup(TG_PrePhysics)
 	, TickVisitedGFrameCounter(0)
@@ -1835,6 +2188,8 @@ FTickFunction::~FTickFunction()
 **/
 void FTickFunction::RegisterTickFunction(ULevel* Level)
 {
+	ensureNotInParallelTickBatch(TEXT("RegisterTickFunction"));
+
 	if (!IsTickFunctionRegistered())
 	{
 		// Only allow registration of tick if we are are allowed on dedicated server, or we are not a dedicated server
@@ -1858,6 +2213,8 @@ void FTickFunction::RegisterTickFunction(ULevel* Level)
 /** Removes the tick function from the master list of tick functions. **/
 void FTickFunction::UnRegisterTickFunction()
 {
+	ensureNotInParallelTickBatch(TEXT("UnRegisterTickFunction"));
+
 	if (IsTickFunctionRegistered())
 	{
 		FTickTaskManager::Get().RemoveTickFunction(this);
@@ -1868,6 +2225,8 @@ void FTickFunction::UnRegisterTickFunction()
 /** Enables or disables this tick function. **/
 void FTickFunction::SetTickFunctionEnable(bool bInEnabled)
 {
+	ensureNotInParallelTickBatch(TEXT("SetTickFunctionEnable"));
+
 	if (IsTickFunctionRegistered())
 	{
 		if (bInEnabled == (TickState == ETickState::Disabled))
@@ -1910,6 +2269,8 @@ void FTickFunction::UpdateTickIntervalAndCoolDown(float NewTickInterval)
 
 void FTickFunction::AddPrerequisite(UObject* TargetObject, struct FTickFunction& TargetTickFunction)
 {
+	ensureNotInParallelTickBatch(TEXT("AddPrerequisite"));
+
 	const bool bThisCanTick = (bCanEverTick || IsTickFunctionRegistered());
 	const bool bTargetCanTick = (TargetTickFunction.bCanEverTick || TargetTickFunction.IsTickFunctionRegistered());
 
@@ -1954,6 +2315,10 @@ void FTickFunction::ShowPrerequistes(int32 Indent)
 FGraphEventRef FTickFunction::GetCompletionHandle() const
 {
 	check(InternalData->TaskPointer);
+	if (InternalData->bInTickBatch)
+	{
+		return ((TGraphTask<FTickBatchTask>*)InternalData->TaskPointer)->GetCompletionEvent();
+	}
 	TGraphTask<FTickFunctionTask>* Task = (TGraphTask<FTickFunctionTask>*)InternalData->TaskPointer;
 	return Task->GetCompletionEvent();
 }
@@ -241,6 +241,7 @@ UnrealEngine.cpp: Implements the UEngine class and helpers.
 #include "StudioAnalytics.h"
 #include "TraceFilter.h"
 #include "Animation/SkinWeightProfileManager.h"
+#include "Animation/AnimPoseCache.h"
 
 DEFINE_LOG_CATEGORY(LogEngine);
 IMPLEMENT_MODULE( FEngineModule, Engine );
@@ -287,6 +288,8 @@ void FEngineModule::StartupModule()
 #endif
 
 	FSkinWeightProfileManager::OnStartup();
+
+	FAnimPoseCache::OnStartup();
 }
 
 void FEngineModule::ShutdownModule()
@@ -302,6 +305,8 @@ void FEngineModule::ShutdownModule()
 	FParticleSystemWorldManager::OnShutdown();
 
 	FSkinWeightProfileManager::OnShutdown();
+
+	FAnimPoseCache::OnShutdown();
 }
 
 /* Global variables
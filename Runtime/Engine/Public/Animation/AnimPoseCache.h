@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneIndices.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Atomic.h"
+
+class UAnimSequence;
+struct FAnimExtractContext;
+struct FAnimationPoseData;
+struct FBoneContainer;
+
+/**
+ * Bounded cache of the poses and curves decompressed from anim sequences, shared by all the components evaluated in a frame.
+ *
+ * Poses are keyed by sequence, sample time quantized to a.AnimPoseCache.TimeQuantum and a hash of the required bones, so crowds
+ * playing the same loop decompress each quantized time once. Requests of a cached key are sampled at the quantized time even when
+ * they miss, so the result doesn't depend on which component comes first. At the end of each frame, the poses that weren't used
+ * during the frame are evicted. The whole cache is flushed before garbage collection, as keys use the address of the sequence.
+ *
+ * Evaluation batches of components using the same skeletal mesh and anim graph open an FBatchScope, which enables the cache on
+ * their thread even when a.AnimPoseCache.Enable is off. Poses are then keyed by their exact sample time, so sharing them
+ * doesn't change the result of the evaluation.
+ *
+ * Lookups and insertions are thread safe.
+ */
+class ENGINE_API FAnimPoseCache
+{
+public:
+	struct FKey
+	{
+		const UAnimSequence* Sequence = nullptr;
+		int32 TimeIndex = 0;
+		uint32 RequiredBonesHash = 0;
+		bool bExtractRootMotion = false;
+		/** TimeIndex holds the bits of the exact sample time rather than a multiple of the time quantum */
+		bool bExactTime = false;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Sequence == Other.Sequence && TimeIndex == Other.TimeIndex && RequiredBonesHash == Other.RequiredBonesHash
+				&& bExtractRootMotion == Other.bExtractRootMotion && bExactTime == Other.bExactTime;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			uint32 Hash = HashCombine(::GetTypeHash(Key.Sequence), ::GetTypeHash(Key.TimeIndex));
+			return HashCombine(Hash, Key.RequiredBonesHash ^ (Key.bExtractRootMotion ? 1u : 0u) ^ (Key.bExactTime ? 2u : 0u));
+		}
+	};
+
+	/** Enables the cache with exact sample times on this thread while alive, can be nested */
+	class ENGINE_API FBatchScope
+	{
+	public:
+		FBatchScope();
+		~FBatchScope();
+	};
+
+	static FAnimPoseCache& Get();
+
+	/** Registers the end of frame eviction and the flush before garbage collection, called on the game thread at engine module startup */
+	static void OnStartup();
+	static void OnShutdown();
+
+	/**
+	 * Whether poses are cached on this thread, set by a.AnimPoseCache.Enable or an FBatchScope.
+	 * Disabled in the editor, where sequences are recompressed in place, and outside of OnStartup / OnShutdown.
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Builds the key of the pose of the sequence for the extraction context and required bones.
+	 * @param OutSampleTime The quantized time the pose has to be sampled at
+	 * @return false if the extraction can't be cached
+	 */
+	bool MakeKey(const UAnimSequence* Sequence, const FAnimExtractContext& ExtractionContext, const FBoneContainer& RequiredBones, FKey& OutKey, float& OutSampleTime) const;
+
+	/**
+	 * Copies the bones and curves of the cached pose of the key.
+	 * @return true if a pose was found
+	 */
+	bool FindPose(const FKey& Key, FAnimationPoseData& OutAnimationPoseData);
+
+	/** Caches the bones and curves of the pose of the key, unless the cache is full */
+	void AddPose(const FKey& Key, const FAnimationPoseData& AnimationPoseData);
+
+	/** Removes the poses which weren't used since the last call */
+	void EndFrame();
+
+	/** Removes all the poses */
+	void Flush();
+
+	/** Logs the hit rate and size of the cache */
+	void DumpStats() const;
+
+private:
+	FAnimPoseCache();
+
+	struct FEntry
+	{
+		/** Used to detect hash collisions of the required bones */
+		TArray<FBoneIndexType> BoneIndices;
+		/** Curves are copied by array index, the table depends on the curve evaluation options of the component and not only on the asset */
+		TArray<uint16> CurveUIDToArrayIndexLUT;
+		TArray<FTransform> Bones;
+		TArray<float> CurveWeights;
+		TBitArray<> ValidCurveWeights;
+		TAtomic<bool> bUsedThisFrame;
+	};
+
+	static uint32 HashRequiredBones(const FBoneContainer& RequiredBones);
+
+	mutable FRWLock Lock;
+	TMap<FKey, TUniquePtr<FEntry>> Entries;
+
+	FThreadSafeCounter FrameHits;
+	FThreadSafeCounter FrameMisses;
+	FThreadSafeCounter FrameRejected;
+	uint64 TotalHits;
+	uint64 TotalMisses;
+	uint64 TotalEvictions;
+};
@@ -796,7 +796,8 @@ enum class ERepLayoutCmdFlags : uint8
 {
 	None					= 0,		//! No flags.
 	IsSharedSerialization	= (1 << 0),	//! Indicates the property is eligible for shared serialization.
-	IsStruct				= (1 << 1)	//! This is a struct property.
+	IsStruct				= (1 << 1),	//! This is a struct property.
+	HasGeneratedPropertyOps	= (1 << 2)	//! This is a struct property compared with its compile time generated property operations.
 };
 
 ENUM_CLASS_FLAGS(ERepLayoutCmdFlags)
@@ -262,6 +262,7 @@ private:
 
 #if WITH_CHAOS
 	virtual void OnSyncBodies(const int32 SolverSyncTimestamp, Chaos::FPBDRigidDirtyParticlesBufferAccessor& Accessor) override;
+	virtual void OnSyncBodiesAsync(const TArray<Chaos::FPullPhysicsData*>& CommittedData, const Chaos::FPullPhysicsData* NextData, const Chaos::FReal Alpha) override;
 #endif
 
 #if 0
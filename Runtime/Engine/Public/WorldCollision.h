@@ -226,6 +226,62 @@ struct FOverlapDatum : FBaseTraceDatum
 	}
 };
 
+/** Input of a line trace or sweep run by UWorld::BatchLineTraceByChannel or UWorld::BatchSweepByChannel */
+struct FBatchTraceRequest
+{
+	FVector Start;
+	FVector End;
+	/** Rotation of the swept shape, ignored by line traces */
+	FQuat	Rot;
+
+	FBatchTraceRequest(const FVector& InStart, const FVector& InEnd, const FQuat& InRot = FQuat::Identity)
+		: Start(InStart)
+		, End(InEnd)
+		, Rot(InRot)
+	{
+	}
+};
+
+/** Input of an overlap test run by UWorld::BatchOverlapByChannel */
+struct FBatchOverlapRequest
+{
+	FVector Pos;
+	FQuat	Rot;
+
+	FBatchOverlapRequest(const FVector& InPos, const FQuat& InRot = FQuat::Identity)
+		: Pos(InPos)
+		, Rot(InRot)
+	{
+	}
+};
+
+/**
+ * Output of a batched scene query
+ *
+ * The results of all queries are stored contiguously in request order, each query owning a range of Results.
+ */
+template <typename ResultType>
+struct TBatchSceneQueryResults
+{
+	/** Results of all the queries */
+	TArray<ResultType> Results;
+
+	/** Index of the first result of each query in Results */
+	TArray<int32> FirstResult;
+
+	/** Number of results of each query */
+	TArray<int32> NumResults;
+
+	/** Returns the results of one query */
+	TArrayView<const ResultType> GetResults(int32 RequestIndex) const
+	{
+		return TArrayView<const ResultType>(Results.GetData() + FirstResult[RequestIndex], NumResults[RequestIndex]);
+	}
+};
+
+typedef TBatchSceneQueryResults<struct FHitResult> FBatchTraceResults;
+typedef TBatchSceneQueryResults<struct FOverlapResult> FBatchOverlapResults;
+
 #define ASYNC_TRACE_BUFFER_SIZE 64
 
 /**
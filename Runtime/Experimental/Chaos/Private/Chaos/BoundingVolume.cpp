@@ -2,6 +2,7 @@
 
 #include "Chaos/BoundingVolume.h"
 #include "Chaos/AABBTree.h"
+#include "Chaos/DynamicAABBTree.h"
 #include "UObject/ExternalPhysicsCustomObjectVersion.h"
 
 int FBoundingVolumeCVars::FilterFarBodies = 0;
@@ -36,6 +37,10 @@ namespace Chaos
 		case ESpatialAcceleration::BoundingVolume: return Ar.IsLoading() ? new TBoundingVolume<TPayloadType, T, d>() : nullptr;
 		case ESpatialAcceleration::AABBTree: return Ar.IsLoading() ? new TAABBTree<TPayloadType, TAABBTreeLeafArray<TPayloadType, T>, T>() : nullptr;
 		case ESpatialAcceleration::AABBTreeBV: return Ar.IsLoading() ? new TAABBTree<TPayloadType, TBoundingVolume<TPayloadType, T, 3>, T>() : nullptr;
+		case ESpatialAcceleration::DynamicAABBTree:
+			//this value used to be the first custom type
+			check(!Ar.IsLoading() || Ar.CustomVer(FExternalPhysicsCustomObjectVersion::GUID) >= FExternalPhysicsCustomObjectVersion::DynamicAABBTreeAcceleration);
+			return Ar.IsLoading() ? new TDynamicAABBTree<TPayloadType, T>() : nullptr;
 		case ESpatialAcceleration::Collection: check(false);	//Collections must be serialized directly since they are variadic
 		default: check(false); return nullptr;
 		}
@@ -15,6 +15,9 @@ FChaosMarshallingManager::FChaosMarshallingManager()
 , InternalTimestamp(-1)
 , ProducerData(nullptr)
 , Delay(SimDelay)
+, ProducerPullData(nullptr)
+, NextPullData(nullptr)
+, CommittedPullTime(0)
 {
 	PrepareExternalQueue();
 }
@@ -105,6 +108,134 @@ void FChaosMarshallingManager::FreeCallbackData_Internal(FSimCallbackHandlePT* C
 	}
 }
 
+FPullPhysicsData* FChaosMarshallingManager::GetProducerPullData_Internal()
+{
+	if(ProducerPullData == nullptr)
+	{
+		if(!PullDataPool.Dequeue(ProducerPullData))
+		{
+			PullBackingBuffer.Add(MakeUnique<FPullPhysicsData>());
+			ProducerPullData = PullBackingBuffer.Last().Get();
+		}
+	}
+
+	return ProducerPullData;
+}
+
+void FChaosMarshallingManager::FinalizePullData_Internal(FReal ExternalEndTime, int32 ExternalTimestamp)
+{
+	//steps without results still need to be handed over so that the external thread knows time has passed
+	FPullPhysicsData* PullData = GetProducerPullData_Internal();
+	PullData->ExternalEndTime = ExternalEndTime;
+	PullData->ExternalTimestamp = ExternalTimestamp;
+	PullDataQueue.Enqueue(PullData);
+	ProducerPullData = nullptr;
+}
+
+void FChaosMarshallingManager::GatherPullData_External(FReal ResultsTime, TArray<FPullPhysicsData*>& OutCommittedData, const FPullPhysicsData*& OutNextData, FReal& OutAlpha)
+{
+	OutNextData = nullptr;
+	OutAlpha = 1;
+
+	while(true)
+	{
+		if(NextPullData == nullptr)
+		{
+			if(!PullDataQueue.Dequeue(NextPullData))
+			{
+				break;
+			}
+
+			FilterRemovedProxies_External(*NextPullData);
+		}
+
+		if(NextPullData->ExternalEndTime > ResultsTime)
+		{
+			const FReal StepTime = NextPullData->ExternalEndTime - CommittedPullTime;
+			OutNextData = NextPullData;
+			OutAlpha = StepTime > 0 ? FMath::Clamp((ResultsTime - CommittedPullTime) / StepTime, (FReal)0, (FReal)1) : (FReal)1;
+			break;
+		}
+
+		CommittedPullTime = NextPullData->ExternalEndTime;
+		OutCommittedData.Add(NextPullData);
+		NextPullData = nullptr;
+	}
+
+	if(RemovedPullProxies.Num() && OutCommittedData.Num())
+	{
+		//once a step that ran after the removal has been committed no older results are left
+		const int32 CommittedTimestamp = OutCommittedData.Last()->ExternalTimestamp;
+		for(TMap<IPhysicsProxyBase*, int32>::TIterator It = RemovedPullProxies.CreateIterator(); It; ++It)
+		{
+			if(It.Value() <= CommittedTimestamp)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+void FChaosMarshallingManager::FreePullData_External(FPullPhysicsData* PullData)
+{
+	PullData->Reset();
+	PullDataPool.Enqueue(PullData);
+}
+
+void FChaosMarshallingManager::FreeAllPullData_External()
+{
+	if(NextPullData)
+	{
+		FreePullData_External(NextPullData);
+		NextPullData = nullptr;
+	}
+
+	FPullPhysicsData* PullData;
+	while(PullDataQueue.Dequeue(PullData))
+	{
+		FreePullData_External(PullData);
+	}
+
+	CommittedPullTime = SimTime;
+	RemovedPullProxies.Reset();
+}
+
+void FChaosMarshallingManager::RemoveProxyFromPullData_External(IPhysicsProxyBase* Proxy)
+{
+	//the proxy is deleted by the internal step that consumes the current timestamp, older steps may still be in flight
+	RemovedPullProxies.Add(Proxy, ExternalTimestamp);
+
+	if(NextPullData)
+	{
+		FilterRemovedProxies_External(*NextPullData);
+	}
+}
+
+void FChaosMarshallingManager::FilterRemovedProxies_External(FPullPhysicsData& PullData)
+{
+	if(RemovedPullProxies.Num() == 0)
+	{
+		return;
+	}
+
+	for(FDirtyRigidParticleData& RigidData : PullData.DirtyRigids)
+	{
+		if(const int32* RemovedTimestamp = RemovedPullProxies.Find(RigidData.Proxy))
+		{
+			//results of steps after the removal can only refer to a new proxy at the same address
+			if(PullData.ExternalTimestamp < *RemovedTimestamp)
+			{
+				RigidData.Proxy = nullptr;
+			}
+		}
+	}
+}
+
+void FPullPhysicsData::Reset()
+{
+	DirtyRigids.Reset();
+}
+
 void FPushPhysicsData::Reset()
 {
 	DirtyProxiesDataBuffer.Reset();
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#include "Chaos/Collision/CollisionManifoldCache.h"
+#include "Chaos/ParticleHandle.h"
+#include "HAL/IConsoleManager.h"
+
+namespace Chaos
+{
+	bool bChaos_Manifold_Persistent = true;
+	FAutoConsoleVariableRef CVarChaos_Manifold_Persistent(TEXT("p.Chaos.Collision.Manifold.Persistent"), bChaos_Manifold_Persistent, TEXT("Whether to reuse the one-shot manifolds of the previous frame for pairs of shapes that have barely moved relative to each other"));
+
+	float Chaos_Manifold_PersistentPositionTolerance = 0.5f;	// cm
+	float Chaos_Manifold_PersistentRotationTolerance = 0.01f;	// radians
+	FAutoConsoleVariableRef CVarChaos_Manifold_PersistentPositionTolerance(TEXT("p.Chaos.Collision.Manifold.PersistentPositionTolerance"), Chaos_Manifold_PersistentPositionTolerance, TEXT("How far the shapes of a pair can move relative to each other before their manifold has to be rebuilt"));
+	FAutoConsoleVariableRef CVarChaos_Manifold_PersistentRotationTolerance(TEXT("p.Chaos.Collision.Manifold.PersistentRotationTolerance"), Chaos_Manifold_PersistentRotationTolerance, TEXT("How far (in radians) the shapes of a pair can rotate relative to each other before their manifold has to be rebuilt"));
+
+	bool bChaos_Manifold_WarmStart = true;
+	FAutoConsoleVariableRef CVarChaos_Manifold_WarmStart(TEXT("p.Chaos.Collision.Manifold.WarmStart"), bChaos_Manifold_WarmStart, TEXT("Whether restored manifolds apply the impulses of the previous frame before the velocity solve"));
+
+	void FCollisionManifoldCache::Reset()
+	{
+		Entries.Reset();
+		Manifolds.Reset();
+		ManifoldPoints.Reset();
+	}
+
+	FCollisionManifoldCache::FKey FCollisionManifoldCache::MakeKey(const FRigidBodyPointContactConstraint& Constraint)
+	{
+		FKey Key;
+		Key.ParticleIdx[0] = Constraint.Particle[0]->UniqueIdx();
+		Key.ParticleIdx[1] = Constraint.Particle[1]->UniqueIdx();
+		Key.Implicit[0] = Constraint.Manifold.Implicit[0];
+		Key.Implicit[1] = Constraint.Manifold.Implicit[1];
+		return Key;
+	}
+
+	void FCollisionManifoldCache::Capture(const TArray<FRigidBodyPointContactConstraint>& Constraints)
+	{
+		Reset();
+
+		if (!bChaos_Manifold_Persistent)
+		{
+			return;
+		}
+
+		for (const FRigidBodyPointContactConstraint& Constraint : Constraints)
+		{
+			TArrayView<const FManifoldPoint> ConstraintPoints = Constraint.GetManifoldPoints();
+			if (!Constraint.UseOneShotManifold() || !Constraint.HasManifoldRelativeTransform() || Constraint.GetDisabled() || (ConstraintPoints.Num() == 0))
+			{
+				continue;
+			}
+
+			const FKey Key = MakeKey(Constraint);
+			if (Entries.Contains(Key))
+			{
+				continue;
+			}
+
+			FEntry& Entry = Manifolds.AddDefaulted_GetRef();
+			Entry.RelativeTransform = Constraint.GetManifoldRelativeTransform();
+			Entry.FirstPoint = ManifoldPoints.Num();
+			Entry.NumPoints = ConstraintPoints.Num();
+			ManifoldPoints.Append(ConstraintPoints.GetData(), ConstraintPoints.Num());
+			Entries.Add(Key, Manifolds.Num() - 1);
+		}
+	}
+
+	bool FCollisionManifoldCache::Restore(FRigidBodyPointContactConstraint& Constraint, const FRigidTransform3& WorldTransform0, const FRigidTransform3& WorldTransform1) const
+	{
+		if (!bChaos_Manifold_Persistent || !Constraint.UseOneShotManifold() || (Entries.Num() == 0))
+		{
+			return false;
+		}
+
+		const int32* ManifoldIndex = Entries.Find(MakeKey(Constraint));
+		if (ManifoldIndex == nullptr)
+		{
+			return false;
+		}
+
+		const FEntry& Entry = Manifolds[*ManifoldIndex];
+		const FRigidTransform3 RelativeTransform = WorldTransform1.GetRelativeTransform(WorldTransform0);
+		const FReal PositionDeltaSq = (RelativeTransform.GetTranslation() - Entry.RelativeTransform.GetTranslation()).SizeSquared();
+		if (PositionDeltaSq > FMath::Square(Chaos_Manifold_PersistentPositionTolerance))
+		{
+			return false;
+		}
+		if (RelativeTransform.GetRotation().AngularDistance(Entry.RelativeTransform.GetRotation()) > Chaos_Manifold_PersistentRotationTolerance)
+		{
+			return false;
+		}
+
+		// Keep the transform the manifold was built with so that small motions do not accumulate over frames
+		Constraint.RestoreOneShotManifold(MakeArrayView(&ManifoldPoints[Entry.FirstPoint], Entry.NumPoints), Entry.RelativeTransform, bChaos_Manifold_WarmStart);
+		return true;
+	}
+
+	void FCollisionManifoldCache::RemoveParticles(const TSet<TGeometryParticleHandle<FReal, 3>*>& ParticleHandles)
+	{
+		if (Entries.Num() == 0)
+		{
+			return;
+		}
+
+		TSet<int32> RemovedIndices;
+		for (const TGeometryParticleHandle<FReal, 3>* ParticleHandle : ParticleHandles)
+		{
+			RemovedIndices.Add(ParticleHandle->UniqueIdx().Idx);
+		}
+
+		// Points of the removed manifolds stay in the array until the next capture
+		for (TMap<FKey, int32>::TIterator It = Entries.CreateIterator(); It; ++It)
+		{
+			if (RemovedIndices.Contains(It.Key().ParticleIdx[0].Idx) || RemovedIndices.Contains(It.Key().ParticleIdx[1].Idx))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
@@ -493,6 +493,56 @@ namespace Chaos
 		}
 
 
+		// Apply the net impulses that a manifold restored from the previous frame carried over (see FCollisionManifoldCache),
+		// so that the velocity iterations only have to solve for the change in the contact impulses.
+		void ApplyManifoldWarmStart(
+			FRigidBodyPointContactConstraint& Constraint,
+			const FReal InvM0,
+			const FMatrix33& InvI0,
+			const FReal InvM1,
+			const FMatrix33& InvI1,
+			const FVec3& P0, // Centre of Mass Positions and Rotations
+			const FRotation3& Q0,
+			const FVec3& P1,
+			const FRotation3& Q1,
+			FVec3& V0,
+			FVec3& W0,
+			FVec3& V1,
+			FVec3& W1)
+		{
+			TArrayView<FManifoldPoint> ManifoldPoints = Constraint.GetManifoldPoints();
+			for (int32 PointIndex = 0; PointIndex < ManifoldPoints.Num(); ++PointIndex)
+			{
+				FManifoldPoint& ManifoldPoint = Constraint.SetActiveManifoldPoint(PointIndex, P0, Q0, P1, Q1);
+				const FVec3 ContactNormal = ManifoldPoint.ContactPoint.Normal;
+
+				// Points that have separated, or impulses that would pull the bodies together, start from zero like new points
+				if ((ManifoldPoint.ContactPoint.Phi > Chaos_Collision_CollisionClipTolerance) || (FVec3::DotProduct(ManifoldPoint.NetImpulse, ContactNormal) <= 0.0f))
+				{
+					ManifoldPoint.NetImpulse = FVec3(0);
+					continue;
+				}
+
+				const FVec3& Impulse = ManifoldPoint.NetImpulse;
+				if (InvM0 > 0.0f)
+				{
+					const FVec3 RelativeContactPoint0 = ManifoldPoint.ContactPoint.Location - P0;
+					V0 += InvM0 * Impulse;
+					W0 += InvI0 * FVec3::CrossProduct(RelativeContactPoint0, Impulse);
+				}
+				if (InvM1 > 0.0f)
+				{
+					const FVec3 RelativeContactPoint1 = ManifoldPoint.ContactPoint.Location - P1;
+					V1 -= InvM1 * Impulse;
+					W1 -= InvI1 * FVec3::CrossProduct(RelativeContactPoint1, Impulse);
+				}
+
+				// Allow the iterations to undo the impulse if the contact is now separating
+				ManifoldPoint.bActive = true;
+			}
+		}
+
+
 		// Velocity solver loop for a single contact manifold.
 		void ApplyContactManifold(
 			FRigidBodyPointContactConstraint& Constraint,
@@ -522,6 +572,12 @@ namespace Chaos
 
 			Constraint.AccumulatedImpulse = FVec3(0);
 
+			if (Constraint.IsWarmStartPending())
+			{
+				Constraint.ClearWarmStartPending();
+				ApplyManifoldWarmStart(Constraint, InvM0, InvI0, InvM1, InvI1, P0, Q0, P1, Q1, V0, W0, V1, W1);
+			}
+
 			// Velocity solve requires full stiffness for restitution to work correctly
 			const FReal Stiffness = 1.0f;
 
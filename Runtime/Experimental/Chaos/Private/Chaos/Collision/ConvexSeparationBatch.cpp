@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Chaos/Collision/ConvexSeparationBatch.h"
+#include "Chaos/Box.h"
+#include "Chaos/Capsule.h"
+#include "Chaos/ChaosPerfTest.h"
+#include "Chaos/GJK.h"
+#include "Chaos/ImplicitObject.h"
+#include "Chaos/Sphere.h"
+#include "ChaosLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+#if INTEL_ISPC
+#include "ConvexSeparationBatch.ispc.generated.h"
+#endif
+
+namespace Chaos
+{
+#if INTEL_ISPC
+	bool bChaos_Collision_SeparationBatch_ISPC_Enabled = true;
+	FAutoConsoleVariableRef CVarChaosCollisionSeparationBatchISPCEnabled(TEXT("p.Chaos.Collision.SeparationBatch.ISPC"), bChaos_Collision_SeparationBatch_ISPC_Enabled, TEXT("Whether to use ISPC optimizations to compute the separation of convex pair batches"));
+#endif
+
+	void FConvexSeparationBatch::Reset(int32 InMaxPairs)
+	{
+		NumPairs = 0;
+		MaxPairs = InMaxPairs;
+		for (TArray<float>& ShapeStreams : Streams)
+		{
+			ShapeStreams.SetNumUninitialized(NumStreams * MaxPairs, false);
+		}
+	}
+
+	bool FConvexSeparationBatch::Add(const FImplicitObject& Implicit0, const FRigidTransform3& Transform0, const FImplicitObject& Implicit1, const FRigidTransform3& Transform1)
+	{
+		check(NumPairs < MaxPairs);
+		if (AddShape(0, NumPairs, Implicit0, Transform0) && AddShape(1, NumPairs, Implicit1, Transform1))
+		{
+			++NumPairs;
+			return true;
+		}
+		return false;
+	}
+
+	bool FConvexSeparationBatch::AddShape(int32 Shape, int32 PairIndex, const FImplicitObject& Implicit, const FRigidTransform3& Transform)
+	{
+		// Non-uniform scale turns spheres into ellipsoids, so use the largest scale for the radius to stay conservative
+		const FReal RadiusScale = Transform.GetScale3D().GetAbsMax();
+		FVec3 Center;
+		FVec3 Axes[3] = { FVec3(0), FVec3(0), FVec3(0) };
+		FReal ShapeRadius = 0;
+
+		if (const TSphere<FReal, 3>* Sphere = Implicit.template GetObject<TSphere<FReal, 3>>())
+		{
+			Center = Transform.TransformPosition(Sphere->GetCenter());
+			ShapeRadius = Sphere->GetRadius() * RadiusScale;
+		}
+		else if (const TCapsule<FReal>* Capsule = Implicit.template GetObject<TCapsule<FReal>>())
+		{
+			Center = Transform.TransformPosition(Capsule->GetCenter());
+			Axes[0] = Transform.TransformVector(Capsule->GetAxis() * (0.5f * Capsule->GetHeight()));
+			ShapeRadius = Capsule->GetRadius() * RadiusScale;
+		}
+		else if (Implicit.HasBoundingBox())
+		{
+			// Boxes are exactly their bounds, other convexes are contained in them
+			const FAABB3 Bounds = Implicit.BoundingBox();
+			const FVec3 HalfExtents = 0.5f * Bounds.Extents();
+			Center = Transform.TransformPosition(Bounds.Center());
+			Axes[0] = Transform.TransformVector(FVec3(HalfExtents.X, 0, 0));
+			Axes[1] = Transform.TransformVector(FVec3(0, HalfExtents.Y, 0));
+			Axes[2] = Transform.TransformVector(FVec3(0, 0, HalfExtents.Z));
+		}
+		else
+		{
+			return false;
+		}
+
+		SetAxis(Shape, CenterX, PairIndex, Center);
+		SetAxis(Shape, Axis0X, PairIndex, Axes[0]);
+		SetAxis(Shape, Axis1X, PairIndex, Axes[1]);
+		SetAxis(Shape, Axis2X, PairIndex, Axes[2]);
+		Streams[Shape][Radius * MaxPairs + PairIndex] = ShapeRadius;
+		return true;
+	}
+
+	void FConvexSeparationBatch::ComputeSeparations(TArray<FReal>& OutSeparations) const
+	{
+		OutSeparations.SetNumUninitialized(NumPairs, false);
+		if (NumPairs == 0)
+		{
+			return;
+		}
+
+#if INTEL_ISPC
+		if (bChaos_Collision_SeparationBatch_ISPC_Enabled)
+		{
+			static_assert(sizeof(FReal) == sizeof(float), "ComputeConvexSeparations expects float separations");
+			ispc::ComputeConvexSeparations(Streams[0].GetData(), Streams[1].GetData(), OutSeparations.GetData(), MaxPairs, NumPairs);
+			return;
+		}
+#endif
+
+		// Each loop below only reads contiguous streams so that the compiler can vectorize it
+		const float* Shape0 = Streams[0].GetData();
+		const float* Shape1 = Streams[1].GetData();
+		FReal* Separations = OutSeparations.GetData();
+
+		TArray<FReal, TInlineAllocator<256>> InvDistances;
+		InvDistances.SetNumUninitialized(NumPairs);
+		for (int32 Index = 0; Index < NumPairs; ++Index)
+		{
+			const FReal DX = Shape1[CenterX * MaxPairs + Index] - Shape0[CenterX * MaxPairs + Index];
+			const FReal DY = Shape1[CenterY * MaxPairs + Index] - Shape0[CenterY * MaxPairs + Index];
+			const FReal DZ = Shape1[CenterZ * MaxPairs + Index] - Shape0[CenterZ * MaxPairs + Index];
+			const FReal Distance = FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+			Separations[Index] = Distance;
+			InvDistances[Index] = (Distance > SMALL_NUMBER) ? 1.0f / Distance : 0.0f;
+		}
+
+		for (int32 Shape = 0; Shape < 2; ++Shape)
+		{
+			const float* Data = Streams[Shape].GetData();
+			for (int32 Index = 0; Index < NumPairs; ++Index)
+			{
+				const FReal NX = (Shape1[CenterX * MaxPairs + Index] - Shape0[CenterX * MaxPairs + Index]) * InvDistances[Index];
+				const FReal NY = (Shape1[CenterY * MaxPairs + Index] - Shape0[CenterY * MaxPairs + Index]) * InvDistances[Index];
+				const FReal NZ = (Shape1[CenterZ * MaxPairs + Index] - Shape0[CenterZ * MaxPairs + Index]) * InvDistances[Index];
+				const FReal D0 = NX * Data[Axis0X * MaxPairs + Index] + NY * Data[Axis0Y * MaxPairs + Index] + NZ * Data[Axis0Z * MaxPairs + Index];
+				const FReal D1 = NX * Data[Axis1X * MaxPairs + Index] + NY * Data[Axis1Y * MaxPairs + Index] + NZ * Data[Axis1Z * MaxPairs + Index];
+				const FReal D2 = NX * Data[Axis2X * MaxPairs + Index] + NY * Data[Axis2Y * MaxPairs + Index] + NZ * Data[Axis2Z * MaxPairs + Index];
+				Separations[Index] -= FMath::Abs(D0) + FMath::Abs(D1) + FMath::Abs(D2) + Data[Radius * MaxPairs + Index];
+			}
+		}
+
+		// Coincident centers have no axis to test
+		for (int32 Index = 0; Index < NumPairs; ++Index)
+		{
+			if (InvDistances[Index] == 0.0f)
+			{
+				Separations[Index] = -MAX_FLT;
+			}
+		}
+	}
+
+#if CHAOS_PERF_TEST_ENABLED
+	/** Compares the batched separation test with per pair GJK on random box and capsule pairs */
+	static void BenchmarkConvexSeparationBatch(const TArray<FString>& Args)
+	{
+		const int32 NumPairs = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 4096;
+		const FReal CullDistance = 3.0f;
+
+		FRandomStream Random(NumPairs);
+		TArray<TUniquePtr<FImplicitObject>> Shapes;
+		TArray<FRigidTransform3> Transforms;
+		for (int32 Index = 0; Index < 2 * NumPairs; ++Index)
+		{
+			const FVec3 Size = FVec3(Random.FRandRange(10, 50), Random.FRandRange(10, 50), Random.FRandRange(10, 50));
+			if (Random.FRand() < 0.5f)
+			{
+				Shapes.Emplace(MakeUnique<TBox<FReal, 3>>(-0.5f * Size, 0.5f * Size));
+			}
+			else
+			{
+				Shapes.Emplace(MakeUnique<TCapsule<FReal>>(FVec3(0, 0, -Size.Z), FVec3(0, 0, Size.Z), Size.X));
+			}
+			Transforms.Emplace(FRotation3(Random.GetUnitVector(), Random.FRand()), FVec3(Random.VRand() * 200.0f));
+		}
+
+		FConvexSeparationBatch Batch;
+		TArray<FReal> Separations;
+		{
+			CHAOS_PERF_TEST(ConvexSeparationBatch, EChaosPerfUnits::Us);
+			{
+				CHAOS_SCOPED_TIMER(BatchedSeparation);
+				Batch.Reset(NumPairs);
+				for (int32 Index = 0; Index < NumPairs; ++Index)
+				{
+					Batch.Add(*Shapes[2 * Index], Transforms[2 * Index], *Shapes[2 * Index + 1], Transforms[2 * Index + 1]);
+				}
+				Batch.ComputeSeparations(Separations);
+			}
+
+			int32 NumOverlaps = 0;
+			{
+				CHAOS_SCOPED_TIMER(ScalarGJK);
+				for (int32 Index = 0; Index < NumPairs; ++Index)
+				{
+					const FRigidTransform3 BToATM = Transforms[2 * Index + 1].GetRelativeTransform(Transforms[2 * Index]);
+					const FImplicitObject& A = *Shapes[2 * Index];
+					const FImplicitObject& B = *Shapes[2 * Index + 1];
+					const bool bOverlap = (A.GetType() == ImplicitObjectType::Box)
+						? ((B.GetType() == ImplicitObjectType::Box)
+							? GJKIntersection<FReal>(*A.template GetObject<TBox<FReal, 3>>(), *B.template GetObject<TBox<FReal, 3>>(), BToATM, CullDistance)
+							: GJKIntersection<FReal>(*A.template GetObject<TBox<FReal, 3>>(), *B.template GetObject<TCapsule<FReal>>(), BToATM, CullDistance))
+						: ((B.GetType() == ImplicitObjectType::Box)
+							? GJKIntersection<FReal>(*A.template GetObject<TCapsule<FReal>>(), *B.template GetObject<TBox<FReal, 3>>(), BToATM, CullDistance)
+							: GJKIntersection<FReal>(*A.template GetObject<TCapsule<FReal>>(), *B.template GetObject<TCapsule<FReal>>(), BToATM, CullDistance));
+					NumOverlaps += bOverlap ? 1 : 0;
+				}
+			}
+
+			const int32 NumCulled = Separations.FilterByPredicate([CullDistance](FReal Separation) { return Separation > CullDistance; }).Num();
+			UE_LOG(LogChaos, Log, TEXT("ConvexSeparationBatch - %d pairs, %d culled by the batch, %d not overlapping with GJK"), NumPairs, NumCulled, NumPairs - NumOverlaps);
+		}
+	}
+
+	FAutoConsoleCommand BenchmarkConvexSeparationBatchCommand(TEXT("p.Chaos.Collision.SeparationBatch.Benchmark"), TEXT("Times the batched convex separation test against scalar GJK. Optional arg: number of pairs."), FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkConvexSeparationBatch));
+#endif
+}
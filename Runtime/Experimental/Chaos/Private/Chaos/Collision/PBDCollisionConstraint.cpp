@@ -194,6 +194,29 @@ namespace Chaos
 		ManifoldPoints.Reset();
 	}
 
+	void FRigidBodyPointContactConstraint::RestoreOneShotManifold(TArrayView<const FManifoldPoint> InManifoldPoints, const FRigidTransform3& InRelativeTransform, bool bInWarmStart)
+	{
+		ManifoldPoints.Reset(InManifoldPoints.Num());
+		ManifoldPoints.Append(InManifoldPoints.GetData(), InManifoldPoints.Num());
+		SetManifoldRelativeTransform(InRelativeTransform);
+		bWarmStartPending = bInWarmStart;
+
+		// The solver state is accumulated per frame. Only the velocity impulse carries over, and only if it will be warm started.
+		for (FManifoldPoint& ManifoldPoint : ManifoldPoints)
+		{
+			if (!bInWarmStart)
+			{
+				ManifoldPoint.NetImpulse = FVec3(0);
+			}
+			ManifoldPoint.NetPushOut = FVec3(0);
+			ManifoldPoint.NetPushOutImpulseNormal = 0.0f;
+			ManifoldPoint.NetPushOutImpulseTangent = 0.0f;
+			ManifoldPoint.bInsideStaticFrictionCone = false;
+			ManifoldPoint.bRestitutionEnabled = false;
+			ManifoldPoint.bActive = false;
+		}
+	}
+
 	void FRigidBodyPointContactConstraint::InitManifoldPoint(FManifoldPoint& ManifoldPoint, FReal Dt)
 	{
 		TConstGenericParticleHandle<FReal, 3> Particle0 = Particle[0];
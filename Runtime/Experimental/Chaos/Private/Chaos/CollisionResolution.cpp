@@ -8,6 +8,7 @@
 #include "Chaos/CollisionResolutionTypes.h"
 #include "Chaos/CollisionResolutionUtil.h"
 #include "Chaos/Collision/CollisionContext.h"
+#include "Chaos/Collision/CollisionManifoldCache.h"
 #include "Chaos/Collision/PBDCollisionConstraint.h"
 #include "Chaos/Convex.h"
 #include "Chaos/Defines.h"
@@ -815,6 +816,27 @@ namespace Chaos
 			//   Stub function for updating the manifold prior to the Apply and ApplyPushOut
 		}
 
+		// Whether the convex-convex update of this implicit type builds one-shot manifolds without extra transforms (see TImplicitManifoldTraits)
+		bool SupportsPersistentOneShotManifold(EImplicitObjectType ImplicitType)
+		{
+			return (ImplicitType == ImplicitObjectType::Box) || (GetInnerType(ImplicitType) == ImplicitObjectType::Convex && !IsInstanced(ImplicitType));
+		}
+
+		// Restore the one-shot manifold the pair had in the previous frame if its shapes have barely moved relative to each other
+		bool RestoreOneShotManifold(const FCollisionContext& Context, const FRigidTransform3& WorldTransform0, const FRigidTransform3& WorldTransform1, FRigidBodyPointContactConstraint& Constraint)
+		{
+			return (Context.ManifoldCache != nullptr) && Context.ManifoldCache->Restore(Constraint, WorldTransform0, WorldTransform1);
+		}
+
+		// Store the relative transform of the shapes a new one-shot manifold was built with, to restore it in the next frame
+		void SetOneShotManifoldRelativeTransform(const FRigidTransform3& WorldTransform0, const FRigidTransform3& WorldTransform1, FRigidBodyPointContactConstraint& Constraint)
+		{
+			if (Constraint.UseOneShotManifold() && !Constraint.HasManifoldRelativeTransform() && (Constraint.GetManifoldPoints().Num() > 0))
+			{
+				Constraint.SetManifoldRelativeTransform(WorldTransform1.GetRelativeTransform(WorldTransform0));
+			}
+		}
+
 		template<typename T_TRAITS>
 		void ConstructBoxBoxConstraints(TGeometryParticleHandle<FReal, 3>* Particle0, TGeometryParticleHandle<FReal, 3>* Particle1, const FImplicitObject* Implicit0, const FImplicitObject* Implicit1, const FRigidTransform3& LocalTransform0, const FRigidTransform3& LocalTransform1, const FReal CullDistance, const FReal Dt, const FCollisionContext& Context, FCollisionConstraintsArray& NewConstraints)
 		{
@@ -827,7 +849,9 @@ namespace Chaos
 				{
 					FRigidTransform3 WorldTransform0 = LocalTransform0 * Collisions::GetTransform(Particle0);
 					FRigidTransform3 WorldTransform1 = LocalTransform1 * Collisions::GetTransform(Particle1);
+					RestoreOneShotManifold(Context, WorldTransform0, WorldTransform1, Constraint);
 					UpdateBoxBoxConstraint(*Object0, WorldTransform0, *Object1, WorldTransform1, CullDistance, Dt, Constraint);
+					SetOneShotManifoldRelativeTransform(WorldTransform0, WorldTransform1, Constraint);
 				}
 				NewConstraints.Add(Constraint);
 			}
@@ -2068,7 +2092,16 @@ namespace Chaos
 			{
 				FRigidTransform3 WorldTransform0 = LocalTransform0 * Collisions::GetTransform(Particle0);
 				FRigidTransform3 WorldTransform1 = LocalTransform1 * Collisions::GetTransform(Particle1);
+				const bool bPersistentManifold = SupportsPersistentOneShotManifold(Implicit0->GetType()) && SupportsPersistentOneShotManifold(Implicit1->GetType());
+				if (bPersistentManifold)
+				{
+					RestoreOneShotManifold(Context, WorldTransform0, WorldTransform1, Constraint);
+				}
 				UpdateGenericConvexConvexConstraint(*Implicit0, WorldTransform0, *Implicit1, WorldTransform1, CullDistance, Dt, Constraint);
+				if (bPersistentManifold)
+				{
+					SetOneShotManifoldRelativeTransform(WorldTransform0, WorldTransform1, Constraint);
+				}
 			}
 			NewConstraints.Add(Constraint);
 		}
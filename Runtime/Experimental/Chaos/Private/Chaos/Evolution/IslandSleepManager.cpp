@@ -0,0 +1,287 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#include "Chaos/Evolution/IslandSleepManager.h"
+#include "Chaos/Defines.h"
+#include "Chaos/ParticleHandle.h"
+#include "Chaos/PBDConstraintGraph.h"
+#include "ChaosLog.h"
+#include "ChaosStats.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::Islands"), STAT_ChaosSleep_Islands, STATGROUP_Chaos);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::AwakeMoving"), STAT_ChaosSleep_Moving, STATGROUP_Chaos);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::AwakeHysteresis"), STAT_ChaosSleep_Hysteresis, STATGROUP_Chaos);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::AwakeCountingDown"), STAT_ChaosSleep_CountingDown, STATGROUP_Chaos);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::Slept"), STAT_ChaosSleep_Sleep, STATGROUP_Chaos);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sleep::SleptByBudget"), STAT_ChaosSleep_BudgetSleep, STATGROUP_Chaos);
+
+TRACE_DECLARE_INT_COUNTER(ChaosSleep_AwakeIslands, TEXT("Chaos/Sleep/AwakeIslands"));
+TRACE_DECLARE_INT_COUNTER(ChaosSleep_Slept, TEXT("Chaos/Sleep/Slept"));
+TRACE_DECLARE_INT_COUNTER(ChaosSleep_SleptByBudget, TEXT("Chaos/Sleep/SleptByBudget"));
+
+namespace Chaos
+{
+	int32 ChaosSolverSleepCriteria = 0;
+	FAutoConsoleVariableRef CVarChaosSolverSleepCriteria(TEXT("p.Chaos.Solver.Sleep.Criteria"), ChaosSolverSleepCriteria, TEXT("How island motion is compared to the sleep thresholds. 0: speed of the fastest particle; 1: mass-weighted kinetic energy of the island.[def:0]"));
+
+	float ChaosSolverSleepWakeHysteresis = 1.0f;
+	FAutoConsoleVariableRef CVarChaosSolverSleepWakeHysteresis(TEXT("p.Chaos.Solver.Sleep.WakeHysteresis"), ChaosSolverSleepWakeHysteresis, TEXT("Multiple of the sleep threshold an island must exceed to reset its sleep counter. Islands in between keep their counter. 1 disables hysteresis.[def:1]"));
+
+	int32 ChaosSolverSleepMaxAwakeIslands = 0;
+	FAutoConsoleVariableRef CVarChaosSolverSleepMaxAwakeIslands(TEXT("p.Chaos.Solver.Sleep.MaxAwakeIslands"), ChaosSolverSleepMaxAwakeIslands, TEXT("Maximum number of awake islands. When over budget the slow islands furthest from the viewers are put to sleep. 0 is unlimited.[def:0]"));
+
+	float ChaosSolverSleepBudgetMotionRatio = 10.0f;
+	FAutoConsoleVariableRef CVarChaosSolverSleepBudgetMotionRatio(TEXT("p.Chaos.Solver.Sleep.BudgetMotionRatio"), ChaosSolverSleepBudgetMotionRatio, TEXT("Only islands with less motion than this multiple of their sleep threshold can be put to sleep by the awake island budget.[def:10]"));
+
+	int32 ChaosSolverSleepLogAwakeIslands = 0;
+	FAutoConsoleVariableRef CVarChaosSolverSleepLogAwakeIslands(TEXT("p.Chaos.Solver.Sleep.LogAwakeIslands"), ChaosSolverSleepLogAwakeIslands, TEXT("Log this many of the awake islands with the most motion at the end of the next step, then reset to 0."));
+
+	static const TCHAR* LexToString(EIslandSleepState State)
+	{
+		switch (State)
+		{
+		case EIslandSleepState::Inactive: return TEXT("Inactive");
+		case EIslandSleepState::Moving: return TEXT("Moving");
+		case EIslandSleepState::Hysteresis: return TEXT("Hysteresis");
+		case EIslandSleepState::CountingDown: return TEXT("CountingDown");
+		case EIslandSleepState::Sleep: return TEXT("Sleep");
+		case EIslandSleepState::BudgetSleep: return TEXT("BudgetSleep");
+		}
+		return TEXT("Unknown");
+	}
+
+	static bool IsAwakeIslandState(EIslandSleepState State)
+	{
+		return (State == EIslandSleepState::Moving) || (State == EIslandSleepState::Hysteresis) || (State == EIslandSleepState::CountingDown);
+	}
+
+	void FIslandSleepManager::BeginStep(const FPBDConstraintGraph& ConstraintGraph)
+	{
+		FIslandState DefaultState;
+		DefaultState.MotionRatio = 0;
+		DefaultState.Center = FVec3(0);
+		DefaultState.MostMovingParticle = nullptr;
+		DefaultState.State = EIslandSleepState::Inactive;
+
+		IslandStates.Reset();
+		IslandStates.Init(DefaultState, ConstraintGraph.NumIslands());
+	}
+
+	bool FIslandSleepManager::EvaluateIsland(FPBDConstraintGraph& ConstraintGraph, const int32 Island, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials)
+	{
+		FIslandState& IslandState = IslandStates[Island];
+		if (!FPBDConstraintGraph::IsSleepEnabled() || !ConstraintGraph.IsIslandPersistent(Island))
+		{
+			return false;
+		}
+
+		const bool bUseEnergy = (ChaosSolverSleepCriteria == 1);
+
+		FReal LinearThreshold = FLT_MAX;
+		FReal AngularThreshold = FLT_MAX;
+		int32 CounterThreshold = 0;
+		FReal MaxLinearSpeed2 = 0;
+		FReal MaxAngularSpeed2 = 0;
+		FReal MaxParticleMotion = -1;
+
+		// Mass-weighted sums of the kinetic energy and of the energy at the sleep thresholds.
+		// The rotational energy uses the average of the principal moments of inertia.
+		FReal Energy = 0;
+		FReal ThresholdEnergy = 0;
+
+		int32 NumDynamicParticles = 0;
+		for (const TGeometryParticleHandle<FReal, 3>* Particle : ConstraintGraph.GetIslandParticles(Island))
+		{
+			const TPBDRigidParticleHandle<FReal, 3>* PBDRigid = Particle->CastToRigidParticle();
+			if (!PBDRigid || PBDRigid->ObjectState() != EObjectStateType::Dynamic)
+			{
+				continue;
+			}
+			++NumDynamicParticles;
+
+			FReal ParticleLinearThreshold, ParticleAngularThreshold;
+			int32 ParticleCounterThreshold;
+			FPBDConstraintGraph::GetSleepThresholds(PBDRigid, PerParticleMaterialAttributes, SolverPhysicsMaterials, ParticleLinearThreshold, ParticleAngularThreshold, ParticleCounterThreshold);
+			LinearThreshold = FMath::Min(LinearThreshold, ParticleLinearThreshold);
+			AngularThreshold = FMath::Min(AngularThreshold, ParticleAngularThreshold);
+			CounterThreshold = FMath::Max(CounterThreshold, ParticleCounterThreshold);
+
+			const FReal LinearSpeed2 = PBDRigid->VSmooth().SizeSquared();
+			const FReal AngularSpeed2 = PBDRigid->WSmooth().SizeSquared();
+			MaxLinearSpeed2 = FMath::Max(MaxLinearSpeed2, LinearSpeed2);
+			MaxAngularSpeed2 = FMath::Max(MaxAngularSpeed2, AngularSpeed2);
+
+			FReal ParticleMotion = FMath::Max(LinearSpeed2, AngularSpeed2);
+			if (bUseEnergy)
+			{
+				const FMatrix33& Inertia = PBDRigid->I();
+				const FReal AverageInertia = (Inertia.M[0][0] + Inertia.M[1][1] + Inertia.M[2][2]) / 3.0f;
+				const FReal ParticleEnergy = 0.5f * (PBDRigid->M() * LinearSpeed2 + AverageInertia * AngularSpeed2);
+				Energy += ParticleEnergy;
+				ThresholdEnergy += 0.5f * (PBDRigid->M() * FMath::Square(ParticleLinearThreshold) + AverageInertia * FMath::Square(ParticleAngularThreshold));
+				ParticleMotion = ParticleEnergy;
+			}
+
+			IslandState.Center += PBDRigid->X();
+			if (ParticleMotion > MaxParticleMotion)
+			{
+				MaxParticleMotion = ParticleMotion;
+				IslandState.MostMovingParticle = Particle;
+			}
+		}
+
+		if (NumDynamicParticles == 0)
+		{
+			// All particles must be sleeping/disabled already
+			return false;
+		}
+
+		IslandState.Center /= (FReal)NumDynamicParticles;
+		if (LinearThreshold <= 0 || AngularThreshold <= 0)
+		{
+			// A zero threshold means the island never sleeps, not even to stay within the awake island budget
+			IslandState.MotionRatio = FLT_MAX;
+		}
+		else if (bUseEnergy)
+		{
+			IslandState.MotionRatio = Energy / FMath::Max(ThresholdEnergy, (FReal)SMALL_NUMBER);
+		}
+		else
+		{
+			const FReal LinearRatio = FMath::Sqrt(MaxLinearSpeed2) / FMath::Max(LinearThreshold, (FReal)SMALL_NUMBER);
+			const FReal AngularRatio = FMath::Sqrt(MaxAngularSpeed2) / FMath::Max(AngularThreshold, (FReal)SMALL_NUMBER);
+			IslandState.MotionRatio = FMath::Max(LinearRatio, AngularRatio);
+		}
+
+		const int32 SleepCount = ConstraintGraph.GetIslandSleepCount(Island);
+		if (IslandState.MotionRatio < 1.0f)
+		{
+			if (SleepCount >= CounterThreshold)
+			{
+				IslandState.State = EIslandSleepState::Sleep;
+				return true;
+			}
+			ConstraintGraph.SetIslandSleepCount(Island, SleepCount + 1);
+			IslandState.State = EIslandSleepState::CountingDown;
+		}
+		else if (IslandState.MotionRatio < ChaosSolverSleepWakeHysteresis)
+		{
+			IslandState.State = EIslandSleepState::Hysteresis;
+		}
+		else
+		{
+			ConstraintGraph.SetIslandSleepCount(Island, 0);
+			IslandState.State = EIslandSleepState::Moving;
+		}
+		return false;
+	}
+
+	void FIslandSleepManager::EndStep(const FPBDConstraintGraph& ConstraintGraph, TArray<bool>& InOutSleepIslands)
+	{
+		check(IslandStates.Num() == InOutSleepIslands.Num());
+
+		TArray<int32> AwakeIslands;
+		for (int32 Island = 0; Island < IslandStates.Num(); ++Island)
+		{
+			if (IsAwakeIslandState(IslandStates[Island].State))
+			{
+				AwakeIslands.Add(Island);
+			}
+		}
+
+		int32 NumOverBudget = (ChaosSolverSleepMaxAwakeIslands > 0) ? AwakeIslands.Num() - ChaosSolverSleepMaxAwakeIslands : 0;
+		if (NumOverBudget > 0)
+		{
+			TArray<int32> Candidates = AwakeIslands.FilterByPredicate([this](int32 Island) { return IslandStates[Island].MotionRatio < ChaosSolverSleepBudgetMotionRatio; });
+
+			// Furthest from the viewers first, then the islands with the least motion
+			TArray<FReal> ViewerDistances;
+			ViewerDistances.SetNumZeroed(IslandStates.Num());
+			for (int32 Island : Candidates)
+			{
+				FReal MinDistance2 = ViewerLocations.Num() ? FLT_MAX : 0;
+				for (const FVec3& ViewerLocation : ViewerLocations)
+				{
+					MinDistance2 = FMath::Min(MinDistance2, (IslandStates[Island].Center - ViewerLocation).SizeSquared());
+				}
+				ViewerDistances[Island] = MinDistance2;
+			}
+			Candidates.Sort([this, &ViewerDistances](int32 A, int32 B)
+			{
+				if (ViewerDistances[A] != ViewerDistances[B])
+				{
+					return ViewerDistances[A] > ViewerDistances[B];
+				}
+				return IslandStates[A].MotionRatio < IslandStates[B].MotionRatio;
+			});
+
+			for (int32 CandidateIndex = 0; (CandidateIndex < Candidates.Num()) && (NumOverBudget > 0); ++CandidateIndex, --NumOverBudget)
+			{
+				const int32 Island = Candidates[CandidateIndex];
+				IslandStates[Island].State = EIslandSleepState::BudgetSleep;
+				InOutSleepIslands[Island] = true;
+			}
+		}
+
+		Stats = FIslandSleepStats();
+		Stats.NumIslands = IslandStates.Num();
+		for (const FIslandState& IslandState : IslandStates)
+		{
+			switch (IslandState.State)
+			{
+			case EIslandSleepState::Moving: ++Stats.NumMoving; break;
+			case EIslandSleepState::Hysteresis: ++Stats.NumHysteresis; break;
+			case EIslandSleepState::CountingDown: ++Stats.NumCountingDown; break;
+			case EIslandSleepState::Sleep: ++Stats.NumSleep; break;
+			case EIslandSleepState::BudgetSleep: ++Stats.NumBudgetSleep; break;
+			default: break;
+			}
+		}
+
+		SET_DWORD_STAT(STAT_ChaosSleep_Islands, Stats.NumIslands);
+		SET_DWORD_STAT(STAT_ChaosSleep_Moving, Stats.NumMoving);
+		SET_DWORD_STAT(STAT_ChaosSleep_Hysteresis, Stats.NumHysteresis);
+		SET_DWORD_STAT(STAT_ChaosSleep_CountingDown, Stats.NumCountingDown);
+		SET_DWORD_STAT(STAT_ChaosSleep_Sleep, Stats.NumSleep);
+		SET_DWORD_STAT(STAT_ChaosSleep_BudgetSleep, Stats.NumBudgetSleep);
+		TRACE_COUNTER_SET(ChaosSleep_AwakeIslands, Stats.NumMoving + Stats.NumHysteresis + Stats.NumCountingDown);
+		TRACE_COUNTER_SET(ChaosSleep_Slept, Stats.NumSleep);
+		TRACE_COUNTER_SET(ChaosSleep_SleptByBudget, Stats.NumBudgetSleep);
+
+		if (ChaosSolverSleepLogAwakeIslands > 0)
+		{
+			LogAwakeIslands(ConstraintGraph, ChaosSolverSleepLogAwakeIslands);
+			ChaosSolverSleepLogAwakeIslands = 0;
+		}
+	}
+
+	void FIslandSleepManager::LogAwakeIslands(const FPBDConstraintGraph& ConstraintGraph, int32 MaxIslands) const
+	{
+		TArray<int32> AwakeIslands;
+		for (int32 Island = 0; Island < IslandStates.Num(); ++Island)
+		{
+			if (IsAwakeIslandState(IslandStates[Island].State))
+			{
+				AwakeIslands.Add(Island);
+			}
+		}
+		AwakeIslands.Sort([this](int32 A, int32 B) { return IslandStates[A].MotionRatio > IslandStates[B].MotionRatio; });
+
+		UE_LOG(LogChaos, Log, TEXT("Sleep: %d islands, %d awake (%d moving, %d hysteresis, %d counting down), %d slept, %d slept by budget"),
+			Stats.NumIslands, AwakeIslands.Num(), Stats.NumMoving, Stats.NumHysteresis, Stats.NumCountingDown, Stats.NumSleep, Stats.NumBudgetSleep);
+
+		for (int32 Index = 0; Index < FMath::Min(MaxIslands, AwakeIslands.Num()); ++Index)
+		{
+			const int32 Island = AwakeIslands[Index];
+			const FIslandState& IslandState = IslandStates[Island];
+			UE_LOG(LogChaos, Log, TEXT("  Island %d: %s, %d particles, motion %.2fx threshold, sleep count %d, center %s, most moving %s"),
+				Island,
+				LexToString(IslandState.State),
+				ConstraintGraph.GetIslandParticles(Island).Num(),
+				IslandState.MotionRatio,
+				ConstraintGraph.GetIslandSleepCount(Island),
+				*IslandState.Center.ToString(),
+				IslandState.MostMovingParticle ? *IslandState.MostMovingParticle->ToString() : TEXT("none"));
+		}
+	}
+}
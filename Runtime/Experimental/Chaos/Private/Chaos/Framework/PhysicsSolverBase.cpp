@@ -5,9 +5,13 @@
 #include "ProfilingDebugging/CsvProfiler.h"
 #include "ChaosStats.h"
 #include "Chaos/PendingSpatialData.h"
+#include "HAL/IConsoleManager.h"
 
 namespace Chaos
 {	
+	int32 AsyncMaxStepsPerFrame = 4;
+	FAutoConsoleVariableRef CVarAsyncMaxStepsPerFrame(TEXT("p.Chaos.Async.MaxStepsPerFrame"), AsyncMaxStepsPerFrame, TEXT("Maximum number of fixed steps an async solver dispatches in one external frame. Time beyond that is dropped so that a slow frame does not make the following ones slower"));
+
 	void FPhysicsSolverBase::ChangeBufferMode(EMultiBufferMode InBufferMode)
 	{
 		BufferMode = InBufferMode;
@@ -56,6 +60,20 @@ namespace Chaos
 		, Queue(MoveTemp(InQueue))
 		, PushData(MoveTemp(InPushData))
 		, Dt(InDt)
+		, ExternalEndTime(0)
+		, ExternalTimestamp(INDEX_NONE)
+		, bPullResults(false)
+	{
+	}
+
+	FPhysicsSolverAdvanceTask::FPhysicsSolverAdvanceTask(FPhysicsSolverBase& InSolver, TArray<TFunction<void()>>&& InQueue, TArray<FPushPhysicsData*>&& InPushData, FReal InDt, FReal InExternalEndTime, int32 InExternalTimestamp)
+		: Solver(InSolver)
+		, Queue(MoveTemp(InQueue))
+		, PushData(MoveTemp(InPushData))
+		, Dt(InDt)
+		, ExternalEndTime(InExternalEndTime)
+		, ExternalTimestamp(InExternalTimestamp)
+		, bPullResults(true)
 	{
 	}
 
@@ -100,6 +118,11 @@ namespace Chaos
 		}
 
 		Solver.AdvanceSolverBy(Dt);
+
+		if(bPullResults)
+		{
+			Solver.MarshallingManager.FinalizePullData_Internal(ExternalEndTime, ExternalTimestamp);
+		}
 	}
 
 	FPhysicsSolverBase::FPhysicsSolverBase(const EMultiBufferMode BufferingModeIn,const EThreadingModeTemp InThreadingMode,UObject* InOwner,ETraits InTraitIdx)
@@ -107,6 +130,8 @@ namespace Chaos
 		, ThreadingMode(InThreadingMode)
 		, PendingSpatialOperations_External(MakeUnique<FPendingSpatialDataQueue>())
 		, bPaused_External(false)
+		, AsyncFixedDt(0)
+		, AsyncAccumulatedTime(0)
 		, Owner(InOwner)
 		, TraitIdx(InTraitIdx)
 	{
@@ -115,6 +140,70 @@ namespace Chaos
 	FPhysicsSolverBase::~FPhysicsSolverBase() = default;
 
 
+	void FPhysicsSolverBase::SetAsyncFixedDt_External(FReal InFixedDt)
+	{
+		const FReal NewFixedDt = FMath::Max(InFixedDt, (FReal)0);
+		if(NewFixedDt != AsyncFixedDt)
+		{
+			//steps in flight were dispatched with the old mode
+			WaitOnPendingTasks_External();
+			MarshallingManager.FreeAllPullData_External();
+			AsyncFixedDt = NewFixedDt;
+			AsyncAccumulatedTime = 0;
+		}
+	}
+
+	void FPhysicsSolverBase::DispatchFixedSteps_External(FReal Dt)
+	{
+		int32 NumSteps;
+		if(Dt > 0)
+		{
+			AsyncAccumulatedTime += Dt;
+			NumSteps = FMath::FloorToInt(AsyncAccumulatedTime / AsyncFixedDt);
+			AsyncAccumulatedTime -= NumSteps * AsyncFixedDt;
+
+			const int32 MaxSteps = FMath::Max(AsyncMaxStepsPerFrame, 1);
+			if(NumSteps > MaxSteps)
+			{
+				//inputs of the dropped time are consumed by the next step
+				MarshallingManager.SkipInternalTime_External((NumSteps - MaxSteps) * AsyncFixedDt);
+				NumSteps = MaxSteps;
+			}
+		}
+		else
+		{
+			//paused or editor solvers still need to consume inputs and build acceleration structures
+			NumSteps = 1;
+		}
+
+		const FReal StepDt = Dt > 0 ? AsyncFixedDt : 0;
+		for(int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			TArray<FPushPhysicsData*> PushData = MarshallingManager.StepInternalTime_External(StepDt);
+			const int32 ExternalTimestamp = MarshallingManager.GetExternalTimestampConsumed_External();
+			const FReal ExternalEndTime = MarshallingManager.GetInternalTime_External();
+			SetExternalTimestampConsumed_External(ExternalTimestamp);
+
+			//commands are only run by the first step
+			if(ThreadingMode == EThreadingModeTemp::SingleThread)
+			{
+				ensure(!PendingTasks || PendingTasks->IsComplete());
+				FPhysicsSolverAdvanceTask ImmediateTask(*this, MoveTemp(CommandQueue), MoveTemp(PushData), StepDt, ExternalEndTime, ExternalTimestamp);
+				ImmediateTask.AdvanceSolver();
+			}
+			else
+			{
+				FGraphEventArray Prereqs;
+				if(PendingTasks && !PendingTasks->IsComplete())
+				{
+					Prereqs.Add(PendingTasks);
+				}
+
+				PendingTasks = TGraphTask<FPhysicsSolverAdvanceTask>::CreateTask(&Prereqs).ConstructAndDispatchWhenReady(*this, MoveTemp(CommandQueue), MoveTemp(PushData), StepDt, ExternalEndTime, ExternalTimestamp);
+			}
+		}
+	}
+
 	void FPhysicsSolverBase::UpdateParticleInAccelerationStructure_External(TGeometryParticle<FReal,3>* Particle,bool bDelete)
 	{
 		//mark it as pending for async structure being built
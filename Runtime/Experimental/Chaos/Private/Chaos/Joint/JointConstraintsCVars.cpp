@@ -16,6 +16,9 @@ FAutoConsoleVariableRef CVarChaosJointBatching(TEXT("p.Chaos.Joint.Batching"), b
 int32 bChaos_Joint_MaxBatchSize = 1000;
 FAutoConsoleVariableRef CVarChaosJointBatchSize(TEXT("p.Chaos.Joint.MaxBatchSize"), bChaos_Joint_MaxBatchSize, TEXT(""));
 
+int32 Chaos_Joint_ParallelColorMinConstraints = 32;
+FAutoConsoleVariableRef CVarChaosJointParallelColorMinConstraints(TEXT("p.Chaos.Joint.ParallelColorMinConstraints"), Chaos_Joint_ParallelColorMinConstraints, TEXT("Minimum number of joints of the same level and color in an island to solve them in parallel. 0 solves joints serially."));
+
 float Chaos_Joint_DegenerateRotationLimit = -0.998f;	// Cos(176deg)
 FAutoConsoleVariableRef CVarChaosJointDegenerateRotationLimit(TEXT("p.Chaos.Joint.DegenerateRotationLimit"), Chaos_Joint_DegenerateRotationLimit, TEXT("Cosine of the swing angle that is considered degerenerate (default Cos(176deg))"));
 
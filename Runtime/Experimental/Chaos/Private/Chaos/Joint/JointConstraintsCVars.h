@@ -15,6 +15,7 @@
 extern bool bChaos_Joint_EarlyOut_Enabled;
 extern bool bChaos_Joint_Batching;
 extern int32 bChaos_Joint_MaxBatchSize;
+extern int32 Chaos_Joint_ParallelColorMinConstraints;
 
 extern float Chaos_Joint_DegenerateRotationLimit;
 
@@ -9,6 +9,7 @@
 #include "Chaos/CollisionResolutionUtil.h"
 #include "Chaos/CollisionResolution.h"
 #include "Chaos/Collision/CollisionContext.h"
+#include "Chaos/Collision/ConvexSeparationBatch.h"
 #include "Chaos/Defines.h"
 #include "Chaos/GeometryQueries.h"
 #include "Chaos/ImplicitObjectUnion.h"
@@ -75,12 +76,18 @@ namespace Chaos
 	float CollisionCullDistanceOverride = -1.0f;
 	FAutoConsoleVariableRef CVarDefaultCollisionCullDistance(TEXT("p.CollisionCullDistance"), CollisionCullDistanceOverride, TEXT("Collision culling distance override if >= 0"));
 
+	int32 CollisionParallelColorMinConstraints = 16;
+	FAutoConsoleVariableRef CVarCollisionParallelColorMinConstraints(TEXT("p.Chaos.Collision.ParallelColorMinConstraints"), CollisionParallelColorMinConstraints, TEXT("Minimum number of constraints of a color to solve them in parallel. Smaller colors, e.g. in small islands already solved in parallel with other islands, are solved on the island's thread."));
+
 	int32 CollisionCanAlwaysDisableContacts = 0;
 	FAutoConsoleVariableRef CVarCollisionCanAlwaysDisableContacts(TEXT("p.CollisionCanAlwaysDisableContacts"), CollisionCanAlwaysDisableContacts, TEXT("Collision culling will always be able to permanently disable contacts"));
 
 	int32 CollisionCanNeverDisableContacts = 0;
 	FAutoConsoleVariableRef CVarCollisionCanNeverDisableContacts(TEXT("p.CollisionCanNeverDisableContacts"), CollisionCanNeverDisableContacts, TEXT("Collision culling will never be able to permanently disable contacts"));
 
+	int32 CollisionSeparationBatchSize = 256;
+	FAutoConsoleVariableRef CVarCollisionSeparationBatchSize(TEXT("p.Chaos.Collision.SeparationBatchSize"), CollisionSeparationBatchSize, TEXT("Number of point constraints whose shape separation is tested in a batch before running the narrow phase on them, to skip separated pairs. 0 to disable."));
+
 #if INTEL_ISPC
 	bool bChaos_Collision_ISPC_Enabled = false;
 	FAutoConsoleVariableRef CVarChaosCollisionISPCEnabled(TEXT("p.Chaos.Collision.ISPC"), bChaos_Collision_ISPC_Enabled, TEXT("Whether to use ISPC optimizations in the Collision Solver"));
@@ -383,6 +390,9 @@ namespace Chaos
 			}
 		}
 #else
+		// Keep the one-shot manifolds for the next narrow phase before the constraints are destroyed
+		ManifoldCache.Capture(Constraints.SinglePointConstraints);
+
 		for (FPBDCollisionConstraintHandle* Handle : Handles)
 		{
 			HandleAllocator.FreeHandle(Handle);
@@ -417,6 +427,8 @@ namespace Chaos
 	{
 		check(!bInAppendOperation);
 
+		ManifoldCache.RemoveParticles(InHandleSet);
+
 		const TArray<TGeometryParticleHandle<FReal, 3>*> HandleArray = InHandleSet.Array();
 		for (auto ParticleHandle : HandleArray)
 		{
@@ -543,13 +555,65 @@ namespace Chaos
 		//	}
 		//}, bDisableCollisionParallelFor);
 
-		for (FRigidBodyPointContactConstraint& Contact : Constraints.SinglePointConstraints)
+		auto UpdateContact = [this, Dt](FRigidBodyPointContactConstraint& Contact)
 		{
 			Collisions::Update(Contact, MCullDistance, Dt);
 			if (Contact.GetPhi() < MCullDistance)
 			{
 				Contact.Timestamp = LifespanCounter;
 			}
+		};
+
+		if (CollisionSeparationBatchSize <= 0)
+		{
+			for (FRigidBodyPointContactConstraint& Contact : Constraints.SinglePointConstraints)
+			{
+				UpdateContact(Contact);
+			}
+			return;
+		}
+
+		// Cull the pairs separated by more than the cull distance in batches, and only run the narrow phase on the others
+		FConvexSeparationBatch SeparationBatch;
+		TArray<int32, TInlineAllocator<256>> BatchedContacts;
+		TArray<FReal> Separations;
+		const int32 NumContacts = Constraints.SinglePointConstraints.Num();
+		for (int32 BatchStart = 0; BatchStart < NumContacts; BatchStart += CollisionSeparationBatchSize)
+		{
+			const int32 BatchEnd = FMath::Min(BatchStart + CollisionSeparationBatchSize, NumContacts);
+			SeparationBatch.Reset(BatchEnd - BatchStart);
+			BatchedContacts.Reset();
+
+			for (int32 ContactIndex = BatchStart; ContactIndex < BatchEnd; ++ContactIndex)
+			{
+				FRigidBodyPointContactConstraint& Contact = Constraints.SinglePointConstraints[ContactIndex];
+				const FRigidTransform3 WorldTransform0 = Contact.ImplicitTransform[0] * Collisions::GetTransform(Contact.Particle[0]);
+				const FRigidTransform3 WorldTransform1 = Contact.ImplicitTransform[1] * Collisions::GetTransform(Contact.Particle[1]);
+				if (SeparationBatch.Add(*Contact.Manifold.Implicit[0], WorldTransform0, *Contact.Manifold.Implicit[1], WorldTransform1))
+				{
+					BatchedContacts.Add(ContactIndex);
+				}
+				else
+				{
+					UpdateContact(Contact);
+				}
+			}
+
+			SeparationBatch.ComputeSeparations(Separations);
+
+			for (int32 BatchIndex = 0; BatchIndex < BatchedContacts.Num(); ++BatchIndex)
+			{
+				FRigidBodyPointContactConstraint& Contact = Constraints.SinglePointConstraints[BatchedContacts[BatchIndex]];
+				if (Separations[BatchIndex] > MCullDistance)
+				{
+					// Same result as the narrow phase finding no contact within the cull distance
+					Contact.ResetPhi(MCullDistance);
+				}
+				else
+				{
+					UpdateContact(Contact);
+				}
+			}
 		}
 	}
 
@@ -740,7 +804,7 @@ namespace Chaos
 					}
 				}
 
-			}, bDisableCollisionParallelFor);
+			}, bDisableCollisionParallelFor || InConstraintHandles.Num() < CollisionParallelColorMinConstraints);
 		}
 
 		if (PostApplyCallback != nullptr)
@@ -771,7 +835,7 @@ namespace Chaos
 					Collisions::ApplyPushOut(ConstraintHandle->GetContact(), IsTemporarilyStatic, IterationParameters, ParticleParameters);
 				}
 
-			}, bDisableCollisionParallelFor);
+			}, bDisableCollisionParallelFor || InConstraintHandles.Num() < CollisionParallelColorMinConstraints);
 		}
 
 		if (PostApplyPushOutCallback != nullptr)
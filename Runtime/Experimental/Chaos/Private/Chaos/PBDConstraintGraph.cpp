@@ -651,107 +651,41 @@ bool FPBDConstraintGraph::ComputeIsland(const int32 InNode, const int32 Island,
 	return bIslandNeedsToResim;
 }
 
-bool FPBDConstraintGraph::SleepInactive(const int32 Island, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials)
+bool FPBDConstraintGraph::IsSleepEnabled()
 {
-	if (!ChaosSolverSleepEnabled)
-	{
-		return false;
-	}
-
-	FReal LinearSleepingThreshold = FLT_MAX;
-	FReal AngularSleepingThreshold = FLT_MAX;
-	int32 SleepCounterThreshold = 0;
-
-	const TArray<TGeometryParticleHandle<FReal, 3>*>& IslandParticles = GetIslandParticles(Island);
-	check(IslandParticles.Num());
+	return ChaosSolverSleepEnabled;
+}
 
-	if (!IslandToData[Island].bIsIslandPersistant)
+void FPBDConstraintGraph::GetSleepThresholds(const TPBDRigidParticleHandle<FReal, 3>* PBDRigid, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials, FReal& OutLinearThreshold, FReal& OutAngularThreshold, int32& OutCounterThreshold)
+{
+	if (TSerializablePtr<FChaosPhysicsMaterial> PhysicsMaterial = PBDRigid->AuxilaryValue(PerParticleMaterialAttributes))
 	{
-		return false;
+		OutLinearThreshold = PhysicsMaterial->SleepingLinearThreshold;
+		OutAngularThreshold = PhysicsMaterial->SleepingAngularThreshold;
+		OutCounterThreshold = PhysicsMaterial->SleepCounterThreshold;
+		return;
 	}
-
-	int32& IslandSleepCount = IslandToSleepCount[Island];
-
-	FReal MaxLinearSpeed2 = 0.f;
-	FReal MaxAngularSpeed2 = 0.f;
-	int32 NumDynamicParticles = 0;
-
-	for (TGeometryParticleHandle<FReal, 3>* Particle : IslandParticles)
+	
+	if (PBDRigid->ShapesArray().Num())
 	{
-		if (TPBDRigidParticleHandle<FReal, 3>* PBDRigid = Particle->CastToRigidParticle())
+		if (FPerShapeData* PerShapeData = PBDRigid->ShapesArray()[0].Get())
 		{
-			if (PBDRigid->ObjectState() == EObjectStateType::Dynamic)
+			if (PerShapeData->GetMaterials().Num())
 			{
-				NumDynamicParticles++;
-
-				const FReal LinearSpeed2 = PBDRigid->VSmooth().SizeSquared();
-				MaxLinearSpeed2 = FMath::Max(LinearSpeed2,MaxLinearSpeed2);
-
-				const FReal AngularSpeed2 = PBDRigid->WSmooth().SizeSquared();
-				MaxAngularSpeed2 = FMath::Max(AngularSpeed2,MaxAngularSpeed2);
-
-				bool bThresholdsSet = false;
-				if (TSerializablePtr<FChaosPhysicsMaterial> PhysicsMaterial = Particle->AuxilaryValue(PerParticleMaterialAttributes))
-				{
-					LinearSleepingThreshold = FMath::Min(LinearSleepingThreshold, PhysicsMaterial->SleepingLinearThreshold);
-					AngularSleepingThreshold = FMath::Min(AngularSleepingThreshold, PhysicsMaterial->SleepingAngularThreshold);
-					SleepCounterThreshold = FMath::Max(SleepCounterThreshold, PhysicsMaterial->SleepCounterThreshold);
-					bThresholdsSet = true;
-				}
-				else if (PBDRigid->ShapesArray().Num())
-				{
-					if (FPerShapeData* PerShapeData = PBDRigid->ShapesArray()[0].Get())
-					{
-						if (PerShapeData->GetMaterials().Num())
-						{
-							if (FChaosPhysicsMaterial* Material = SolverPhysicsMaterials.Get(PBDRigid->ShapesArray()[0].Get()->GetMaterials()[0].InnerHandle))
-							{
-								LinearSleepingThreshold = FMath::Min(LinearSleepingThreshold, Material->SleepingLinearThreshold);
-								AngularSleepingThreshold = FMath::Min(AngularSleepingThreshold, Material->SleepingAngularThreshold);
-								SleepCounterThreshold = FMath::Max(SleepCounterThreshold, Material->SleepCounterThreshold);
-								bThresholdsSet = true;
-							}
-						}
-					}
-				}
-
-				if (!bThresholdsSet)
+				if (FChaosPhysicsMaterial* Material = SolverPhysicsMaterials.Get(PerShapeData->GetMaterials()[0].InnerHandle))
 				{
-					LinearSleepingThreshold = FMath::Min(LinearSleepingThreshold, ChaosSolverCollisionDefaultLinearSleepThresholdCVar);
-					AngularSleepingThreshold = FMath::Min(AngularSleepingThreshold, ChaosSolverCollisionDefaultAngularSleepThresholdCVar);
-					SleepCounterThreshold = FMath::Max(SleepCounterThreshold, ChaosSolverCollisionDefaultSleepCounterThresholdCVar);
+					OutLinearThreshold = Material->SleepingLinearThreshold;
+					OutAngularThreshold = Material->SleepingAngularThreshold;
+					OutCounterThreshold = Material->SleepCounterThreshold;
+					return;
 				}
 			}
 		}
 	}
 
-	if (NumDynamicParticles == 0)
-	{
-		// prevent divide by zero - all particles much be sleeping/disabled already
-		return false;
-	}
-
-	const FReal MaxLinearSpeed = FMath::Sqrt(MaxLinearSpeed2);
-	const FReal MaxAngularSpeed = FMath::Sqrt(MaxAngularSpeed2);
-
-	if (MaxLinearSpeed < LinearSleepingThreshold && MaxAngularSpeed < AngularSleepingThreshold)
-	{
-		if (IslandSleepCount >= SleepCounterThreshold)
-		{
-			return true;
-		}
-		else
-		{
-			IslandSleepCount++;
-		}
-	}
-	else
-	{
-		//Reset sleep count since island is awake
-		IslandSleepCount = 0;
-	}
-
-	return false;
+	OutLinearThreshold = ChaosSolverCollisionDefaultLinearSleepThresholdCVar;
+	OutAngularThreshold = ChaosSolverCollisionDefaultAngularSleepThresholdCVar;
+	OutCounterThreshold = ChaosSolverCollisionDefaultSleepCounterThresholdCVar;
 }
 
 
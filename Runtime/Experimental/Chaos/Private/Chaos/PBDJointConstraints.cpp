@@ -9,6 +9,7 @@
 #include "Chaos/ParticleHandle.h"
 #include "Chaos/PBDJointConstraintUtilities.h"
 #include "Chaos/Utilities.h"
+#include "Chaos/Framework/Parallel.h"
 #include "ChaosLog.h"
 #include "ChaosStats.h"
 
@@ -920,6 +921,53 @@ namespace Chaos
 	//
 	//////////////////////////////////////////////////////////////////////////
 
+	/**
+	 * Calls SolveFunc with the constraint index of each handle, in order. Handles must be sorted by level then color.
+	 * Constraints of the same level and color share no dynamic particle, runs of at least Chaos_Joint_ParallelColorMinConstraints
+	 * of them are solved in parallel so a large island isn't solved by a single thread.
+	 * @return the number of constraints for which SolveFunc returned true
+	 */
+	template<typename SolveFuncType>
+	static int32 SolveJointsByColor(const TArray<FPBDJointConstraintHandle*>& SortedConstraintHandles, const SolveFuncType& SolveFunc)
+	{
+		int32 NumActive = 0;
+		const int32 NumHandles = SortedConstraintHandles.Num();
+		int32 RunBegin = 0;
+		while (RunBegin < NumHandles)
+		{
+			const int32 Level = SortedConstraintHandles[RunBegin]->GetConstraintLevel();
+			const int32 Color = SortedConstraintHandles[RunBegin]->GetConstraintColor();
+			int32 RunEnd = RunBegin + 1;
+			while ((RunEnd < NumHandles) && (SortedConstraintHandles[RunEnd]->GetConstraintLevel() == Level) && (SortedConstraintHandles[RunEnd]->GetConstraintColor() == Color))
+			{
+				++RunEnd;
+			}
+
+			// Uncolored constraints, e.g. enabled again since the last coloring, may share particles
+			const int32 RunNum = RunEnd - RunBegin;
+			if ((Color != INDEX_NONE) && (Chaos_Joint_ParallelColorMinConstraints > 0) && (RunNum >= Chaos_Joint_ParallelColorMinConstraints))
+			{
+				PhysicsParallelFor(RunNum, [&SortedConstraintHandles, &SolveFunc, &NumActive, RunBegin](int32 RunIndex)
+				{
+					if (SolveFunc(SortedConstraintHandles[RunBegin + RunIndex]->GetConstraintIndex()))
+					{
+						FPlatformAtomics::InterlockedIncrement(&NumActive);
+					}
+				});
+			}
+			else
+			{
+				for (int32 HandleIndex = RunBegin; HandleIndex < RunEnd; ++HandleIndex)
+				{
+					NumActive += SolveFunc(SortedConstraintHandles[HandleIndex]->GetConstraintIndex()) ? 1 : 0;
+				}
+			}
+
+			RunBegin = RunEnd;
+		}
+		return NumActive;
+	}
+
 	bool FPBDJointConstraints::Apply(const FReal Dt, const TArray<FConstraintContainerHandle*>& InConstraintHandles, const int32 It, const int32 NumIts)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Joints_Apply);
@@ -933,8 +981,12 @@ namespace Chaos
 		TArray<FConstraintContainerHandle*> SortedConstraintHandles = InConstraintHandles;
 		SortedConstraintHandles.Sort([](const FConstraintContainerHandle& L, const FConstraintContainerHandle& R)
 			{
-				// Sort bodies from root to leaf
-				return L.GetConstraintLevel() < R.GetConstraintLevel();
+				// Sort bodies from root to leaf, then by color so constraints that can be solved in parallel are contiguous
+				if (L.GetConstraintLevel() != R.GetConstraintLevel())
+				{
+					return L.GetConstraintLevel() < R.GetConstraintLevel();
+				}
+				return L.GetConstraintColor() < R.GetConstraintColor();
 			});
 
 		if (PreApplyCallback != nullptr)
@@ -946,10 +998,10 @@ namespace Chaos
 		int32 NumActive = 0;
 		if (Settings.ApplyPairIterations > 0)
 		{
-			for (FConstraintContainerHandle* ConstraintHandle : SortedConstraintHandles)
-			{
-				NumActive += ApplySingle(Dt, ConstraintHandle->GetConstraintIndex(), Settings.ApplyPairIterations, It, NumIts);
-			}
+			NumActive = SolveJointsByColor(SortedConstraintHandles, [this, Dt, It, NumIts](int32 ConstraintIndex)
+				{
+					return ApplySingle(Dt, ConstraintIndex, Settings.ApplyPairIterations, It, NumIts);
+				});
 		}
 
 		if (PostApplyCallback != nullptr)
@@ -968,17 +1020,21 @@ namespace Chaos
 		TArray<FConstraintContainerHandle*> SortedConstraintHandles = InConstraintHandles;
 		SortedConstraintHandles.Sort([](const FConstraintContainerHandle& L, const FConstraintContainerHandle& R)
 			{
-				// Sort bodies from root to leaf
-				return L.GetConstraintLevel() < R.GetConstraintLevel();
+				// Sort bodies from root to leaf, then by color so constraints that can be solved in parallel are contiguous
+				if (L.GetConstraintLevel() != R.GetConstraintLevel())
+				{
+					return L.GetConstraintLevel() < R.GetConstraintLevel();
+				}
+				return L.GetConstraintColor() < R.GetConstraintColor();
 			});
 
 		int32 NumActive = 0;
 		if (Settings.ApplyPushOutPairIterations > 0)
 		{
-			for (FConstraintContainerHandle* ConstraintHandle : SortedConstraintHandles)
-			{
-				NumActive += ApplyPushOutSingle(Dt, ConstraintHandle->GetConstraintIndex(), Settings.ApplyPushOutPairIterations, It, NumIts);
-			}
+			NumActive = SolveJointsByColor(SortedConstraintHandles, [this, Dt, It, NumIts](int32 ConstraintIndex)
+				{
+					return ApplyPushOutSingle(Dt, ConstraintIndex, Settings.ApplyPushOutPairIterations, It, NumIts);
+				});
 		}
 
 		if (PostProjectCallback != nullptr)
@@ -1498,7 +1554,12 @@ namespace Chaos
 		// Set the constraint colors
 		for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints(); ++ConstraintIndex)
 		{
-			if ( ConstraintStates[ConstraintIndex].bDisabled) continue;
+			if (ConstraintStates[ConstraintIndex].bDisabled)
+			{
+				// Not part of the graph, an old color could be shared with constraints on the same particles if enabled again
+				ConstraintStates[ConstraintIndex].Color = INDEX_NONE;
+				continue;
+			}
 
 			int32 VertexIndex = ConstraintVertices[ConstraintIndex];
 			ConstraintStates[ConstraintIndex].Island = Graph.GetVertexIsland(VertexIndex);
@@ -6,6 +6,7 @@
 #include "Chaos/PBDRigidsEvolutionGBF.h"
 #include "Chaos/ParticleHandle.h"
 #include "Chaos/SpatialAccelerationCollection.h"
+#include "Chaos/DynamicAABBTree.h"
 
 int32 ChaosRigidsEvolutionApplyAllowEarlyOutCVar = 1;
 FAutoConsoleVariableRef CVarChaosRigidsEvolutionApplyAllowEarlyOut(TEXT("p.ChaosRigidsEvolutionApplyAllowEarlyOut"), ChaosRigidsEvolutionApplyAllowEarlyOutCVar, TEXT("Allow Chaos Rigids Evolution apply iterations to early out when resolved.[def:1]"));
@@ -34,6 +35,7 @@ namespace Chaos
 		int32 AABBMaxTreeDepth;
 		float MaxPayloadSize;
 		int32 IterationsPerTimeSlice;
+		float DynamicTreeBoundsMargin;
 
 		FAccelerationConfig()
 		{
@@ -45,6 +47,7 @@ namespace Chaos
 			AABBMaxTreeDepth = 200;
 			MaxPayloadSize = 100000;
 			IterationsPerTimeSlice = 4000;
+			DynamicTreeBoundsMargin = 10;
 		}
 	} ConfigSettings;
 
@@ -56,6 +59,7 @@ namespace Chaos
 	FAutoConsoleVariableRef CVarAABBMaxTreeDepth(TEXT("p.AABBMaxTreeDepth"), ConfigSettings.AABBMaxTreeDepth, TEXT(""));
 	FAutoConsoleVariableRef CVarMaxPayloadSize(TEXT("p.MaxPayloadSize"), ConfigSettings.MaxPayloadSize, TEXT(""));
 	FAutoConsoleVariableRef CVarIterationsPerTimeSlice(TEXT("p.IterationsPerTimeSlice"), ConfigSettings.IterationsPerTimeSlice, TEXT(""));
+	FAutoConsoleVariableRef CVarDynamicTreeBoundsMargin(TEXT("p.DynamicTreeBoundsMargin"), ConfigSettings.DynamicTreeBoundsMargin, TEXT("Margin added to the bounds of the elements of the dynamic AABB tree (p.BroadphaseType 5). Elements moving within their enlarged bounds don't update the tree."));
 
 	struct FDefaultCollectionFactory : public ISpatialAccelerationCollectionFactory
 	{
@@ -64,13 +68,14 @@ namespace Chaos
 		using BVType = TBoundingVolume<TAccelerationStructureHandle<FReal, 3>, FReal, 3>;
 		using AABBTreeType = TAABBTree<TAccelerationStructureHandle<FReal, 3>, TAABBTreeLeafArray<TAccelerationStructureHandle<FReal, 3>, FReal>, FReal>;
 		using AABBTreeOfGridsType = TAABBTree<TAccelerationStructureHandle<FReal, 3>, TBoundingVolume<TAccelerationStructureHandle<FReal, 3>, FReal, 3>, FReal>;
+		using DynamicAABBTreeType = TDynamicAABBTree<TAccelerationStructureHandle<FReal, 3>, FReal>;
 
 		TUniquePtr<ISpatialAccelerationCollection<TAccelerationStructureHandle<FReal, 3>, FReal, 3>> CreateEmptyCollection() override
 		{
 			TConstParticleView<FSpatialAccelerationCache> Empty;
 
 			const uint16 NumBuckets = ConfigSettings.BroadphaseType >= 3 ? 2 : 1;
-			auto Collection = new TSpatialAccelerationCollection<AABBTreeType, BVType, AABBTreeOfGridsType>();
+			auto Collection = new TSpatialAccelerationCollection<AABBTreeType, BVType, AABBTreeOfGridsType, DynamicAABBTreeType>();
 
 			for (uint16 BucketIdx = 0; BucketIdx < NumBuckets; ++BucketIdx)
 			{
@@ -107,11 +112,16 @@ namespace Chaos
 					// AABBTreeOfGridsType
 					return true;
 				}
+				else if (ConfigSettings.BroadphaseType == 5)
+				{
+					// DynamicAABBTreeType
+					return false;
+				}
 			}
 			case 1:
 			{
 				// BVType
-				ensure(ConfigSettings.BroadphaseType == 3 || ConfigSettings.BroadphaseType == 4);
+				ensure(ConfigSettings.BroadphaseType >= 3);
 				return false;
 			}
 			default:
@@ -141,10 +151,14 @@ namespace Chaos
 				{
 					return MakeUnique<AABBTreeOfGridsType>(Particles, ConfigSettings.AABBMaxChildrenInLeaf, ConfigSettings.AABBMaxTreeDepth, ConfigSettings.MaxPayloadSize);
 				}
+				else if (ConfigSettings.BroadphaseType == 5)
+				{
+					return MakeUnique<DynamicAABBTreeType>(Particles, ConfigSettings.DynamicTreeBoundsMargin, ConfigSettings.MaxPayloadSize);
+				}
 			}
 			case 1:
 			{
-				ensure(ConfigSettings.BroadphaseType == 3 || ConfigSettings.BroadphaseType == 4);
+				ensure(ConfigSettings.BroadphaseType >= 3);
 				return MakeUnique<BVType>(Particles, false, 0, ConfigSettings.BVNumCells, ConfigSettings.MaxPayloadSize);
 			}
 			default:
@@ -155,6 +169,12 @@ namespace Chaos
 			}
 		}
 
+		virtual bool IsBucketIncremental(uint16 BucketIdx) const override
+		{
+			// The dynamic tree is kept up to date by the pending operations, it never needs to be rebuilt
+			return BucketIdx == 0 && ConfigSettings.BroadphaseType == 5;
+		}
+
 		virtual void Serialize(TUniquePtr<ISpatialAccelerationCollection<TAccelerationStructureHandle<FReal, 3>, FReal, 3>>& Ptr, FChaosArchive& Ar) override
 		{
 			if (Ar.IsLoading())
@@ -275,7 +295,7 @@ namespace Chaos
 	}
 
 	template <typename Traits>
-	void TPBDRigidsEvolutionBase<Traits>::FChaosAccelerationStructureTask::UpdateStructure(FAccelerationStructure* AccelerationStructure)
+	void TPBDRigidsEvolutionBase<Traits>::FChaosAccelerationStructureTask::UpdateStructure(FAccelerationStructure* AccelerationStructure, bool bAllowIncremental)
 	{
 		LLM_SCOPE(ELLMTag::ChaosAcceleration);
 
@@ -292,7 +312,12 @@ namespace Chaos
 			const FSpatialAccelerationIdx SpatialIdx = Itr.Key;
 			const FSpatialAccelerationCache& Cache = *Itr.Value;
 			const uint8 BucketIdx = (1 << SpatialIdx.Bucket) & ActiveBucketsMask ? SpatialIdx.Bucket : 0;
-			if(AccelerationStructure->GetSubstructure(SpatialIdx) && !AccelerationStructure->GetSubstructure(SpatialIdx)->IsAsyncTimeSlicingComplete())
+			if(bAllowIncremental && !IsForceFullBuild && SpatialCollectionFactory.IsBucketIncremental(BucketIdx) && AccelerationStructure->GetSubstructure(SpatialIdx))
+			{
+				//the structure received every pending operation, so it's already up to date
+				continue;
+			}
+			else if(AccelerationStructure->GetSubstructure(SpatialIdx) && !AccelerationStructure->GetSubstructure(SpatialIdx)->IsAsyncTimeSlicingComplete())
 			{
 				SCOPE_CYCLE_COUNTER(STAT_AccelerationStructureTimeSlice);
 
@@ -368,8 +393,9 @@ namespace Chaos
 		LLM_SCOPE(ELLMTag::ChaosAcceleration);
 
 		//Rebuild both structures. TODO: probably faster to time slice the copy instead of doing two time sliced builds
-		UpdateStructure(InternalStructure.Get());
-		UpdateStructure(ExternalStructure.Get());
+		//Incremental buckets of the internal structure are updated by the pending operations instead. The external structure doesn't receive the operations of every frame so it is always rebuilt
+		UpdateStructure(InternalStructure.Get(), true);
+		UpdateStructure(ExternalStructure.Get(), false);
 	}
 
 	template <typename Traits>
@@ -559,6 +585,11 @@ namespace Chaos
 
 				check(AsyncInternalAcceleration->IsAllAsyncTasksComplete());
 
+				if (SpatialCollectionFactory->HasIncrementalBuckets())
+				{
+					//the current structure becomes the next async one, incremental buckets are not rebuilt so they need this frame's operations
+					FlushInternalAccelerationQueue();
+				}
 				FlushAsyncAccelerationQueue();
 
 				//swap acceleration structure for new one
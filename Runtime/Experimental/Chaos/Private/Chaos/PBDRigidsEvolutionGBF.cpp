@@ -19,6 +19,7 @@
 #include "ProfilingDebugging/ScopedTimers.h"
 #include "Chaos/DebugDrawQueue.h"
 #include "Misc/ScopeLock.h"
+#include "Algo/StableSort.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
 
@@ -63,6 +64,56 @@ FAutoConsoleVariableRef CVarHackCCDDepthThreshold(TEXT("p.Chaos.CCD.DepthThresho
 float SmoothedPositionLerpRate = 0.1f;
 FAutoConsoleVariableRef CVarSmoothedPositionLerpRate(TEXT("p.Chaos.SmoothedPositionLerpRate"), SmoothedPositionLerpRate, TEXT("The interpolation rate for the smoothed position calculation. Used for sleeping."));
 
+int32 IslandBatchCost = 64;
+FAutoConsoleVariableRef CVarIslandBatchCost(TEXT("p.Chaos.Solver.IslandBatchCost"), IslandBatchCost, TEXT("Islands with fewer particles and constraints than this are solved together in batches of about this cost, larger islands are solved first. 0 solves each island as its own task in island order."));
+
+/**
+ * Orders islands for the parallel solve: largest first so a single big island isn't left to run alone at the end,
+ * with small islands packed into batches so each task has enough work.
+ * @param OutBatchStarts	index of the first island of each batch in OutIslands, plus the number of islands
+ */
+static void BuildIslandBatches(const FPBDConstraintGraph& ConstraintGraph, TArray<int32>& OutIslands, TArray<int32>& OutBatchStarts)
+{
+	const int32 NumIslands = ConstraintGraph.NumIslands();
+	OutIslands.SetNumUninitialized(NumIslands);
+	OutBatchStarts.Reset(NumIslands + 1);
+
+	for (int32 Island = 0; Island < NumIslands; ++Island)
+	{
+		OutIslands[Island] = Island;
+	}
+
+	if (IslandBatchCost <= 0)
+	{
+		for (int32 Island = 0; Island <= NumIslands; ++Island)
+		{
+			OutBatchStarts.Add(Island);
+		}
+		return;
+	}
+
+	TArray<int32> IslandCosts;
+	IslandCosts.SetNumUninitialized(NumIslands);
+	for (int32 Island = 0; Island < NumIslands; ++Island)
+	{
+		IslandCosts[Island] = ConstraintGraph.GetIslandParticles(Island).Num() + ConstraintGraph.GetIslandConstraintData(Island).Num();
+	}
+
+	// Stable so the order of islands of the same cost, and therefore of the solve, doesn't change between runs
+	Algo::StableSort(OutIslands, [&IslandCosts](int32 A, int32 B) { return IslandCosts[A] > IslandCosts[B]; });
+
+	int32 BatchCost = IslandBatchCost;
+	for (int32 Index = 0; Index < NumIslands; ++Index)
+	{
+		if (BatchCost >= IslandBatchCost)
+		{
+			OutBatchStarts.Add(Index);
+			BatchCost = 0;
+		}
+		BatchCost += IslandCosts[OutIslands[Index]];
+	}
+	OutBatchStarts.Add(NumIslands);
+}
 
 DECLARE_CYCLE_STAT(TEXT("TPBDRigidsEvolutionGBF::AdvanceOneTimeStep"), STAT_Evolution_AdvanceOneTimeStep, STATGROUP_Chaos);
 DECLARE_CYCLE_STAT(TEXT("TPBDRigidsEvolutionGBF::UnclusterUnions"), STAT_Evolution_UnclusterUnions, STATGROUP_Chaos);
@@ -374,10 +425,16 @@ void TPBDRigidsEvolutionGBF<Traits>::AdvanceOneTimeStepImpl(const FReal Dt,const
 	TArray<TArray<TPBDRigidParticleHandle<FReal, 3>*>> DisabledParticles;
 	DisabledParticles.SetNum(GetConstraintGraph().NumIslands());
 	SleepedIslands.SetNum(GetConstraintGraph().NumIslands());
+	IslandSleepManager.BeginStep(GetConstraintGraph());
 	if(Dt > 0)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Evolution_ParallelSolve);
-		PhysicsParallelFor(GetConstraintGraph().NumIslands(), [&](int32 Island) {
+
+		TArray<int32> IslandOrder;
+		TArray<int32> IslandBatchStarts;
+		BuildIslandBatches(GetConstraintGraph(), IslandOrder, IslandBatchStarts);
+
+		auto SolveIsland = [&](int32 Island) {
 			
 			if(auto* ResimCache = GetCurrentStepResimCache())
 			{
@@ -448,7 +505,14 @@ void TPBDRigidsEvolutionGBF<Traits>::AdvanceOneTimeStepImpl(const FReal Dt,const
 			}
 
 			// Turn off if not moving
-			SleepedIslands[Island] = GetConstraintGraph().SleepInactive(Island, PhysicsMaterials, SolverPhysicsMaterials);
+			SleepedIslands[Island] = IslandSleepManager.EvaluateIsland(GetConstraintGraph(), Island, PhysicsMaterials, SolverPhysicsMaterials);
+		};
+
+		PhysicsParallelFor(IslandBatchStarts.Num() - 1, [&](int32 Batch) {
+			for (int32 Index = IslandBatchStarts[Batch]; Index < IslandBatchStarts[Batch + 1]; ++Index)
+			{
+				SolveIsland(IslandOrder[Index]);
+			}
 		});
 	}
 
@@ -459,6 +523,7 @@ void TPBDRigidsEvolutionGBF<Traits>::AdvanceOneTimeStepImpl(const FReal Dt,const
 
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Evolution_DeactivateSleep);
+		IslandSleepManager.EndStep(GetConstraintGraph(), SleepedIslands);
 		for (int32 Island = 0; Island < GetConstraintGraph().NumIslands(); ++Island)
 		{
 			if (SleepedIslands[Island])
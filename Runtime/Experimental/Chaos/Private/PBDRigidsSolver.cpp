@@ -435,6 +435,12 @@ namespace Chaos
 		// mark proxy timestamp so we avoid trying to pull from sim after deletion
 		GTParticle->GetProxy()->SetSyncTimestamp(MarshallingManager.GetExternalTimestamp_External());
 
+		// results of steps in flight must not refer to the proxy once it is deleted
+		if (IsUsingAsyncResults())
+		{
+			MarshallingManager.RemoveProxyFromPullData_External(InProxy);
+		}
+
 		// Null out the particle's proxy pointer
 		GTParticle->SetProxy(nullptr);
 
@@ -1069,10 +1075,53 @@ namespace Chaos
 		if(HasActiveParticles())
 		{
 			EventPreBuffer.Broadcast(MLastDt);
-			GetDirtyParticlesBuffer()->CaptureSolverData(this);
-			BufferPhysicsResults();
-			FlipBuffers();
+			if(IsUsingAsyncResults())
+			{
+				//the external thread may be reading the results buffers at any time
+				BufferAsyncPhysicsResults();
+			}
+			else
+			{
+				GetDirtyParticlesBuffer()->CaptureSolverData(this);
+				BufferPhysicsResults();
+				FlipBuffers();
+			}
+		}
+	}
+
+	template <typename Traits>
+	void TPBDRigidsSolver<Traits>::BufferAsyncPhysicsResults()
+	{
+		FPullPhysicsData* PullData = MarshallingManager.GetProducerPullData_Internal();
+
+		TParticleView<TPBDRigidParticles<float, 3>>& DirtyParticles = GetParticles().GetDirtyParticlesView();
+		for (Chaos::TPBDRigidParticleHandleImp<float, 3, false>& DirtyParticle : DirtyParticles)
+		{
+			if (DirtyParticle.GetParticleType() != Chaos::EParticleType::Rigid)
+			{
+				// Geometry collections and joints are only synced in synchronous mode
+				continue;
+			}
+
+			if (const TSet<IPhysicsProxyBase*>* Proxies = GetProxies(DirtyParticle.Handle()))
+			{
+				for (IPhysicsProxyBase* Proxy : *Proxies)
+				{
+					if (Proxy != nullptr && Proxy->GetType() == EPhysicsProxyType::SingleRigidParticleType)
+					{
+						FDirtyRigidParticleData& RigidData = PullData->DirtyRigids.AddDefaulted_GetRef();
+						RigidData.Proxy = Proxy;
+						RigidData.X = DirtyParticle.X();
+						RigidData.R = DirtyParticle.R();
+						RigidData.V = DirtyParticle.V();
+						RigidData.W = DirtyParticle.W();
+						RigidData.ObjectState = DirtyParticle.ObjectState();
+					}
+				}
+			}
 		}
+
+		EventPostSolve.Broadcast(MLastDt);
 	}
 
 	template <typename Traits>
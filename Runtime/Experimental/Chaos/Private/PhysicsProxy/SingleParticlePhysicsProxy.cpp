@@ -11,6 +11,7 @@
 #include "Chaos/PerParticleGravity.h"
 #include "Chaos/ParticleHandle.h"
 #include "Chaos/Framework/MultiBufferResource.h"
+#include "Chaos/ChaosMarshallingManager.h"
 #include "PhysicsSolver.h"
 
 template< class PARTICLE_TYPE >
@@ -297,6 +298,26 @@ bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::PullFromPh
 	return bSync;
 }
 
+template< >
+bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::PullFromPhysicsState(const Chaos::FDirtyRigidParticleData& PullData, const int32 SolverSyncTimestamp)
+{
+	// Same as above, but from the results of an async step rather than the double buffer.
+	const bool bSync = SyncTimestamp <= SolverSyncTimestamp;
+	if (bSync && Particle)
+	{
+		Particle->SetX(PullData.X, false);
+		Particle->SetR(PullData.R, false);
+		Particle->SetV(PullData.V, false);
+		Particle->SetW(PullData.W, false);
+		Particle->UpdateShapeBounds();
+		if (!Particle->IsDirty(Chaos::EParticleFlags::DynamicMisc))
+		{
+			Particle->SetObjectState(PullData.ObjectState, true, /*bInvalidate=*/false);
+		}
+	}
+	return bSync;
+}
+
 template< >
 bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::IsDirty()
 {
@@ -253,6 +253,27 @@ struct FPushPhysicsData
 	void Reset();
 };
 
+/** The state of a rigid particle at the end of an internal step */
+struct FDirtyRigidParticleData
+{
+	IPhysicsProxyBase* Proxy;
+	FVec3 X;
+	FRotation3 R;
+	FVec3 V;
+	FVec3 W;
+	EObjectStateType ObjectState;
+};
+
+/** The results of an internal step that gets marshaled from PT to GT when using async results */
+struct FPullPhysicsData
+{
+	TArray<FDirtyRigidParticleData> DirtyRigids;
+	FReal ExternalEndTime;	//the external time the step ended at
+	int32 ExternalTimestamp;	//the latest external timestamp consumed by the step
+
+	void Reset();
+};
+
 /** Manages data that gets marshaled from GT to PT using a timestamp
 */
 class CHAOS_API FChaosMarshallingManager
@@ -314,6 +335,34 @@ public:
 
 	/** Used to delay marshalled data. This is mainly used for testing at the moment */
 	void SetTickDelay_External(int32 InDelay) { Delay = InDelay; }
+
+	/** Skips internal time without consuming any push data, so that it is consumed by the next internal step. Should only be called by external thread */
+	void SkipInternalTime_External(FReal InternalDt) { SimTime += InternalDt; }
+
+	/** Returns the internal time the sim will be at once the dispatched steps are done. Should only be called by external thread */
+	FReal GetInternalTime_External() const { return SimTime; }
+
+	/** Grabs the pull data to write the results of the current internal step into. Should only be called by internal thread */
+	FPullPhysicsData* GetProducerPullData_Internal();
+
+	/** Hands the results of the current internal step over to the external thread. Should only be called by internal thread */
+	void FinalizePullData_Internal(FReal ExternalEndTime, int32 ExternalTimestamp);
+
+	/**
+	 * Gathers the results of the internal steps completed so far. Results that ended at or before ResultsTime are returned in OutCommittedData
+	 * in step order and must be freed by the caller. The first result that ends after ResultsTime is kept for the next call and returned in OutNextData,
+	 * with OutAlpha being how far ResultsTime is between the last committed result and it. Should only be called by external thread
+	 */
+	void GatherPullData_External(FReal ResultsTime, TArray<FPullPhysicsData*>& OutCommittedData, const FPullPhysicsData*& OutNextData, FReal& OutAlpha);
+
+	/** Frees the pull data back into the pool. Should only be called by external thread */
+	void FreePullData_External(FPullPhysicsData* PullData);
+
+	/** Frees all the pull data not gathered yet. The internal thread must not be running. Should only be called by external thread */
+	void FreeAllPullData_External();
+
+	/** Makes sure results of steps that ran before the proxy was deleted are not handed out anymore. Should only be called by external thread */
+	void RemoveProxyFromPullData_External(IPhysicsProxyBase* Proxy);
 	
 private:
 	FReal ExternalTime;	//the global time external thread is currently at
@@ -329,7 +378,16 @@ private:
 
 	int32 Delay;
 
+	TQueue<FPullPhysicsData*,EQueueMode::Spsc> PullDataQueue;	//results of the internal steps, pushed from internal thread in step order
+	TQueue<FPullPhysicsData*,EQueueMode::Spsc> PullDataPool;	//pool to grab more pull data from, freed by external thread
+	TArray<TUniquePtr<FPullPhysicsData>> PullBackingBuffer;	//all pull data is cleaned up by this. Only grown by internal thread
+	FPullPhysicsData* ProducerPullData;	//the pull data of the internal step in progress
+	FPullPhysicsData* NextPullData;	//the oldest result not committed yet on the external thread
+	FReal CommittedPullTime;	//the external end time of the last result committed on the external thread
+	TMap<IPhysicsProxyBase*, int32> RemovedPullProxies;	//proxies removed on external thread, with the timestamp of their removal
+
 	void PrepareExternalQueue();
+	void FilterRemovedProxies_External(FPullPhysicsData& PullData);
 
 	FSimCallbackData* CreateCallbackData_External()
 	{
@@ -5,6 +5,8 @@
 
 namespace Chaos
 {
+	class FCollisionManifoldCache;
+
 	/**
 	 * Data passed down into the collision detection functions.
 	 */
@@ -17,6 +19,7 @@ namespace Chaos
 			, bAllowManifolds(false)
 			, bUseIncrementalManifold(false)
 			, bUseOneShotManifolds(false)
+			, ManifoldCache(nullptr)
 		{
 		}
 
@@ -33,5 +36,8 @@ namespace Chaos
 		bool bAllowManifolds;
 		bool bUseIncrementalManifold;
 		bool bUseOneShotManifolds;
+
+		// One-shot manifolds of the previous frame to restore instead of building new ones, if the shapes have not moved [default: null]
+		const FCollisionManifoldCache* ManifoldCache;
 	};
 }
\ No newline at end of file
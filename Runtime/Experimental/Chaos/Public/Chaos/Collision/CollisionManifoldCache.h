@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/Core.h"
+#include "Chaos/GeometryParticlesfwd.h"
+#include "Chaos/ParticleHandleFwd.h"
+#include "Chaos/Transform.h"
+#include "Chaos/Collision/PBDCollisionConstraint.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+
+namespace Chaos
+{
+	class FImplicitObject;
+
+	/**
+	 * The one-shot contact manifolds of the previous frame, keyed by particle pair and shape pair.
+	 *
+	 * Collision constraints are recreated by the narrow phase every frame. When the shapes of a pair have barely
+	 * moved relative to each other since its manifold was built, the manifold is still valid and the narrow phase
+	 * restores it instead of running the one-shot manifold generation again. This is the common case for resting
+	 * stacks of objects. The net impulses of the restored manifold points are kept to warm start the velocity solve.
+	 *
+	 * The cache is captured serially from the constraint container before it is reset, and only read during the
+	 * (parallel) narrow phase.
+	 */
+	class CHAOS_API FCollisionManifoldCache
+	{
+	public:
+		/** Removes all cached manifolds */
+		void Reset();
+
+		/** Replaces the cached manifolds with the one-shot manifolds of the constraints */
+		void Capture(const TArray<FRigidBodyPointContactConstraint>& Constraints);
+
+		/**
+		 * Copies the cached manifold of the constraint's particle and shape pair into the constraint, if the relative transform
+		 * of the shapes is still within the tolerances of the one the manifold was built with.
+		 * @return true if the manifold was restored
+		 */
+		bool Restore(FRigidBodyPointContactConstraint& Constraint, const FRigidTransform3& WorldTransform0, const FRigidTransform3& WorldTransform1) const;
+
+		/** Removes the manifolds involving any of the particles */
+		void RemoveParticles(const TSet<TGeometryParticleHandle<FReal, 3>*>& ParticleHandles);
+
+		int32 Num() const { return Entries.Num(); }
+
+	private:
+		struct FKey
+		{
+			FUniqueIdx ParticleIdx[2];
+			const FImplicitObject* Implicit[2];
+
+			bool operator==(const FKey& Other) const
+			{
+				return ParticleIdx[0] == Other.ParticleIdx[0] && ParticleIdx[1] == Other.ParticleIdx[1] && Implicit[0] == Other.Implicit[0] && Implicit[1] == Other.Implicit[1];
+			}
+
+			friend uint32 GetTypeHash(const FKey& Key)
+			{
+				uint32 Hash = HashCombine(GetTypeHash(Key.ParticleIdx[0]), GetTypeHash(Key.ParticleIdx[1]));
+				Hash = HashCombine(Hash, ::GetTypeHash(Key.Implicit[0]));
+				return HashCombine(Hash, ::GetTypeHash(Key.Implicit[1]));
+			}
+		};
+
+		struct FEntry
+		{
+			/** Transform of the second shape relative to the first one when the manifold was built */
+			FRigidTransform3 RelativeTransform;
+			int32 FirstPoint;
+			int32 NumPoints;
+		};
+
+		static FKey MakeKey(const FRigidBodyPointContactConstraint& Constraint);
+
+		/** Manifold index of each particle and shape pair */
+		TMap<FKey, int32> Entries;
+		TArray<FEntry> Manifolds;
+		/** Manifold points of all the manifolds, kept in a single array to reuse the allocation every frame */
+		TArray<FManifoldPoint> ManifoldPoints;
+	};
+}
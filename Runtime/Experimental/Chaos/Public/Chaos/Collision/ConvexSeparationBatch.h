@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/Core.h"
+#include "Chaos/Transform.h"
+
+namespace Chaos
+{
+	class FImplicitObject;
+
+	/**
+	 * A batch of convex shape pairs stored as structure of arrays, used to cull separated pairs
+	 * before running the scalar GJK/EPA narrow phase on them.
+	 *
+	 * Each shape is reduced to a world-space center, three axes scaled by the half extents and a radius,
+	 * which represents spheres and capsules exactly and any other convex by its oriented local bounds.
+	 * The support distance of such a shape along a direction only needs dot products, so the separation
+	 * of all pairs along their center axis is evaluated several pairs at a time (ISPC when available).
+	 * The separation along any axis is a lower bound of the distance between the shapes.
+	 */
+	class CHAOS_API FConvexSeparationBatch
+	{
+	public:
+		FConvexSeparationBatch()
+			: NumPairs(0)
+			, MaxPairs(0)
+		{
+		}
+
+		/** Removes all pairs and makes room for MaxPairs */
+		void Reset(int32 InMaxPairs);
+
+		/**
+		 * Adds a pair of shapes, with their world space transforms.
+		 * @return false if either shape has no bounds, in which case the pair has no separation to test
+		 */
+		bool Add(const FImplicitObject& Implicit0, const FRigidTransform3& Transform0, const FImplicitObject& Implicit1, const FRigidTransform3& Transform1);
+
+		/** Computes a lower bound of the distance between the shapes of every pair, negative if they may overlap */
+		void ComputeSeparations(TArray<FReal>& OutSeparations) const;
+
+		int32 Num() const { return NumPairs; }
+
+		bool IsFull() const { return NumPairs == MaxPairs; }
+
+	private:
+		/** Float streams of a shape, each stream holds MaxPairs values */
+		enum EStream
+		{
+			CenterX, CenterY, CenterZ,
+			Axis0X, Axis0Y, Axis0Z,
+			Axis1X, Axis1Y, Axis1Z,
+			Axis2X, Axis2Y, Axis2Z,
+			Radius,
+			NumStreams
+		};
+
+		bool AddShape(int32 Shape, int32 PairIndex, const FImplicitObject& Implicit, const FRigidTransform3& Transform);
+
+		void SetAxis(int32 Shape, int32 FirstStream, int32 PairIndex, const FVec3& Axis)
+		{
+			float* Data = Streams[Shape].GetData() + PairIndex;
+			Data[FirstStream * MaxPairs] = Axis.X;
+			Data[(FirstStream + 1) * MaxPairs] = Axis.Y;
+			Data[(FirstStream + 2) * MaxPairs] = Axis.Z;
+		}
+
+		/** Streams of the first and second shapes of the pairs */
+		TArray<float> Streams[2];
+		int32 NumPairs;
+		int32 MaxPairs;
+	};
+}
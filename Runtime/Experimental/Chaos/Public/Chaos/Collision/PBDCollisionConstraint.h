@@ -277,6 +277,8 @@ namespace Chaos
 			: Base(Base::FType::SinglePoint)
 			, bUseIncrementalManifold(false)
 			, bUseOneShotManifold(false)
+			, bHasManifoldRelativeTransform(false)
+			, bWarmStartPending(false)
 		{}
 		FRigidBodyPointContactConstraint(
 			FGeometryParticleHandle* Particle0, 
@@ -293,6 +295,8 @@ namespace Chaos
 			: Base(Particle0, Implicit0, Simplicial0, Transform0, Particle1, Implicit1, Simplicial0, Transform1, Base::FType::SinglePoint, ShapesType)
 			, bUseIncrementalManifold(bInUseIncrementalManifold)
 			, bUseOneShotManifold(bInUseOneshotManifolds)
+			, bHasManifoldRelativeTransform(false)
+			, bWarmStartPending(false)
 		{}
 
 		static typename Base::FType StaticType() { return Base::FType::SinglePoint; };
@@ -321,9 +325,19 @@ namespace Chaos
 		void UpdateManifold(const FContactPoint& ContactPoint, const FReal Dt);
 		void ClearManifold();
 
+		// Transform of the second shape relative to the first one when the one-shot manifold was built (see FCollisionManifoldCache)
+		bool HasManifoldRelativeTransform() const { return bHasManifoldRelativeTransform; }
+		const FRigidTransform3& GetManifoldRelativeTransform() const { return ManifoldRelativeTransform; }
+		void SetManifoldRelativeTransform(const FRigidTransform3& InRelativeTransform) { ManifoldRelativeTransform = InRelativeTransform; bHasManifoldRelativeTransform = true; }
+
+		// Replace the manifold with one built in a previous frame. If bInWarmStart, the net impulses of the points are kept to be applied before the velocity solve
+		void RestoreOneShotManifold(TArrayView<const FManifoldPoint> InManifoldPoints, const FRigidTransform3& InRelativeTransform, bool bInWarmStart);
+		bool IsWarmStartPending() const { return bWarmStartPending; }
+		void ClearWarmStartPending() { bWarmStartPending = false; }
+
 	protected:
 		// For use by derived types that can be used as point constraints in Update
-		FRigidBodyPointContactConstraint(typename Base::FType InType) : Base(InType) {}
+		FRigidBodyPointContactConstraint(typename Base::FType InType) : Base(InType), bHasManifoldRelativeTransform(false), bWarmStartPending(false) {}
 
 		FRigidBodyPointContactConstraint(
 			FGeometryParticleHandle* Particle0, 
@@ -339,6 +353,8 @@ namespace Chaos
 			: Base(Particle0, Implicit0, Simplicial0, Transform0, Particle1, Implicit1, Simplicial1, Transform1, InType, ShapesType)
 			, bUseIncrementalManifold(false)
 			, bUseOneShotManifold(false)
+			, bHasManifoldRelativeTransform(false)
+			, bWarmStartPending(false)
 		{}
 
 		bool AreMatchingContactPoints(const FContactPoint& A, const FContactPoint& B, FReal& OutScore) const;
@@ -350,8 +366,11 @@ namespace Chaos
 
 		// @todo(chaos): inline array
 		TArray<FManifoldPoint> ManifoldPoints;
+		FRigidTransform3 ManifoldRelativeTransform;
 		bool bUseIncrementalManifold;
 		bool bUseOneShotManifold;
+		bool bHasManifoldRelativeTransform;
+		bool bWarmStartPending;
 	};
 
 
@@ -34,6 +34,8 @@ namespace Chaos
 			CollisionContainer.UpdateManifolds(Dt);
 			CollisionContainer.UpdateConstraints(Dt);
 
+			NarrowPhase.GetContext().ManifoldCache = &CollisionContainer.GetManifoldCache();
+
 			// Collision detection pipeline: BroadPhase -[parallel]-> NarrowPhase -[parallel]-> Receiver -[serial]-> Container
 			FAsyncCollisionReceiver Receiver(CollisionContainer, ResimCache);
 			BroadPhase.ProduceOverlaps(Dt, NarrowPhase, Receiver, StatData, ResimCache);
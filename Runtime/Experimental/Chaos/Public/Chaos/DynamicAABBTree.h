@@ -0,0 +1,674 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/AABB.h"
+#include "Chaos/AABBTree.h"
+#include "Chaos/ISpatialAcceleration.h"
+
+namespace Chaos
+{
+
+DECLARE_CYCLE_STAT(TEXT("DynamicAABBTreeUpdateElement"), STAT_DynamicAABBTreeUpdateElement, STATGROUP_Chaos);
+
+struct FDynamicAABBTreePayloadInfo
+{
+	int32 GlobalPayloadIdx;
+	int32 LeafIdx;
+
+	FDynamicAABBTreePayloadInfo(int32 InGlobalPayloadIdx = INDEX_NONE, int32 InLeafIdx = INDEX_NONE)
+		: GlobalPayloadIdx(InGlobalPayloadIdx)
+		, LeafIdx(InLeafIdx)
+	{}
+};
+
+template <typename TPayloadType, typename T>
+struct TDynamicAABBTreeNode
+{
+	/** Bounds of the children, or the enlarged bounds of the element for leaves */
+	TAABB<T, 3> Bounds;
+
+	/** Actual bounds of the element, leaves only */
+	TAABB<T, 3> ElementBounds;
+
+	TPayloadType Payload;
+
+	int32 Parent = INDEX_NONE;
+	int32 Children[2] = { INDEX_NONE, INDEX_NONE };
+
+	/** 0 for leaves, INDEX_NONE for nodes in the free list */
+	int32 Height = 0;
+
+	bool IsLeaf() const { return Children[0] == INDEX_NONE; }
+};
+
+/**
+ * Bounding volume hierarchy maintained incrementally, meant for moving objects.
+ *
+ * Each element is a leaf whose bounds are enlarged by a margin, so elements moving within their enlarged bounds don't
+ * change the tree. Elements leaving them are removed and reinserted next to the sibling minimizing the surface area
+ * heuristic, and the ancestors are refit with tree rotations to keep the tree balanced. Unlike TAABBTree there are no
+ * dirty elements: the tree never needs a full rebuild and queries don't have to scan the moved elements linearly.
+ */
+template <typename TPayloadType, typename T>
+class TDynamicAABBTree final : public ISpatialAcceleration<TPayloadType, T, 3>
+{
+public:
+	using PayloadType = TPayloadType;
+	static constexpr int D = 3;
+	using TType = T;
+	static constexpr T DefaultMaxPayloadBounds = 100000;
+	static constexpr T DefaultBoundsMargin = 10;
+	static constexpr ESpatialAcceleration StaticType = ESpatialAcceleration::DynamicAABBTree;
+
+	TDynamicAABBTree()
+		: ISpatialAcceleration<TPayloadType, T, 3>(StaticType)
+		, RootIdx(INDEX_NONE)
+		, BoundsMargin(DefaultBoundsMargin)
+		, MaxPayloadBounds(DefaultMaxPayloadBounds)
+	{
+	}
+
+	template <typename TParticles>
+	TDynamicAABBTree(const TParticles& Particles, T InBoundsMargin = DefaultBoundsMargin, T InMaxPayloadBounds = DefaultMaxPayloadBounds)
+		: ISpatialAcceleration<TPayloadType, T, 3>(StaticType)
+		, RootIdx(INDEX_NONE)
+		, BoundsMargin(InBoundsMargin)
+		, MaxPayloadBounds(InMaxPayloadBounds)
+	{
+		Nodes.Reserve(2 * Particles.Num());
+
+		int32 Idx = 0;
+		for (auto& Particle : Particles)
+		{
+			const bool bHasBoundingBox = HasBoundingBox(Particle);
+			const TAABB<T, 3> ElemBounds = bHasBoundingBox ? ComputeWorldSpaceBoundingBox(Particle, false, (T)0) : TAABB<T, 3>::EmptyAABB();
+			UpdateElement(Particle.template GetPayload<TPayloadType>(Idx), ElemBounds, bHasBoundingBox);
+			++Idx;
+		}
+	}
+
+	virtual ~TDynamicAABBTree() {}
+
+	virtual TUniquePtr<ISpatialAcceleration<TPayloadType, T, 3>> Copy() const override
+	{
+		return TUniquePtr<ISpatialAcceleration<TPayloadType, T, 3>>(new TDynamicAABBTree<TPayloadType, T>(*this));
+	}
+
+	virtual TArray<TPayloadType> FindAllIntersections(const TAABB<T, 3>& Box) const override
+	{
+		struct FSimpleVisitor
+		{
+			FSimpleVisitor(TArray<TPayloadType>& InResults) : CollectedResults(InResults) {}
+			bool VisitOverlap(const TSpatialVisitorData<TPayloadType>& Instance)
+			{
+				CollectedResults.Add(Instance.Payload);
+				return true;
+			}
+			bool VisitSweep(const TSpatialVisitorData<TPayloadType>& Instance, FQueryFastData& CurData)
+			{
+				check(false);
+				return true;
+			}
+			bool VisitRaycast(const TSpatialVisitorData<TPayloadType>& Instance, FQueryFastData& CurData)
+			{
+				check(false);
+				return true;
+			}
+
+			const void* GetQueryData() const { return nullptr; }
+
+			TArray<TPayloadType>& CollectedResults;
+		};
+
+		TArray<TPayloadType> Results;
+		FSimpleVisitor Collector(Results);
+		Overlap(Box, Collector);
+
+		return Results;
+	}
+
+	virtual void Raycast(const TVector<T, 3>& Start, const TVector<T, 3>& Dir, const T Length, ISpatialVisitor<TPayloadType, T>& Visitor) const override
+	{
+		TSpatialVisitor<TPayloadType, T> ProxyVisitor(Visitor);
+		Raycast(Start, Dir, Length, ProxyVisitor);
+	}
+
+	template <typename SQVisitor>
+	void Raycast(const TVector<T, 3>& Start, const TVector<T, 3>& Dir, const T Length, SQVisitor& Visitor) const
+	{
+		FQueryFastData QueryFastData(Dir, Length);
+		QueryImp<EAABBQueryType::Raycast>(Start, QueryFastData, TVector<T, 3>(), TAABB<T, 3>(), Visitor);
+	}
+
+	template <typename SQVisitor>
+	bool RaycastFast(const TVector<T, 3>& Start, FQueryFastData& CurData, SQVisitor& Visitor) const
+	{
+		return QueryImp<EAABBQueryType::Raycast>(Start, CurData, TVector<T, 3>(), TAABB<T, 3>(), Visitor);
+	}
+
+	virtual void Sweep(const TVector<T, 3>& Start, const TVector<T, 3>& Dir, const T Length, const TVector<T, 3> QueryHalfExtents, ISpatialVisitor<TPayloadType, T>& Visitor) const override
+	{
+		TSpatialVisitor<TPayloadType, T> ProxyVisitor(Visitor);
+		Sweep(Start, Dir, Length, QueryHalfExtents, ProxyVisitor);
+	}
+
+	template <typename SQVisitor>
+	void Sweep(const TVector<T, 3>& Start, const TVector<T, 3>& Dir, const T Length, const TVector<T, 3> QueryHalfExtents, SQVisitor& Visitor) const
+	{
+		FQueryFastData QueryFastData(Dir, Length);
+		QueryImp<EAABBQueryType::Sweep>(Start, QueryFastData, QueryHalfExtents, TAABB<T, 3>(), Visitor);
+	}
+
+	template <typename SQVisitor>
+	bool SweepFast(const TVector<T, 3>& Start, FQueryFastData& CurData, const TVector<T, 3> QueryHalfExtents, SQVisitor& Visitor) const
+	{
+		return QueryImp<EAABBQueryType::Sweep>(Start, CurData, QueryHalfExtents, TAABB<T, 3>(), Visitor);
+	}
+
+	virtual void Overlap(const TAABB<T, 3>& QueryBounds, ISpatialVisitor<TPayloadType, T>& Visitor) const override
+	{
+		TSpatialVisitor<TPayloadType, T> ProxyVisitor(Visitor);
+		Overlap(QueryBounds, ProxyVisitor);
+	}
+
+	template <typename SQVisitor>
+	void Overlap(const TAABB<T, 3>& QueryBounds, SQVisitor& Visitor) const
+	{
+		OverlapFast(QueryBounds, Visitor);
+	}
+
+	template <typename SQVisitor>
+	bool OverlapFast(const TAABB<T, 3>& QueryBounds, SQVisitor& Visitor) const
+	{
+		//dummy variables to reuse templated path
+		FQueryFastDataVoid VoidData;
+		return QueryImp<EAABBQueryType::Overlap>(TVector<T, 3>(), VoidData, TVector<T, 3>(), QueryBounds, Visitor);
+	}
+
+	virtual void RemoveElement(const TPayloadType& Payload) override
+	{
+		if (FDynamicAABBTreePayloadInfo* PayloadInfo = PayloadToInfo.Find(Payload))
+		{
+			if (PayloadInfo->GlobalPayloadIdx != INDEX_NONE)
+			{
+				RemoveGlobalPayload(*PayloadInfo);
+			}
+			else if (ensure(PayloadInfo->LeafIdx != INDEX_NONE))
+			{
+				RemoveLeaf(PayloadInfo->LeafIdx);
+				FreeNode(PayloadInfo->LeafIdx);
+			}
+
+			PayloadToInfo.Remove(Payload);
+		}
+	}
+
+	virtual void UpdateElement(const TPayloadType& Payload, const TAABB<T, 3>& NewBounds, bool bHasBounds) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DynamicAABBTreeUpdateElement);
+
+		FDynamicAABBTreePayloadInfo* PayloadInfo = PayloadToInfo.Find(Payload);
+		if (!PayloadInfo)
+		{
+			PayloadInfo = &PayloadToInfo.Add(Payload);
+		}
+
+		const bool bTooBig = bHasBounds && NewBounds.Extents().Max() > MaxPayloadBounds;
+		if (bHasBounds && !bTooBig)
+		{
+			if (PayloadInfo->GlobalPayloadIdx != INDEX_NONE)
+			{
+				RemoveGlobalPayload(*PayloadInfo);
+			}
+
+			int32 LeafIdx = PayloadInfo->LeafIdx;
+			if (LeafIdx != INDEX_NONE)
+			{
+				FNode& Leaf = Nodes[LeafIdx];
+				UpdateElementHelper(Leaf.Payload, Payload);
+				Leaf.ElementBounds = NewBounds;
+
+				//If we are still within the enlarged bounds, the tree doesn't change
+				if (Leaf.Bounds.Contains(NewBounds.Min()) && Leaf.Bounds.Contains(NewBounds.Max()))
+				{
+					return;
+				}
+
+				RemoveLeaf(LeafIdx);
+			}
+			else
+			{
+				LeafIdx = AllocateNode();
+				PayloadInfo->LeafIdx = LeafIdx;
+				Nodes[LeafIdx].Payload = Payload;
+				Nodes[LeafIdx].ElementBounds = NewBounds;
+			}
+
+			Nodes[LeafIdx].Bounds = TAABB<T, 3>(NewBounds).Thicken(BoundsMargin);
+			InsertLeaf(LeafIdx);
+		}
+		else
+		{
+			if (PayloadInfo->LeafIdx != INDEX_NONE)
+			{
+				RemoveLeaf(PayloadInfo->LeafIdx);
+				FreeNode(PayloadInfo->LeafIdx);
+				PayloadInfo->LeafIdx = INDEX_NONE;
+			}
+
+			const TAABB<T, 3> GlobalBounds = bTooBig ? NewBounds : TAABB<T, 3>(TVector<T, 3>(TNumericLimits<T>::Lowest()), TVector<T, 3>(TNumericLimits<T>::Max()));
+			if (PayloadInfo->GlobalPayloadIdx == INDEX_NONE)
+			{
+				PayloadInfo->GlobalPayloadIdx = GlobalPayloads.Add(FElement{ Payload, GlobalBounds });
+			}
+			else
+			{
+				GlobalPayloads[PayloadInfo->GlobalPayloadIdx].Bounds = GlobalBounds;
+				UpdateElementHelper(GlobalPayloads[PayloadInfo->GlobalPayloadIdx].Payload, Payload);
+			}
+		}
+	}
+
+	const TArray<TPayloadBoundsElement<TPayloadType, T>>& GlobalObjects() const
+	{
+		return GlobalPayloads;
+	}
+
+	/** Height of the tree, 0 if it has a single element */
+	int32 GetHeight() const
+	{
+		return RootIdx != INDEX_NONE ? Nodes[RootIdx].Height : 0;
+	}
+
+	virtual void Serialize(FChaosArchive& Ar) override
+	{
+		Ar.UsingCustomVersion(FExternalPhysicsCustomObjectVersion::GUID);
+
+		// Node indices depend on the order of the updates, serialize the elements and rebuild the tree on load instead
+		TArray<FElement> Elements;
+		if (!Ar.IsLoading())
+		{
+			for (const FNode& Node : Nodes)
+			{
+				if (Node.Height == 0)
+				{
+					Elements.Add(FElement{ Node.Payload, Node.ElementBounds });
+				}
+			}
+		}
+
+		Ar << Elements;
+		Ar << GlobalPayloads;
+		Ar << BoundsMargin;
+		Ar << MaxPayloadBounds;
+
+		if (Ar.IsLoading())
+		{
+			Nodes.Reset();
+			FreeNodes.Reset();
+			RootIdx = INDEX_NONE;
+			PayloadToInfo.Reset();
+
+			for (int32 GlobalIdx = 0; GlobalIdx < GlobalPayloads.Num(); ++GlobalIdx)
+			{
+				PayloadToInfo.Add(GlobalPayloads[GlobalIdx].Payload, FDynamicAABBTreePayloadInfo(GlobalIdx, INDEX_NONE));
+			}
+
+			for (const FElement& Element : Elements)
+			{
+				UpdateElement(Element.Payload, Element.Bounds, true);
+			}
+		}
+	}
+
+#if !UE_BUILD_SHIPPING
+	virtual void DumpStats() const override
+	{
+		UE_LOG(LogChaos, Log, TEXT("DynamicAABBTree: %d nodes (%d free), height %d, %d global elements"), Nodes.Num(), FreeNodes.Num(), GetHeight(), GlobalPayloads.Num());
+	}
+#endif
+
+private:
+
+	using FElement = TPayloadBoundsElement<TPayloadType, T>;
+	using FNode = TDynamicAABBTreeNode<TPayloadType, T>;
+
+	static TAABB<T, 3> Union(const TAABB<T, 3>& A, const TAABB<T, 3>& B)
+	{
+		TAABB<T, 3> Result(A);
+		Result.GrowToInclude(B);
+		return Result;
+	}
+
+	int32 AllocateNode()
+	{
+		if (FreeNodes.Num())
+		{
+			const int32 NodeIdx = FreeNodes.Pop(false);
+			Nodes[NodeIdx] = FNode();
+			return NodeIdx;
+		}
+		return Nodes.AddDefaulted();
+	}
+
+	void FreeNode(int32 NodeIdx)
+	{
+		Nodes[NodeIdx] = FNode();
+		Nodes[NodeIdx].Height = INDEX_NONE;
+		FreeNodes.Add(NodeIdx);
+	}
+
+	void RemoveGlobalPayload(FDynamicAABBTreePayloadInfo& PayloadInfo)
+	{
+		if (PayloadInfo.GlobalPayloadIdx + 1 < GlobalPayloads.Num())
+		{
+			auto LastGlobalPayload = GlobalPayloads.Last().Payload;
+			PayloadToInfo.FindChecked(LastGlobalPayload).GlobalPayloadIdx = PayloadInfo.GlobalPayloadIdx;
+		}
+		GlobalPayloads.RemoveAtSwap(PayloadInfo.GlobalPayloadIdx);
+		PayloadInfo.GlobalPayloadIdx = INDEX_NONE;
+	}
+
+	/** Finds the node whose pairing with the leaf adds the least surface area to the tree, using branch and bound */
+	int32 FindBestSibling(const TAABB<T, 3>& LeafBounds) const
+	{
+		struct FCandidate
+		{
+			int32 NodeIdx;
+			T InheritedCost;
+		};
+
+		const T LeafArea = LeafBounds.GetArea();
+		int32 BestSibling = RootIdx;
+		T BestCost = TNumericLimits<T>::Max();
+
+		TArray<FCandidate, TInlineAllocator<64>> Candidates;
+		Candidates.Add(FCandidate{ RootIdx, 0 });
+		while (Candidates.Num())
+		{
+			const FCandidate Candidate = Candidates.Pop(false);
+			const FNode& Node = Nodes[Candidate.NodeIdx];
+
+			// Area of the new parent, plus the area added to all ancestors of the candidate
+			const T CombinedArea = Union(Node.Bounds, LeafBounds).GetArea();
+			const T Cost = CombinedArea + Candidate.InheritedCost;
+			if (Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestSibling = Candidate.NodeIdx;
+			}
+
+			if (!Node.IsLeaf())
+			{
+				// Descending can't cost less than the leaf's own area plus the area added to this node
+				const T ChildInheritedCost = Candidate.InheritedCost + CombinedArea - Node.Bounds.GetArea();
+				if (LeafArea + ChildInheritedCost < BestCost)
+				{
+					Candidates.Add(FCandidate{ Node.Children[0], ChildInheritedCost });
+					Candidates.Add(FCandidate{ Node.Children[1], ChildInheritedCost });
+				}
+			}
+		}
+
+		return BestSibling;
+	}
+
+	void InsertLeaf(int32 LeafIdx)
+	{
+		if (RootIdx == INDEX_NONE)
+		{
+			RootIdx = LeafIdx;
+			Nodes[LeafIdx].Parent = INDEX_NONE;
+			return;
+		}
+
+		const int32 SiblingIdx = FindBestSibling(Nodes[LeafIdx].Bounds);
+		const int32 OldParentIdx = Nodes[SiblingIdx].Parent;
+		const int32 NewParentIdx = AllocateNode();
+
+		FNode& NewParent = Nodes[NewParentIdx];
+		NewParent.Parent = OldParentIdx;
+		NewParent.Children[0] = SiblingIdx;
+		NewParent.Children[1] = LeafIdx;
+
+		if (OldParentIdx != INDEX_NONE)
+		{
+			FNode& OldParent = Nodes[OldParentIdx];
+			OldParent.Children[OldParent.Children[0] == SiblingIdx ? 0 : 1] = NewParentIdx;
+		}
+		else
+		{
+			RootIdx = NewParentIdx;
+		}
+
+		Nodes[SiblingIdx].Parent = NewParentIdx;
+		Nodes[LeafIdx].Parent = NewParentIdx;
+
+		RefitAncestors(NewParentIdx);
+	}
+
+	/** Detaches the leaf from the tree, the node itself is kept */
+	void RemoveLeaf(int32 LeafIdx)
+	{
+		if (LeafIdx == RootIdx)
+		{
+			RootIdx = INDEX_NONE;
+			return;
+		}
+
+		const int32 ParentIdx = Nodes[LeafIdx].Parent;
+		const int32 GrandParentIdx = Nodes[ParentIdx].Parent;
+		const int32 SiblingIdx = Nodes[ParentIdx].Children[Nodes[ParentIdx].Children[0] == LeafIdx ? 1 : 0];
+
+		Nodes[SiblingIdx].Parent = GrandParentIdx;
+		if (GrandParentIdx != INDEX_NONE)
+		{
+			FNode& GrandParent = Nodes[GrandParentIdx];
+			GrandParent.Children[GrandParent.Children[0] == ParentIdx ? 0 : 1] = SiblingIdx;
+		}
+		else
+		{
+			RootIdx = SiblingIdx;
+		}
+
+		FreeNode(ParentIdx);
+		Nodes[LeafIdx].Parent = INDEX_NONE;
+
+		if (GrandParentIdx != INDEX_NONE)
+		{
+			RefitAncestors(GrandParentIdx);
+		}
+	}
+
+	/** Recomputes bounds and heights from NodeIdx up to the root, rotating nodes on the way */
+	void RefitAncestors(int32 NodeIdx)
+	{
+		while (NodeIdx != INDEX_NONE)
+		{
+			FNode& Node = Nodes[NodeIdx];
+			const FNode& Child0 = Nodes[Node.Children[0]];
+			const FNode& Child1 = Nodes[Node.Children[1]];
+			Node.Bounds = Union(Child0.Bounds, Child1.Bounds);
+			Node.Height = 1 + FMath::Max(Child0.Height, Child1.Height);
+
+			Rotate(NodeIdx);
+			NodeIdx = Nodes[NodeIdx].Parent;
+		}
+	}
+
+	/**
+	 * Swaps a child of the node with a grandchild under its other child if that reduces the area of that other child.
+	 * The bounds of the node itself don't change since it keeps the same descendants.
+	 */
+	void Rotate(int32 NodeIdx)
+	{
+		FNode& Node = Nodes[NodeIdx];
+		if (Node.Height < 2)
+		{
+			return;
+		}
+
+		T BestAreaDelta = 0;
+		int32 BestMovedChild = INDEX_NONE;
+		int32 BestGrandChild = INDEX_NONE;
+		for (int32 MovedChild = 0; MovedChild < 2; ++MovedChild)
+		{
+			const FNode& Moved = Nodes[Node.Children[MovedChild]];
+			const FNode& Kept = Nodes[Node.Children[1 - MovedChild]];
+			if (Kept.IsLeaf())
+			{
+				continue;
+			}
+
+			const T KeptArea = Kept.Bounds.GetArea();
+			for (int32 GrandChild = 0; GrandChild < 2; ++GrandChild)
+			{
+				// Moved takes the place of GrandChild, so Kept ends up bounding Moved and the other grandchild
+				const FNode& Remaining = Nodes[Kept.Children[1 - GrandChild]];
+				const T AreaDelta = Union(Moved.Bounds, Remaining.Bounds).GetArea() - KeptArea;
+				if (AreaDelta < BestAreaDelta)
+				{
+					BestAreaDelta = AreaDelta;
+					BestMovedChild = MovedChild;
+					BestGrandChild = GrandChild;
+				}
+			}
+		}
+
+		if (BestMovedChild == INDEX_NONE)
+		{
+			return;
+		}
+
+		const int32 MovedIdx = Node.Children[BestMovedChild];
+		const int32 KeptIdx = Node.Children[1 - BestMovedChild];
+		FNode& Kept = Nodes[KeptIdx];
+		const int32 GrandChildIdx = Kept.Children[BestGrandChild];
+		const int32 RemainingIdx = Kept.Children[1 - BestGrandChild];
+
+		Node.Children[BestMovedChild] = GrandChildIdx;
+		Nodes[GrandChildIdx].Parent = NodeIdx;
+
+		Kept.Children[BestGrandChild] = MovedIdx;
+		Nodes[MovedIdx].Parent = KeptIdx;
+		Kept.Bounds = Union(Nodes[MovedIdx].Bounds, Nodes[RemainingIdx].Bounds);
+		Kept.Height = 1 + FMath::Max(Nodes[MovedIdx].Height, Nodes[RemainingIdx].Height);
+
+		Node.Height = 1 + FMath::Max(Nodes[GrandChildIdx].Height, Kept.Height);
+	}
+
+	template <EAABBQueryType Query, typename TQueryFastData, typename SQVisitor>
+	bool QueryImp(const TVector<T, 3>& Start, TQueryFastData& CurData, const TVector<T, 3> QueryHalfExtents, const TAABB<T, 3>& QueryBounds, SQVisitor& Visitor) const
+	{
+		TVector<T, 3> TmpPosition;
+		T TOI = 0;
+		const void* QueryData = Visitor.GetQueryData();
+
+		for (const FElement& Elem : GlobalPayloads)
+		{
+			if (PrePreFilterHelper(Elem.Payload, QueryData))
+			{
+				continue;
+			}
+
+			if (TAABBTreeIntersectionHelper<T, TQueryFastData, Query>::Intersects(Start, CurData, TOI, TmpPosition, Elem.Bounds, QueryBounds, QueryHalfExtents))
+			{
+				TSpatialVisitorData<TPayloadType> VisitData(Elem.Payload, true);
+				if (!VisitElement<Query>(VisitData, CurData, Visitor))
+				{
+					return false;
+				}
+			}
+		}
+
+		if (RootIdx == INDEX_NONE)
+		{
+			return true;
+		}
+
+		struct FNodeQueueEntry
+		{
+			int32 NodeIdx;
+			T TOI;
+		};
+
+		TArray<FNodeQueueEntry, TInlineAllocator<64>> NodeStack;
+		if (TAABBTreeIntersectionHelper<T, TQueryFastData, Query>::Intersects(Start, CurData, TOI, TmpPosition, Nodes[RootIdx].Bounds, QueryBounds, QueryHalfExtents))
+		{
+			NodeStack.Add(FNodeQueueEntry{ RootIdx, TOI });
+		}
+
+		while (NodeStack.Num())
+		{
+			const FNodeQueueEntry NodeEntry = NodeStack.Pop(false);
+			if (Query != EAABBQueryType::Overlap)
+			{
+				if (NodeEntry.TOI > CurData.CurrentLength)
+				{
+					continue;
+				}
+			}
+
+			const FNode& Node = Nodes[NodeEntry.NodeIdx];
+			if (Node.IsLeaf())
+			{
+				// The node bounds are enlarged, test the element bounds before visiting it
+				if (PrePreFilterHelper(Node.Payload, QueryData))
+				{
+					continue;
+				}
+
+				if (TAABBTreeIntersectionHelper<T, TQueryFastData, Query>::Intersects(Start, CurData, TOI, TmpPosition, Node.ElementBounds, QueryBounds, QueryHalfExtents))
+				{
+					TSpatialVisitorData<TPayloadType> VisitData(Node.Payload, true, Node.ElementBounds);
+					if (!VisitElement<Query>(VisitData, CurData, Visitor))
+					{
+						return false;
+					}
+				}
+			}
+			else
+			{
+				for (const int32 ChildIdx : Node.Children)
+				{
+					if (TAABBTreeIntersectionHelper<T, TQueryFastData, Query>::Intersects(Start, CurData, TOI, TmpPosition, Nodes[ChildIdx].Bounds, QueryBounds, QueryHalfExtents))
+					{
+						NodeStack.Add(FNodeQueueEntry{ ChildIdx, TOI });
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	template <EAABBQueryType Query, typename TQueryFastData, typename SQVisitor>
+	static bool VisitElement(const TSpatialVisitorData<TPayloadType>& VisitData, TQueryFastData& CurData, SQVisitor& Visitor)
+	{
+		if (Query == EAABBQueryType::Overlap)
+		{
+			return Visitor.VisitOverlap(VisitData);
+		}
+		return Query == EAABBQueryType::Sweep ? Visitor.VisitSweep(VisitData, CurData) : Visitor.VisitRaycast(VisitData, CurData);
+	}
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	int32 RootIdx;
+
+	TArray<FElement> GlobalPayloads;
+	TArrayAsMap<TPayloadType, FDynamicAABBTreePayloadInfo> PayloadToInfo;
+
+	/** Margin added to the bounds of the leaves */
+	T BoundsMargin;
+	T MaxPayloadBounds;
+};
+
+template<typename TPayloadType, class T>
+FArchive& operator<<(FChaosArchive& Ar, TDynamicAABBTree<TPayloadType, T>& DynamicAABBTree)
+{
+	DynamicAABBTree.Serialize(Ar);
+	return Ar;
+}
+
+}
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/Core.h"
+#include "Chaos/ParticleHandleFwd.h"
+
+namespace Chaos
+{
+	class FChaosPhysicsMaterial;
+	class FPBDConstraintGraph;
+
+	template<typename T>
+	class TArrayCollectionArray;
+
+	template <typename T>
+	class TSerializablePtr;
+
+	template<typename T>
+	class THandleArray;
+
+	/** Why an island is, or is not, put to sleep this step */
+	enum class EIslandSleepState : uint8
+	{
+		/** The island has no dynamic particles or did not exist last step */
+		Inactive,
+		/** The island is over the sleep threshold */
+		Moving,
+		/** The island is between the sleep threshold and the wake threshold, so its sleep counter is kept but not advanced */
+		Hysteresis,
+		/** The island is under the sleep threshold, but not for enough steps yet */
+		CountingDown,
+		/** The island was under the sleep threshold for enough steps */
+		Sleep,
+		/** The island was put to sleep to keep the number of awake islands within budget */
+		BudgetSleep,
+	};
+
+	/** Per-step sleep statistics of the evolution */
+	struct FIslandSleepStats
+	{
+		int32 NumIslands = 0;
+		int32 NumMoving = 0;
+		int32 NumHysteresis = 0;
+		int32 NumCountingDown = 0;
+		int32 NumSleep = 0;
+		int32 NumBudgetSleep = 0;
+	};
+
+	/**
+	 * Decides which islands go to sleep at the end of the step.
+	 *
+	 * An island is a candidate for sleeping when its motion is under the thresholds of its particles' materials,
+	 * measured either as the speed of its fastest particle (the default) or as its mass-weighted kinetic energy,
+	 * which stops a single jittering light body from keeping a large island awake. Once a candidate, the island only
+	 * resets its sleep counter when its motion goes over the wake threshold (the sleep threshold times the hysteresis),
+	 * and goes to sleep when the counter reaches the material's sleep counter threshold.
+	 *
+	 * The number of awake islands can also be capped. When over budget, the slow-moving islands furthest from the
+	 * viewers are put to sleep. The reason each island stayed awake is recorded for stats and debugging.
+	 *
+	 * EvaluateIsland is thread safe for different islands, all the other methods must be called serially.
+	 */
+	class CHAOS_API FIslandSleepManager
+	{
+	public:
+		/** Prepares the per-island state for the islands of the constraint graph */
+		void BeginStep(const FPBDConstraintGraph& ConstraintGraph);
+
+		/**
+		 * Updates the sleep counter of an island once it has been solved.
+		 * @return true if the island should go to sleep
+		 */
+		bool EvaluateIsland(FPBDConstraintGraph& ConstraintGraph, const int32 Island, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials);
+
+		/** Applies the awake island budget to the result of EvaluateIsland and updates the stats */
+		void EndStep(const FPBDConstraintGraph& ConstraintGraph, TArray<bool>& InOutSleepIslands);
+
+		/** Sets the locations used to prioritize awake islands when over budget. Islands closest to a viewer stay awake. */
+		void SetViewerLocations(const TArray<FVec3>& InViewerLocations) { ViewerLocations = InViewerLocations; }
+
+		/** The stats of the last step */
+		const FIslandSleepStats& GetStats() const { return Stats; }
+
+		/** Logs the awake islands of the last step with the most motion relative to their thresholds */
+		void LogAwakeIslands(const FPBDConstraintGraph& ConstraintGraph, int32 MaxIslands) const;
+
+	private:
+		struct FIslandState
+		{
+			/** Motion of the island divided by its sleep threshold, < 1 when the island is a candidate for sleeping */
+			FReal MotionRatio;
+			FVec3 Center;
+			const TGeometryParticleHandle<FReal, 3>* MostMovingParticle;
+			EIslandSleepState State;
+		};
+
+		TArray<FIslandState> IslandStates;
+		TArray<FVec3> ViewerLocations;
+		FIslandSleepStats Stats;
+	};
+}
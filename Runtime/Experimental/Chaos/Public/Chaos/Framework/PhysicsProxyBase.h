@@ -52,6 +52,7 @@ public:
 	void SetDirtyIdx(const int32 Idx) { DirtyIdx = Idx; }
 	void ResetDirtyIdx() { DirtyIdx = INDEX_NONE; }
 	void SetSyncTimestamp(int32 InTimestamp) { SyncTimestamp = InTimestamp; }
+	int32 GetSyncTimestamp() const { return SyncTimestamp; }
 
 protected:
 	// Ensures that derived classes can successfully call this destructor
@@ -33,6 +33,7 @@ namespace Chaos
 	public:
 
 		FPhysicsSolverAdvanceTask(FPhysicsSolverBase& InSolver, TArray<TFunction<void()>>&& InQueue, TArray<FPushPhysicsData*>&& PushData, FReal InDt);
+		FPhysicsSolverAdvanceTask(FPhysicsSolverBase& InSolver, TArray<TFunction<void()>>&& InQueue, TArray<FPushPhysicsData*>&& PushData, FReal InDt, FReal InExternalEndTime, int32 InExternalTimestamp);
 
 		TStatId GetStatId() const;
 		static ENamedThreads::Type GetDesiredThread();
@@ -46,6 +47,9 @@ namespace Chaos
 		TArray<TFunction<void()>> Queue;
 		TArray<FPushPhysicsData*> PushData;
 		FReal Dt;
+		FReal ExternalEndTime;
+		int32 ExternalTimestamp;
+		bool bPullResults;
 	};
 
 
@@ -195,6 +199,13 @@ namespace Chaos
 			//make sure any GT state is pushed into necessary buffer
 			PushPhysicsState(DtWithPause);
 
+			if(IsUsingAsyncResults())
+			{
+				//the external thread does not wait on fixed steps, results are pulled with GatherPullData_External instead
+				DispatchFixedSteps_External(DtWithPause);
+				return FGraphEventRef();
+			}
+
 			TArray<FPushPhysicsData*> PushData = MarshallingManager.StepInternalTime_External(DtWithPause);
 			SetExternalTimestampConsumed_External(MarshallingManager.GetExternalTimestampConsumed_External());
 
@@ -281,6 +292,30 @@ namespace Chaos
 			bPaused_External = bShouldPause;
 		}
 
+		/**
+		 * Decouples the solver from the external thread. When InFixedDt is greater than zero the solver advances in steps of InFixedDt as external time
+		 * accumulates, without the external thread waiting on them, and hands the results of each step over through the marshalling manager so that
+		 * the external thread can interpolate between them. Zero goes back to one synchronous step per external frame.
+		 */
+		void SetAsyncFixedDt_External(FReal InFixedDt);
+
+		/** Whether the solver runs decoupled fixed steps and results must be gathered from the marshalling manager */
+		bool IsUsingAsyncResults() const
+		{
+			return AsyncFixedDt > 0;
+		}
+
+		FReal GetAsyncFixedDt() const
+		{
+			return AsyncFixedDt;
+		}
+
+		/** Whether all the dispatched steps are done, so that solver state can be read from the external thread */
+		bool IsPendingTasksComplete_External() const
+		{
+			return !PendingTasks || PendingTasks->IsComplete();
+		}
+
 	protected:
 		/** Mode that the results buffers should be set to (single, double, triple) */
 		EMultiBufferMode BufferMode;
@@ -320,6 +355,9 @@ namespace Chaos
 		virtual void ProcessPushedData_Internal(const TArray<FPushPhysicsData*>& PushDataArray) = 0;
 		virtual void SetExternalTimestampConsumed_External(const int32 Timestamp) = 0;
 
+		/** Dispatches as many fixed steps as the accumulated external time allows */
+		void DispatchFixedSteps_External(FReal Dt);
+
 #if CHAOS_CHECKED
 		FName DebugName;
 #endif
@@ -346,6 +384,12 @@ namespace Chaos
 		 */
 		bool bPaused_External;
 
+		/** The fixed step of async mode, zero when the solver steps synchronously with the external thread */
+		FReal AsyncFixedDt;
+
+		/** External time not yet consumed by fixed steps */
+		FReal AsyncAccumulatedTime;
+
 		/** 
 		 * Ptr to the engine object that is counted as the owner of this solver.
 		 * Never used internally beyond how the solver is stored and accessed through the solver module.
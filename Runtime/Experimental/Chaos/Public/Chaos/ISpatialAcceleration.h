@@ -162,7 +162,7 @@ public:
 
 };
 
-using SpatialAccelerationType = uint8;	//see ESpatialAcceleration. Projects can add their own custom types by using enum values higher than ESpatialAcceleration::Unknown
+using SpatialAccelerationType = uint8;	//see ESpatialAcceleration. Projects can add their own custom types by using enum values higher than ESpatialAcceleration::DynamicAABBTree
 enum class ESpatialAcceleration : SpatialAccelerationType
 {
 	BoundingVolume,
@@ -170,7 +170,8 @@ enum class ESpatialAcceleration : SpatialAccelerationType
 	AABBTreeBV,
 	Collection,
 	Unknown,
-	//For custom types continue the enum after ESpatialAcceleration::Unknown
+	DynamicAABBTree,
+	//For custom types continue the enum after ESpatialAcceleration::DynamicAABBTree
 };
 
 inline bool SpatialAccelerationEqual(ESpatialAcceleration A, SpatialAccelerationType B) { return (SpatialAccelerationType)A == B; }
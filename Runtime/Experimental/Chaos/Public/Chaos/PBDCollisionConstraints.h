@@ -3,6 +3,7 @@
 
 #include "Chaos/CollisionResolutionTypes.h"
 #include "Chaos/Collision/CollisionApplyType.h"
+#include "Chaos/Collision/CollisionManifoldCache.h"
 #include "Chaos/Collision/PBDCollisionConstraintHandle.h"
 #include "Chaos/PBDConstraintContainer.h"
 #include "Framework/BufferedData.h"
@@ -267,6 +268,14 @@ public:
 #endif
 	}
 
+	/**
+	 * The one-shot manifolds of the previous frame, which the narrow phase restores for pairs that have not moved
+	 */
+	const FCollisionManifoldCache& GetManifoldCache() const
+	{
+		return ManifoldCache;
+	}
+
 	void SetCullDistance(FReal InCullDistance)
 	{
 		MCullDistance = InCullDistance;
@@ -378,6 +387,7 @@ private:
 #endif
 	TArray<FPBDCollisionConstraintHandle*> Handles;
 	FConstraintHandleAllocator HandleAllocator;
+	FCollisionManifoldCache ManifoldCache;
 
 	TArrayCollectionArray<bool>& MCollided;
 	const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& MPhysicsMaterials;
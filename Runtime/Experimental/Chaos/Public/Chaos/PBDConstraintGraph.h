@@ -90,9 +90,14 @@ namespace Chaos
 		void UpdateIslands(const TParticleView<TPBDRigidParticles<FReal, 3>>& confusing, TPBDRigidsSOAs<FReal, 3>& Particles);
 
 		/**
-		 * Put particles in inactive islands to sleep.
+		 * Whether particle sleeping is enabled (p.Chaos.Solver.SleepEnabled).
 		 */
-		bool SleepInactive(const int32 Island, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials);
+		static bool IsSleepEnabled();
+
+		/**
+		 * Get the sleep thresholds of a dynamic particle from its physics material, or the defaults if it has none.
+		 */
+		static void GetSleepThresholds(const TPBDRigidParticleHandle<FReal, 3>* PBDRigid, const TArrayCollectionArray<TSerializablePtr<FChaosPhysicsMaterial>>& PerParticleMaterialAttributes, const THandleArray<FChaosPhysicsMaterial>& SolverPhysicsMaterials, FReal& OutLinearThreshold, FReal& OutAngularThreshold, int32& OutCounterThreshold);
 
 		/**
 		 * Wake all particles in an Island.
@@ -131,6 +136,22 @@ namespace Chaos
 			return IslandToSleepCount[Island];
 		}
 
+		/**
+		 * Set the number of consecutive steps the specified island has been a candidate for sleeping.
+		 */
+		void SetIslandSleepCount(int32 Island, int32 SleepCount)
+		{
+			IslandToSleepCount[Island] = SleepCount;
+		}
+
+		/**
+		 * Whether the specified island existed in the previous step. Only persistent islands can go to sleep.
+		 */
+		bool IsIslandPersistent(int32 Island) const
+		{
+			return IslandToData[Island].bIsIslandPersistant;
+		}
+
 		/**
 		 * The number of islands in the graph.
 		 */
@@ -213,6 +213,23 @@ struct CHAOS_API ISpatialAccelerationCollectionFactory
 	//Chaos creates new acceleration structures per bucket. Factory can change underlying type at runtime as well as number of buckets to AB test
 	virtual TUniquePtr<ISpatialAcceleration<TAccelerationStructureHandle<FReal, 3>, FReal, 3>> CreateAccelerationPerBucket_Threaded(const TConstParticleView<FSpatialAccelerationCache>& Particles, uint16 BucketIdx, bool ForceFullBuild) = 0;
 
+	// Determines if bucket is kept up to date by the pending operations, in which case it is only created once instead of being rebuilt.
+	virtual bool IsBucketIncremental(uint16 BucketIdx) const { return false; }
+
+	// Determines if any active bucket is incremental, see IsBucketIncremental
+	bool HasIncrementalBuckets() const
+	{
+		const uint8 ActiveBucketsMask = GetActiveBucketsMask();
+		for (uint16 BucketIdx = 0; BucketIdx < 8; ++BucketIdx)
+		{
+			if ((ActiveBucketsMask & (1 << BucketIdx)) && IsBucketIncremental(BucketIdx))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	//Mask indicating which bucket is active. Spatial indices in inactive buckets fallback to bucket 0. Bit 0 indicates bucket 0 is active, Bit 1 indicates bucket 1 is active, etc...
 	virtual uint8 GetActiveBucketsMask() const = 0;
 
@@ -867,7 +884,7 @@ protected:
 		bool bIsSingleThreaded;
 
 	private:
-		void UpdateStructure(FAccelerationStructure* AccelerationStructure);
+		void UpdateStructure(FAccelerationStructure* AccelerationStructure, bool bAllowIncremental);
 	};
 	FGraphEventRef AccelerationStructureTaskComplete;
 
@@ -5,6 +5,7 @@
 #include "Chaos/Collision/NarrowPhase.h"
 #include "Chaos/Collision/SpatialAccelerationBroadPhase.h"
 #include "Chaos/Collision/SpatialAccelerationCollisionDetector.h"
+#include "Chaos/Evolution/IslandSleepManager.h"
 #include "Chaos/PBDCollisionConstraints.h"
 #include "Chaos/PBDRigidsEvolution.h"
 #include "Chaos/PerParticleAddImpulses.h"
@@ -162,6 +163,9 @@ namespace Chaos
 		FORCEINLINE FCollisionDetector& GetCollisionDetector() { return CollisionDetector; }
 		FORCEINLINE const FCollisionDetector& GetCollisionDetector() const { return CollisionDetector; }
 
+		FORCEINLINE FIslandSleepManager& GetIslandSleepManager() { return IslandSleepManager; }
+		FORCEINLINE const FIslandSleepManager& GetIslandSleepManager() const { return IslandSleepManager; }
+
 		FORCEINLINE FGravityForces& GetGravityForces() { return GravityForces; }
 		FORCEINLINE const FGravityForces& GetGravityForces() const { return GravityForces; }
 
@@ -267,6 +271,7 @@ namespace Chaos
 		FSpatialAccelerationBroadPhase BroadPhase;
 		FNarrowPhase NarrowPhase;
 		FSpatialAccelerationCollisionDetector CollisionDetector;
+		FIslandSleepManager IslandSleepManager;
 
 		FPBDRigidsEvolutionCallback PostIntegrateCallback;
 		FPBDRigidsEvolutionCallback PostDetectCollisionsCallback;
@@ -5,6 +5,7 @@
 #include "Chaos/Collision/SpatialAccelerationBroadPhase.h"
 #include "Chaos/Collision/StatsData.h"
 #include "GeometryParticlesfwd.h"
+#include "UObject/ExternalPhysicsCustomObjectVersion.h"
 
 #include <tuple>
 
@@ -501,6 +502,9 @@ public:
 	{
 		//todo: let user serialize out bucket params
 
+		//the collection types can change, e.g. default collections hold dynamic AABB trees since DynamicAABBTreeAcceleration
+		Ar.UsingCustomVersion(FExternalPhysicsCustomObjectVersion::GUID);
+
 		//serialize out sub structures
 		for (int BucketIdx = 0; BucketIdx < MaxBuckets; ++BucketIdx)
 		{
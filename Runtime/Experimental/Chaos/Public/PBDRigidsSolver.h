@@ -259,6 +259,9 @@ namespace Chaos
 		/**/
 		void BufferPhysicsResults();
 
+		/** Writes the results of the step into the marshalling manager's pull data, used instead of the results buffers in async mode */
+		void BufferAsyncPhysicsResults();
+
 		/**/
 		void FlipBuffers();
 
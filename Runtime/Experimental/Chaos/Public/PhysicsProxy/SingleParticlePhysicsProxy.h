@@ -18,6 +18,8 @@ namespace Chaos
 
 	template <typename Traits>
 	class TPBDRigidsEvolutionGBF;
+
+	struct FDirtyRigidParticleData;
 }
 
 class FInitialState
@@ -140,6 +142,9 @@ public:
 	/**/
 	bool PullFromPhysicsState(const int32 SolverSyncTimestamp);
 
+	/** Moves the results of an async step into the particle. Only implemented for rigid particles */
+	bool PullFromPhysicsState(const Chaos::FDirtyRigidParticleData& PullData, const int32 SolverSyncTimestamp);
+
 	/**/
 	bool IsDirty();
 
@@ -241,6 +246,9 @@ CHAOS_API void FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::
 template< >
 CHAOS_API bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::PullFromPhysicsState(const int32 SolverSyncTimestamp);
 
+template< >
+CHAOS_API bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::PullFromPhysicsState(const Chaos::FDirtyRigidParticleData& PullData, const int32 SolverSyncTimestamp);
+
 template< >
 bool FSingleParticlePhysicsProxy<Chaos::TPBDRigidParticle<float, 3>>::IsDirty();
 
@@ -7,6 +7,7 @@
 #include "UObject/ObjectMacros.h"
 #include "UObject/Object.h"
 #include "UObject/Class.h"
+#include "UObject/GeneratedStructOps.h"
 #include "GameplayTagContainer.generated.h"
 
 class UEditableGameplayTagQuery;
@@ -199,6 +200,13 @@ struct GAMEPLAYTAGS_API FGameplayTag
 	/** Handles importing tag strings without (TagName=) in it */
 	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
 
+	/** Lists the reflected properties for the generated serialization and comparison, see UObject/GeneratedStructOps.h */
+	template<typename VisitorType>
+	static void VisitGeneratedProperties(VisitorType&& Visitor)
+	{
+		Visitor(&FGameplayTag::TagName);
+	}
+
 	/** An empty Gameplay Tag */
 	static const FGameplayTag EmptyTag;
 
@@ -267,6 +275,7 @@ struct TStructOpsTypeTraits< FGameplayTag > : public TStructOpsTypeTraitsBase2<
 		WithPostSerialize = true,
 		WithStructuredSerializeFromMismatchedTag = true,
 		WithImportTextItem = true,
+		WithGeneratedPropertyOps = true,
 	};
 };
 
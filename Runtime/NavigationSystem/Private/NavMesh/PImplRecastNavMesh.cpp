@@ -33,15 +33,160 @@ static_assert(RECAST_UNWALKABLE_POLY_COST == DT_UNWALKABLE_POLY_COST, "Unwalkabl
 
 /// Helper for accessing navigation query from different threads
 #define INITIALIZE_NAVQUERY_SIMPLE(NavQueryVariable, NumNodes)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##Private; \
+	FPImplRecastNavMesh::FScopedThreadNavQuery NavQueryVariable##ThreadQuery; \
+	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##ThreadQuery.Get(); \
 	NavQueryVariable.init(DetourNavMesh, NumNodes);
 
 #define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes, LinkFilter)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##Private; \
+	FPImplRecastNavMesh::FScopedThreadNavQuery NavQueryVariable##ThreadQuery; \
+	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##ThreadQuery.Get(); \
 	NavQueryVariable.init(DetourNavMesh, NumNodes, &LinkFilter);
 
+namespace
+{
+	struct FThreadNavQuery
+	{
+		dtNavMeshQuery Query;
+		bool bInUse = false;
+	};
+
+	// Kept alive for the lifetime of the thread so its node pool and open list are allocated once,
+	// dtNavMeshQuery::init only reallocates them when a query needs more nodes than before
+	thread_local FThreadNavQuery GThreadNavQuery;
+
+	thread_local FRecastSharedGoalScope* GRecastSharedGoalScope = nullptr;
+}
+
+FPImplRecastNavMesh::FScopedThreadNavQuery::~FScopedThreadNavQuery()
+{
+	if (bUsesThreadQuery)
+	{
+		GThreadNavQuery.bInUse = false;
+	}
+}
+
+dtNavMeshQuery& FPImplRecastNavMesh::FScopedThreadNavQuery::Get()
+{
+	if (bUsesThreadQuery)
+	{
+		return GThreadNavQuery.Query;
+	}
+
+	if (!PrivateQuery.IsValid())
+	{
+		if (!GThreadNavQuery.bInUse)
+		{
+			GThreadNavQuery.bInUse = true;
+			bUsesThreadQuery = true;
+			return GThreadNavQuery.Query;
+		}
+
+		// Re-entered while the thread's query holds the state of another search, don't clobber it
+		PrivateQuery = MakeUnique<dtNavMeshQuery>();
+	}
+
+	return *PrivateQuery;
+}
+
+FRecastSharedGoalScope::FRecastSharedGoalScope(const FNavigationQueryFilter& InFilter)
+	: Filter(&InFilter)
+	, NavMesh(nullptr)
+	, GoalPolyID(INVALID_NAVNODEREF)
+	, RecastGoalPos(FVector::ZeroVector)
+	, NumReusedCorridors(0)
+{
+	check(GRecastSharedGoalScope == nullptr);
+	GRecastSharedGoalScope = this;
+}
+
+FRecastSharedGoalScope::~FRecastSharedGoalScope()
+{
+	check(GRecastSharedGoalScope == this);
+	GRecastSharedGoalScope = nullptr;
+}
+
+FRecastSharedGoalScope* FRecastSharedGoalScope::Get()
+{
+	return GRecastSharedGoalScope;
+}
+
+bool FRecastSharedGoalScope::CanShare(const dtNavMesh* InNavMesh, const FNavigationQueryFilter& InFilter, float CostLimit) const
+{
+	// Cost limited searches may stop before reaching a corridor recorded by an unlimited one
+	return Filter == &InFilter
+		&& (NavMesh == nullptr || NavMesh == InNavMesh)
+		&& CostLimit == FLT_MAX;
+}
+
+bool FRecastSharedGoalScope::FindCorridor(NavNodeRef StartPolyID, NavNodeRef EndPolyID, const FVector& RecastEndPos, dtQueryResult& PathResult)
+{
+	if (GoalPolyID != EndPolyID || RecastGoalPos != RecastEndPos)
+	{
+		return false;
+	}
+
+	const FCorridorPoly* CorridorPoly = PolyToCorridor.Find(StartPolyID);
+	if (CorridorPoly == nullptr)
+	{
+		return false;
+	}
+
+	// The first poly has no cost, like the corridors returned by dtNavMeshQuery::findPath
+	const TArray<NavNodeRef>& Corridor = Corridors[CorridorPoly->CorridorIndex];
+	const TArray<float>& Costs = CorridorCosts[CorridorPoly->CorridorIndex];
+	PathResult.reserve(Corridor.Num() - CorridorPoly->PolyIndex);
+	for (int32 PolyIndex = CorridorPoly->PolyIndex; PolyIndex < Corridor.Num(); ++PolyIndex)
+	{
+		PathResult.addRef(Corridor[PolyIndex], PolyIndex == CorridorPoly->PolyIndex ? 0.f : Costs[PolyIndex]);
+	}
+
+	++NumReusedCorridors;
+	return true;
+}
+
+void FRecastSharedGoalScope::AddCorridor(const dtNavMesh* InNavMesh, NavNodeRef EndPolyID, const FVector& RecastEndPos, dtStatus FindPathStatus, const dtQueryResult& PathResult)
+{
+	const int32 NumPolys = PathResult.size();
+	if (!dtStatusSucceed(FindPathStatus) || dtStatusDetail(FindPathStatus, DT_PARTIAL_RESULT) || NumPolys < 2 || PathResult.getRef(NumPolys - 1) != EndPolyID)
+	{
+		return;
+	}
+
+	if (NavMesh == nullptr)
+	{
+		NavMesh = InNavMesh;
+		GoalPolyID = EndPolyID;
+		RecastGoalPos = RecastEndPos;
+	}
+	else if (GoalPolyID != EndPolyID || RecastGoalPos != RecastEndPos)
+	{
+		return;
+	}
+
+	for (int32 PolyIndex = 0; PolyIndex < NumPolys; ++PolyIndex)
+	{
+		if (NavMesh->getOffMeshConnectionByRef(PathResult.getRef(PolyIndex)) != nullptr)
+		{
+			return;
+		}
+	}
+
+	const int32 CorridorIndex = Corridors.Num();
+	TArray<NavNodeRef>& Corridor = Corridors.AddDefaulted_GetRef();
+	TArray<float>& Costs = CorridorCosts.AddDefaulted_GetRef();
+	Corridor.AddUninitialized(NumPolys);
+	Costs.AddUninitialized(NumPolys);
+	for (int32 PolyIndex = 0; PolyIndex < NumPolys; ++PolyIndex)
+	{
+		Corridor[PolyIndex] = PathResult.getRef(PolyIndex);
+		Costs[PolyIndex] = PathResult.getCost(PolyIndex);
+		if (PolyIndex < NumPolys - 1 && !PolyToCorridor.Contains(Corridor[PolyIndex]))
+		{
+			PolyToCorridor.Add(Corridor[PolyIndex], { CorridorIndex, PolyIndex });
+		}
+	}
+}
+
 static void* DetourMalloc(int Size, dtAllocHint)
 {
 	LLM_SCOPE(ELLMTag::NavigationRecast);
@@ -278,6 +423,7 @@ void FPImplRecastNavMesh::ReleaseDetourNavMesh()
 		dtFreeNavMesh(DetourNavMesh);
 	}
 	DetourNavMesh = nullptr;
+	PortalGraph.Reset();
 	
 	CompressedTileCacheLayers.Empty();
 
@@ -441,6 +587,9 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar, int32 NavMeshVersion )
 					}
 				}
 			}
+
+			// build it here rather than on first query, hierarchical path finding runs on worker threads
+			RebuildPortalGraph();
 		}
 	}
 	else if (Ar.IsSaving())
@@ -788,6 +937,9 @@ void FPImplRecastNavMesh::SetRecastMesh(dtNavMesh* NavMesh)
 	ReleaseDetourNavMesh();
 	DetourNavMesh = NavMesh;
 
+	// tiles added later are picked up by UpdatePortalGraph
+	RebuildPortalGraph();
+
 	if (NavMeshOwner)
 	{
 		NavMeshOwner->UpdateNavObject();
@@ -889,9 +1041,23 @@ ENavigationQueryResult::Type FPImplRecastNavMesh::FindPath(const FVector& StartL
 		return ENavigationQueryResult::Error;
 	}
 
-	// get path corridor
+	// get path corridor, from the queries going to the same goal when possible
+	FRecastSharedGoalScope* SharedGoal = FRecastSharedGoalScope::Get();
+	if (SharedGoal && !SharedGoal->CanShare(DetourNavMesh, InQueryFilter, CostLimit))
+	{
+		SharedGoal = nullptr;
+	}
+
 	dtQueryResult PathResult;
-	const dtStatus FindPathStatus = NavQuery.findPath(StartPolyID, EndPolyID, &RecastStartPos.X, &RecastEndPos.X, CostLimit, QueryFilter, PathResult, 0);
+	dtStatus FindPathStatus = DT_SUCCESS;
+	if (SharedGoal == nullptr || !SharedGoal->FindCorridor(StartPolyID, EndPolyID, RecastEndPos, PathResult))
+	{
+		FindPathStatus = NavQuery.findPath(StartPolyID, EndPolyID, &RecastStartPos.X, &RecastEndPos.X, CostLimit, QueryFilter, PathResult, 0);
+		if (SharedGoal)
+		{
+			SharedGoal->AddCorridor(DetourNavMesh, EndPolyID, RecastEndPos, FindPathStatus, PathResult);
+		}
+	}
 
 	// check for special case, where path has not been found, and starting polygon
 	// was the one closest to the target
@@ -940,6 +1106,133 @@ ENavigationQueryResult::Type FPImplRecastNavMesh::FindPath(const FVector& StartL
 	return DTStatusToNavQueryResult(FindPathStatus);
 }
 
+ENavigationQueryResult::Type FPImplRecastNavMesh::FindHierarchicalPath(const FVector& StartLoc, const FVector& EndLoc, const float CostLimit, FNavMeshPath& Path, const FNavigationQueryFilter& InQueryFilter, const UObject* Owner) const
+{
+	if (DetourNavMesh == NULL || NavMeshOwner == NULL)
+	{
+		return ENavigationQueryResult::Error;
+	}
+
+	const FRecastQueryFilter* FilterImplementation = (const FRecastQueryFilter*)(InQueryFilter.GetImplementation());
+	const dtQueryFilter* QueryFilter = FilterImplementation ? FilterImplementation->GetAsDetourQueryFilter() : nullptr;
+	if (QueryFilter == nullptr || CostLimit < FLT_MAX)
+	{
+		// cost limited searches stay local, regular search also takes care of reporting filter errors
+		return FindPath(StartLoc, EndLoc, CostLimit, Path, InQueryFilter, Owner);
+	}
+
+	FRecastSpeciaLinkFilter LinkFilter(FNavigationSystem::GetCurrent<UNavigationSystemV1>(NavMeshOwner->GetWorld()), Owner);
+	INITIALIZE_NAVQUERY(NavQuery, InQueryFilter.GetMaxSearchNodes(), LinkFilter);
+
+	FVector RecastStartPos, RecastEndPos;
+	NavNodeRef StartPolyID, EndPolyID;
+	const bool bCanSearch = InitPathfinding(StartLoc, EndLoc, NavQuery, QueryFilter, RecastStartPos, StartPolyID, RecastEndPos, EndPolyID);
+	if (!bCanSearch)
+	{
+		return ENavigationQueryResult::Error;
+	}
+
+	// regular search is cheaper for close locations
+	const dtMeshTile* StartTile = DetourNavMesh->getTile(DetourNavMesh->decodePolyIdTile(StartPolyID));
+	const dtMeshTile* EndTile = DetourNavMesh->getTile(DetourNavMesh->decodePolyIdTile(EndPolyID));
+	const int32 TileDistance = FMath::Max(FMath::Abs(StartTile->header->x - EndTile->header->x), FMath::Abs(StartTile->header->y - EndTile->header->y));
+	if (TileDistance < NavMeshOwner->HierarchicalPathMinTileDistance)
+	{
+		return FindPath(StartLoc, EndLoc, CostLimit, Path, InQueryFilter, Owner);
+	}
+
+	if (!PortalGraph.IsBuilt())
+	{
+		// the graph is only built with the navmesh and only if the owner uses it, see RebuildPortalGraph
+		return FindPath(StartLoc, EndLoc, CostLimit, Path, InQueryFilter, Owner);
+	}
+
+	TArray<FRecastPortalGraph::FWaypoint> Waypoints;
+	if (!PortalGraph.FindPortalPath(*DetourNavMesh, *QueryFilter, StartPolyID, RecastStartPos, EndPolyID, RecastEndPos, int32(NavMeshOwner->DefaultMaxHierarchicalSearchNodes), Waypoints))
+	{
+		UE_VLOG(NavMeshOwner, LogNavigation, Log, TEXT("FPImplRecastNavMesh::FindHierarchicalPath no portal path found, using regular search"));
+		return FindPath(StartLoc, EndLoc, CostLimit, Path, InQueryFilter, Owner);
+	}
+
+	// refine portal path into a poly corridor, one bounded search between consecutive waypoints
+	TArray<NavNodeRef> Corridor;
+	TArray<float> CorridorCosts;
+	TMap<NavNodeRef, int32> CorridorIndices;
+	for (int32 WaypointIndex = 0; WaypointIndex + 1 < Waypoints.Num(); ++WaypointIndex)
+	{
+		const FRecastPortalGraph::FWaypoint& From = Waypoints[WaypointIndex];
+		const FRecastPortalGraph::FWaypoint& To = Waypoints[WaypointIndex + 1];
+
+		dtQueryResult SegmentResult;
+		const dtStatus SegmentStatus = NavQuery.findPath(From.PolyRef, To.PolyRef, &From.Location.X, &To.Location.X, FLT_MAX, QueryFilter, SegmentResult, 0);
+		if (dtStatusFailed(SegmentStatus) || dtStatusDetail(SegmentStatus, DT_PARTIAL_RESULT))
+		{
+			// portal graph costs don't include query filter's area costs and exclusions
+			UE_VLOG(NavMeshOwner, LogNavigation, Log, TEXT("FPImplRecastNavMesh::FindHierarchicalPath failed to refine portal path, using regular search"));
+			return FindPath(StartLoc, EndLoc, CostLimit, Path, InQueryFilter, Owner);
+		}
+
+		// first poly of a segment is the last one of the previous segment
+		for (int32 ResultIndex = (WaypointIndex == 0) ? 0 : 1; ResultIndex < SegmentResult.size(); ++ResultIndex)
+		{
+			const NavNodeRef PolyRef = SegmentResult.getRef(ResultIndex);
+			const int32* ExistingIndex = CorridorIndices.Find(PolyRef);
+			if (ExistingIndex)
+			{
+				// corridor loops back around a portal, cut the loop
+				const int32 NewCorridorNum = *ExistingIndex + 1;
+				for (int32 RemovedIndex = NewCorridorNum; RemovedIndex < Corridor.Num(); ++RemovedIndex)
+				{
+					CorridorIndices.Remove(Corridor[RemovedIndex]);
+				}
+				Corridor.SetNum(NewCorridorNum, /*bAllowShrinking=*/false);
+				CorridorCosts.SetNum(NewCorridorNum, /*bAllowShrinking=*/false);
+			}
+			else
+			{
+				CorridorIndices.Add(PolyRef, Corridor.Add(PolyRef));
+				CorridorCosts.Add(SegmentResult.getCost(ResultIndex));
+			}
+		}
+	}
+
+	dtQueryResult PathResult;
+	PathResult.reserve(Corridor.Num());
+	for (int32 CorridorIndex = 0; CorridorIndex < Corridor.Num(); ++CorridorIndex)
+	{
+		PathResult.addRef(Corridor[CorridorIndex], CorridorCosts[CorridorIndex]);
+	}
+
+	PostProcessPath(DT_SUCCESS, Path, NavQuery, QueryFilter,
+		StartPolyID, EndPolyID, Recast2UnrVector(&RecastStartPos.X), Recast2UnrVector(&RecastEndPos.X), RecastStartPos, RecastEndPos,
+		PathResult);
+
+	Path.MarkReady();
+
+	return ENavigationQueryResult::Success;
+}
+
+void FPImplRecastNavMesh::RebuildPortalGraph()
+{
+	if (DetourNavMesh && NavMeshOwner && NavMeshOwner->bUsePortalGraphForHierarchicalPathfinding)
+	{
+		PortalGraph.Build(*DetourNavMesh);
+	}
+	else
+	{
+		PortalGraph.Reset();
+	}
+}
+
+void FPImplRecastNavMesh::UpdatePortalGraph(const TArray<uint32>& ChangedTiles)
+{
+	// an unbuilt graph has nothing to update, which also skips navmeshes not using it
+	if (DetourNavMesh && PortalGraph.IsBuilt())
+	{
+		PortalGraph.UpdateTiles(*DetourNavMesh, ChangedTiles);
+	}
+}
+
 ENavigationQueryResult::Type FPImplRecastNavMesh::TestPath(const FVector& StartLoc, const FVector& EndLoc, const FNavigationQueryFilter& InQueryFilter, const UObject* Owner, int32* NumVisitedNodes) const
 {
 	const dtQueryFilter* QueryFilter = ((const FRecastQueryFilter*)(InQueryFilter.GetImplementation()))->GetAsDetourQueryFilter();
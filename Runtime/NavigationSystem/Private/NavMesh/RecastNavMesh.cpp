@@ -33,13 +33,13 @@
 #if WITH_RECAST
 /// Helper for accessing navigation query from different threads
 #define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##Private; \
+	FPImplRecastNavMesh::FScopedThreadNavQuery NavQueryVariable##ThreadQuery; \
+	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##ThreadQuery.Get(); \
 	NavQueryVariable.init(RecastNavMeshImpl->DetourNavMesh, NumNodes);
 
 #define INITIALIZE_NAVQUERY_WLINKFILTER(NavQueryVariable, NumNodes, LinkFilter)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##Private; \
+	FPImplRecastNavMesh::FScopedThreadNavQuery NavQueryVariable##ThreadQuery; \
+	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##ThreadQuery.Get(); \
 	NavQueryVariable.init(RecastNavMeshImpl->DetourNavMesh, NumNodes, &LinkFilter);
 
 #endif // WITH_RECAST
@@ -317,6 +317,8 @@ ARecastNavMesh::ARecastNavMesh(const FObjectInitializer& ObjectInitializer)
 	, RecastNavMeshImpl(NULL)
 {
 	HeuristicScale = 0.999f;
+	bUsePortalGraphForHierarchicalPathfinding = false;
+	HierarchicalPathMinTileDistance = 4;
 	RegionPartitioning = ERecastPartitioning::Watershed;
 	LayerPartitioning = ERecastPartitioning::Watershed;
 	RegionChunkSplits = 2;
@@ -335,7 +337,9 @@ ARecastNavMesh::ARecastNavMesh(const FObjectInitializer& ObjectInitializer)
 		INC_DWORD_STAT_BY( STAT_NavigationMemory, sizeof(*this) );
 
 		FindPathImplementation = FindPath;
-		FindHierarchicalPathImplementation = FindPath;
+		FindHierarchicalPathImplementation = FindHierarchicalPath;
+		// Worker threads use their own Detour queries, see FPImplRecastNavMesh::FScopedThreadNavQuery
+		bSupportsConcurrentPathfinding = true;
 
 		TestPathImplementation = TestPath;
 		TestHierarchicalPathImplementation = TestHierarchicalPath;
@@ -1819,6 +1823,10 @@ void ARecastNavMesh::DrawDebugPathCorridor(NavNodeRef const* PathPolys, int32 Nu
 
 void ARecastNavMesh::OnNavMeshTilesUpdated(const TArray<uint32>& ChangedTiles)
 {
+	if (RecastNavMeshImpl)
+	{
+		RecastNavMeshImpl->UpdatePortalGraph(ChangedTiles);
+	}
 	InvalidateAffectedPaths(ChangedTiles);
 }
 
@@ -2021,6 +2029,11 @@ uint32 ARecastNavMesh::LogMemUsed() const
 		}
 	}
 
+	if (RecastNavMeshImpl)
+	{
+		MemUsed += RecastNavMeshImpl->PortalGraph.GetAllocatedSize();
+	}
+
 	UE_LOG(LogNavigation, Warning, TEXT("%s: ARecastNavMesh: %u\n    self: %d"), *GetName(), MemUsed, sizeof(ARecastNavMesh));	
 
 	return MemUsed + SuperMemUsed;
@@ -2093,6 +2106,7 @@ void ARecastNavMesh::AttachNavMeshDataChunk(URecastNavMeshDataChunk& NavDataChun
 	TArray<uint32> AttachedIndices = NavDataChunk.AttachTiles(*RecastNavMeshImpl);
 	if (AttachedIndices.Num() > 0)
 	{
+		RecastNavMeshImpl->UpdatePortalGraph(AttachedIndices);
 		InvalidateAffectedPaths(AttachedIndices);
 		RequestDrawingUpdate();
 	}
@@ -2117,6 +2131,7 @@ void ARecastNavMesh::DetachNavMeshDataChunk(URecastNavMeshDataChunk& NavDataChun
 	TArray<uint32> DetachedIndices = NavDataChunk.DetachTiles(*RecastNavMeshImpl);
 	if (DetachedIndices.Num() > 0)
 	{
+		RecastNavMeshImpl->UpdatePortalGraph(DetachedIndices);
 		InvalidateAffectedPaths(DetachedIndices);
 		RequestDrawingUpdate();
 	}
@@ -2154,6 +2169,16 @@ bool ARecastNavMesh::AdjustLocationWithFilter(const FVector& StartLoc, FVector&
 }
 
 FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	return FindPathInternal(Query, /*bHierarchical=*/false);
+}
+
+FPathFindingResult ARecastNavMesh::FindHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	return FindPathInternal(Query, /*bHierarchical=*/true);
+}
+
+FPathFindingResult ARecastNavMesh::FindPathInternal(const FPathFindingQuery& Query, bool bHierarchical)
 {
 	SCOPE_CYCLE_COUNTER(STAT_Navigation_RecastPathfinding);
 	CSV_SCOPED_TIMING_STAT_EXCLUSIVE(Pathfinding);
@@ -2198,7 +2223,9 @@ FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProp
 		}
 		else
 		{
-			Result.Result = RecastNavMesh->RecastNavMeshImpl->FindPath(Query.StartLocation, AdjustedEndLocation, Query.CostLimit, *NavMeshPath, *NavFilter, Query.Owner.Get());
+			Result.Result = bHierarchical
+				? RecastNavMesh->RecastNavMeshImpl->FindHierarchicalPath(Query.StartLocation, AdjustedEndLocation, Query.CostLimit, *NavMeshPath, *NavFilter, Query.Owner.Get())
+				: RecastNavMesh->RecastNavMeshImpl->FindPath(Query.StartLocation, AdjustedEndLocation, Query.CostLimit, *NavMeshPath, *NavFilter, Query.Owner.Get());
 
 			const bool bPartialPath = Result.IsPartial();
 			if (bPartialPath)
@@ -2509,6 +2536,11 @@ void ARecastNavMesh::PostEditChangeProperty(FPropertyChangedEvent& PropertyChang
 		else if (CategoryName == NAME_Query)
 		{
 			RecreateDefaultFilter();
+
+			if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ARecastNavMesh, bUsePortalGraphForHierarchicalPathfinding) && RecastNavMeshImpl)
+			{
+				RecastNavMeshImpl->RebuildPortalGraph();
+			}
 		}
 	}
 }
@@ -60,6 +60,10 @@ struct dtTileCacheAlloc;
 static int32 GNavmeshSynchronousTileGeneration = 0;
 static FAutoConsoleVariableRef NavmeshVarSynchronous(TEXT("n.GNavmeshSynchronousTileGeneration"), GNavmeshSynchronousTileGeneration, TEXT(""), ECVF_Default);
 
+static int32 GNavmeshTileSpanCacheSizeMB = 64;
+static FAutoConsoleVariableRef NavmeshVarTileSpanCacheSize(TEXT("n.NavmeshTileSpanCacheSizeMB"), GNavmeshTileSpanCacheSizeMB,
+	TEXT("Memory budget in MB for rasterized spans kept per navmesh tile, used to skip rasterizing unchanged geometry when a tile is rebuilt. 0 disables the cache."), ECVF_Default);
+
 #if RECAST_INTERNAL_DEBUG_DATA
 static int32 GNavmeshDisplayStep = 0;
 static int32 GNavmeshDebugTileX = MAX_int32;
@@ -238,6 +242,23 @@ struct FRecastGeometryExport : public FNavigableGeometryExport
 	virtual void SetNavDataPerInstanceTransformDelegate(const FNavDataPerInstanceTransformDelegate& InDelegate) override;
 };
 
+TSharedPtr<const TArray<rcSpanCache>, ESPMode::ThreadSafe> FRecastTileSpanCache::FindSpans(const TSharedRef<FNavigationRelevantData, ESPMode::ThreadSafe>& ElementData) const
+{
+	// Navigation relevant data is replaced when its element changes, a dead source means the address got reused
+	const FRecastCachedElementSpans* ElementSpans = Elements.Find(&ElementData.Get());
+	return (ElementSpans && ElementSpans->Source.HasSameObject(&ElementData.Get())) ? ElementSpans->Spans : nullptr;
+}
+
+uint32 FRecastTileSpanCache::GetAllocatedSize() const
+{
+	uint32 TotalMemory = Elements.GetAllocatedSize();
+	for (const TPair<const FNavigationRelevantData*, FRecastCachedElementSpans>& It : Elements)
+	{
+		TotalMemory += It.Value.Spans.IsValid() ? It.Value.Spans->GetAllocatedSize() : 0;
+	}
+	return TotalMemory;
+}
+
 FRecastVoxelCache::FRecastVoxelCache(const uint8* Memory)
 {
 	uint8* BytesArr = (uint8*)Memory;
@@ -1991,6 +2012,20 @@ void FRecastTileGenerator::Setup(const FRecastNavMeshGenerator& ParentGenerator,
 
 	// We have to regenerate layers data in case geometry is changed or tile cache is missing
 	bRegenerateCompressedLayers = (bGeometryChanged || CompressedLayers.Num() == 0);
+
+	// Reuse spans of elements that didn't change since the last build of this tile, time sliced builds always rasterize everything
+	if (bRegenerateCompressedLayers && GNavmeshTileSpanCacheSizeMB > 0 && !ParentGenerator.IsTimeSliceRegenActive())
+	{
+		PrevSpanCache = ParentGenerator.GetTileSpanCache(TileX, TileY);
+		if (PrevSpanCache.IsValid() && !(PrevSpanCache->TileBounds == TileBB))
+		{
+			// Navigation bounds changed height, spans have to be rasterized again
+			PrevSpanCache.Reset();
+		}
+
+		SpanCache = MakeShared<FRecastTileSpanCache, ESPMode::ThreadSafe>();
+		SpanCache->TileBounds = TileBB;
+	}
 	
 	// Gather geometry for tile if it inside navigable bounds
 	if (InclusionBounds.Num())
@@ -2251,7 +2286,14 @@ void FRecastTileGenerator::GatherNavigationDataGeometry(const TSharedRef<FNaviga
 		NavSys.DemandLazyDataGathering(*ElementData);
 	}
 				
-	if (ElementData->IsPendingLazyGeometryGathering() && ElementData->SupportsGatheringGeometrySlices())
+	// Elements rasterized by the previous build of the tile don't need their geometry exported again
+	TSharedPtr<const TArray<rcSpanCache>, ESPMode::ThreadSafe> CachedSpans;
+	if (bGeometryChanged && PrevSpanCache.IsValid())
+	{
+		CachedSpans = PrevSpanCache->FindSpans(ElementData);
+	}
+
+	if (ElementData->IsPendingLazyGeometryGathering() && ElementData->SupportsGatheringGeometrySlices() && !CachedSpans.IsValid())
 	{
 		QUICK_SCOPE_CYCLE_COUNTER(STAT_RecastNavMeshGenerator_LandscapeSlicesExporting);
 
@@ -2280,7 +2322,14 @@ void FRecastTileGenerator::GatherNavigationDataGeometry(const TSharedRef<FNaviga
 	const bool bExportGeometry = bGeometryChanged && ElementData->HasGeometry();
 	if (bExportGeometry)
 	{
-		if (ARecastNavMesh::IsVoxelCacheEnabled())
+		if (CachedSpans.IsValid())
+		{
+			FRecastRawGeometryElement& GeometryElement = RawGeometry.AddDefaulted_GetRef();
+			GeometryElement.RasterizationFlags = rcRasterizationFlags(0);
+			GeometryElement.SpanCacheSource = ElementData;
+			GeometryElement.CachedSpans = CachedSpans;
+		}
+		else if (ARecastNavMesh::IsVoxelCacheEnabled())
 		{
 			TNavStatArray<rcSpanCache> SpanData;
 			rcSpanCache* CachedVoxels = 0;
@@ -2573,7 +2622,18 @@ void FRecastTileGenerator::ValidateAndAppendGeometry(const TSharedRef<FNavigatio
 	const FNavigationRelevantData& DataRef = ElementData.Get();
 	if (DataRef.IsCollisionDataValid())
 	{
+		const int32 NumElements = RawGeometry.Num();
 		AppendGeometry(DataRef.CollisionData, InModifier, DataRef.NavDataPerInstanceTransformDelegate);
+
+		// Spans of geometry rasterized in world space without masks can be cached with the tile
+		if (SpanCache.IsValid() && RawGeometry.Num() > NumElements)
+		{
+			FRecastRawGeometryElement& GeometryElement = RawGeometry.Last();
+			if (GeometryElement.PerInstanceTransform.Num() == 0 && GeometryElement.RasterizationFlags == 0)
+			{
+				GeometryElement.SpanCacheSource = ElementData;
+			}
+		}
 	}
 }
 
@@ -2937,7 +2997,12 @@ ETimeSliceWorkResult FRecastTileGenerator::RasterizeTrianglesTimeSliced(FNavMesh
 	while (RasterizeTrianglesTimeSlicedRawGeomIdx < RawGeometry.Num())
 	{
 		const FRecastRawGeometryElement& Element = RawGeometry[RasterizeTrianglesTimeSlicedRawGeomIdx];
-		if (Element.PerInstanceTransform.Num() > 0)
+		if (Element.CachedSpans.IsValid())
+		{
+			// Generator was set up before time slicing got active
+			rcAddSpans(&BuildContext, *RasterContext.SolidHF, TileConfig.walkableClimb, Element.CachedSpans->GetData(), Element.CachedSpans->Num());
+		}
+		else if (Element.PerInstanceTransform.Num() > 0)
 		{
 			while (RasterizeTrianglesTimeSlicedInstTransformIdx < Element.PerInstanceTransform.Num())
 			{
@@ -2986,10 +3051,59 @@ void FRecastTileGenerator::RasterizeTriangles(FNavMeshBuildContext& BuildContext
 	// Rasterize geometry
 	SCOPE_CYCLE_COUNTER(STAT_Navigation_RecastRasterizeTriangles)
 
+	// Elements with cacheable spans are rasterized on their own first, then merged into the tile's heightfield
+	rcHeightfield* ElementHF = nullptr;
+	bool bCanCacheSpans = SpanCache.IsValid();
+
 	for (int32 RawGeomIdx = 0; RawGeomIdx < RawGeometry.Num(); ++RawGeomIdx)
 	{
 		const FRecastRawGeometryElement& Element = RawGeometry[RawGeomIdx];
-		if (Element.PerInstanceTransform.Num() > 0)
+		auto AddCachedSpans = [this, &Element](const TSharedRef<const TArray<rcSpanCache>, ESPMode::ThreadSafe>& Spans)
+		{
+			TSharedPtr<FNavigationRelevantData, ESPMode::ThreadSafe> Source = Element.SpanCacheSource.Pin();
+			if (Source.IsValid())
+			{
+				FRecastCachedElementSpans& ElementSpans = SpanCache->Elements.Add(Source.Get());
+				ElementSpans.Source = Source;
+				ElementSpans.Spans = Spans;
+			}
+		};
+
+		if (Element.CachedSpans.IsValid())
+		{
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_Navigation_RasterizeCachedSpans);
+
+			rcAddSpans(&BuildContext, *RasterContext.SolidHF, TileConfig.walkableClimb, Element.CachedSpans->GetData(), Element.CachedSpans->Num());
+			AddCachedSpans(Element.CachedSpans.ToSharedRef());
+			continue;
+		}
+
+		if (bCanCacheSpans && Element.SpanCacheSource.IsValid() && ElementHF == nullptr)
+		{
+			const rcHeightfield& SolidHF = *RasterContext.SolidHF;
+			ElementHF = rcAllocHeightfield();
+			if (ElementHF == nullptr || !rcCreateHeightfield(&BuildContext, *ElementHF, SolidHF.width, SolidHF.height, SolidHF.bmin, SolidHF.bmax, SolidHF.cs, SolidHF.ch))
+			{
+				BuildContext.log(RC_LOG_WARNING, "RasterizeTriangles: Could not create element heightfield, spans won't be cached.");
+				bCanCacheSpans = false;
+			}
+		}
+
+		if (bCanCacheSpans && Element.SpanCacheSource.IsValid())
+		{
+			rcResetHeightfield(*ElementHF);
+			{
+				TGuardValue<rcHeightfield*> SolidHFGuard(RasterContext.SolidHF, ElementHF);
+				RasterizeGeometryRecast(BuildContext, Element.GeomCoords, Element.GeomIndices, Element.RasterizationFlags, RasterContext);
+			}
+
+			TSharedRef<TArray<rcSpanCache>, ESPMode::ThreadSafe> Spans = MakeShared<TArray<rcSpanCache>, ESPMode::ThreadSafe>();
+			Spans->SetNumUninitialized(rcCountSpans(&BuildContext, *ElementHF));
+			rcCacheSpans(&BuildContext, *ElementHF, Spans->GetData());
+			rcAddSpans(&BuildContext, *RasterContext.SolidHF, TileConfig.walkableClimb, Spans->GetData(), Spans->Num());
+			AddCachedSpans(Spans);
+		}
+		else if (Element.PerInstanceTransform.Num() > 0)
 		{
 			for (const FTransform& InstanceTransform : Element.PerInstanceTransform)
 			{
@@ -3001,6 +3115,8 @@ void FRecastTileGenerator::RasterizeTriangles(FNavMeshBuildContext& BuildContext
 			RasterizeGeometryRecast(BuildContext, Element.GeomCoords, Element.GeomIndices, Element.RasterizationFlags, RasterContext);
 		}
 	}
+
+	rcFreeHeightField(ElementHF);
 }
 
 void FRecastTileGenerator::GenerateRecastFilter(FNavMeshBuildContext& BuildContext, FTileRasterizationContext& RasterContext)
@@ -4439,6 +4555,7 @@ FRecastNavMeshGenerator::FRecastNavMeshGenerator(ARecastNavMesh& InDestNavMesh)
 	, MaxTileGeneratorTasks(1)
 	, AvgLayersPerTile(8.0f)
 	, DestNavMesh(&InDestNavMesh)
+	, TileSpanCacheSize(0)
 	, bInitialized(false)
 	, bRestrictBuildingToActiveTiles(false)
 	, bSortTilesWithSeedLocations(true)
@@ -5711,6 +5828,16 @@ void FRecastNavMeshGenerator::GetSeedLocations(UWorld& World, TArray<FVector2D>&
 			OutSeedLocations.Add(SeedLoc);
 		}
 	}
+
+	// Collect navigation invokers, tiles around them are the ones agents are about to use
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&World);
+	if (NavSys)
+	{
+		for (const FNavigationInvokerRaw& Invoker : NavSys->GetInvokerLocations())
+		{
+			OutSeedLocations.Add(FVector2D(Invoker.Location));
+		}
+	}
 }
 
 TSharedRef<FRecastTileGenerator> FRecastNavMeshGenerator::CreateTileGenerator(const FIntPoint& Coord, const TArray<FBox>& DirtyAreas)
@@ -5748,6 +5875,52 @@ void FRecastNavMeshGenerator::StoreCompressedTileCacheLayers(const FRecastTileGe
 	}
 }
 
+void FRecastNavMeshGenerator::StoreTileSpanCache(const FRecastTileGenerator& TileGenerator, int32 TileX, int32 TileY)
+{
+	const TSharedPtr<FRecastTileSpanCache, ESPMode::ThreadSafe>& SpanCache = TileGenerator.GetSpanCache();
+	if (!SpanCache.IsValid())
+	{
+		// Tile was not rasterized, previously cached spans are still valid
+		return;
+	}
+
+	const FIntPoint TileCoord(TileX, TileY);
+	if (const FTileSpanCacheEntry* OldEntry = TileSpanCaches.Find(TileCoord))
+	{
+		TileSpanCacheSize -= OldEntry->AllocatedSize;
+		TileSpanCaches.Remove(TileCoord);
+	}
+
+	if (SpanCache->Elements.Num() == 0)
+	{
+		return;
+	}
+
+	FTileSpanCacheEntry& Entry = TileSpanCaches.Add(TileCoord);
+	Entry.Spans = SpanCache;
+	Entry.AllocatedSize = SpanCache->GetAllocatedSize();
+	Entry.LastUsedFrame = GFrameCounter;
+	TileSpanCacheSize += Entry.AllocatedSize;
+
+	const uint64 MaxCacheSize = uint64(FMath::Max(GNavmeshTileSpanCacheSizeMB, 0)) * 1024 * 1024;
+	if (TileSpanCacheSize > MaxCacheSize)
+	{
+		// Evict least recently built tiles first
+		TileSpanCaches.ValueSort([](const FTileSpanCacheEntry& A, const FTileSpanCacheEntry& B) { return A.LastUsedFrame < B.LastUsedFrame; });
+		for (TMap<FIntPoint, FTileSpanCacheEntry>::TIterator It = TileSpanCaches.CreateIterator(); It && TileSpanCacheSize > MaxCacheSize; ++It)
+		{
+			TileSpanCacheSize -= It.Value().AllocatedSize;
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TSharedPtr<const FRecastTileSpanCache, ESPMode::ThreadSafe> FRecastNavMeshGenerator::GetTileSpanCache(int32 TileX, int32 TileY) const
+{
+	const FTileSpanCacheEntry* Entry = TileSpanCaches.Find(FIntPoint(TileX, TileY));
+	return Entry ? Entry->Spans : nullptr;
+}
+
 #if RECAST_INTERNAL_DEBUG_DATA
 void FRecastNavMeshGenerator::StoreDebugData(const FRecastTileGenerator& TileGenerator, int32 TileX, int32 TileY)
 {
@@ -5829,6 +6002,7 @@ TArray<uint32> FRecastNavMeshGenerator::ProcessTileTasksAsync(const int32 NumTas
 				UpdatedTiles.Append(UpdatedTileIndices);
 			
 				StoreCompressedTileCacheLayers(TileGenerator, Element.Coord.X, Element.Coord.Y);
+				StoreTileSpanCache(TileGenerator, Element.Coord.X, Element.Coord.Y);
 
 #if RECAST_INTERNAL_DEBUG_DATA
 				StoreDebugData(TileGenerator, Element.Coord.X, Element.Coord.Y);
@@ -6078,6 +6252,7 @@ TArray<uint32> FRecastNavMeshGenerator::ProcessTileTasksSync(const int32 NumTask
 			UpdatedTiles = AddGeneratedTiles(TileGeneratorRef);
 
 			StoreCompressedTileCacheLayers(TileGeneratorRef, TileLocation.X, TileLocation.Y);
+			StoreTileSpanCache(TileGeneratorRef, TileLocation.X, TileLocation.Y);
 		}
 		else if (!bGameStaticNavMesh)
 		{
@@ -6347,8 +6522,9 @@ uint32 FRecastNavMeshGenerator::LogMemUsed() const
 	}
 
 	UE_LOG(LogNavigation, Display, TEXT("    FRecastNavMeshGenerator: Total Generator\'s size %u, count %d"), GeneratorsMem, RunningDirtyTiles.Num());
+	UE_LOG(LogNavigation, Display, TEXT("    FRecastNavMeshGenerator: Tile span cache size %llu, tiles %d"), TileSpanCacheSize, TileSpanCaches.Num());
 
-	return GeneratorsMem + sizeof(FRecastNavMeshGenerator) + PendingDirtyTiles.GetAllocatedSize() + RunningDirtyTiles.GetAllocatedSize();
+	return GeneratorsMem + sizeof(FRecastNavMeshGenerator) + PendingDirtyTiles.GetAllocatedSize() + RunningDirtyTiles.GetAllocatedSize() + uint32(TileSpanCacheSize) + TileSpanCaches.GetAllocatedSize();
 }
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST) && ENABLE_VISUAL_LOG
@@ -0,0 +1,490 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NavMesh/RecastPortalGraph.h"
+#include "Misc/ScopeRWLock.h"
+#include "Algo/Reverse.h"
+
+#if WITH_RECAST
+#include "Detour/DetourNavMeshQuery.h"
+
+namespace FRecastPortalGraphHelpers
+{
+	struct FOpenNode
+	{
+		float Cost;
+		int32 Index;
+
+		FOpenNode(float InCost, int32 InIndex) : Cost(InCost), Index(InIndex) {}
+		bool operator<(const FOpenNode& Other) const { return Cost < Other.Cost; }
+	};
+
+	/** Search node of a portal path, portals are identified by tile and portal index */
+	struct FSearchNode
+	{
+		uint32 Tile;
+		int32 Portal;
+		int32 ParentNode;
+		float Cost;
+		bool bClosed;
+	};
+
+	FORCEINLINE uint64 GetPortalKey(uint32 Tile, int32 Portal)
+	{
+		return ((uint64)Tile << 32) | (uint32)Portal;
+	}
+
+	/** Node keys of the search's start and end, never used by portals */
+	const uint64 StartKey = MAX_uint64;
+	const uint64 EndKey = MAX_uint64 - 1;
+}
+
+bool FRecastPortalGraph::IsBuilt() const
+{
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+	return bIsBuilt;
+}
+
+void FRecastPortalGraph::Build(const dtNavMesh& NavMesh)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	TileGraphs.Reset();
+	for (int32 TileIndex = 0; TileIndex < NavMesh.getMaxTiles(); ++TileIndex)
+	{
+		BuildTile(NavMesh, TileIndex);
+	}
+	bIsBuilt = true;
+}
+
+void FRecastPortalGraph::UpdateTiles(const dtNavMesh& NavMesh, const TArray<uint32>& ChangedTiles)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	if (!bIsBuilt)
+	{
+		return;
+	}
+
+	// Neighbors linked to the old version of a tile lose their links, the ones linked to the new version gain some
+	TSet<uint32> TilesToBuild;
+	for (const uint32 TileIndex : ChangedTiles)
+	{
+		TilesToBuild.Add(TileIndex);
+		if (const FTileGraph* OldTileGraph = TileGraphs.Find(TileIndex))
+		{
+			for (const FPortal& Portal : OldTileGraph->Portals)
+			{
+				TilesToBuild.Add(Portal.NeighborTile);
+			}
+		}
+
+		BuildTile(NavMesh, TileIndex);
+		if (const FTileGraph* NewTileGraph = TileGraphs.Find(TileIndex))
+		{
+			for (const FPortal& Portal : NewTileGraph->Portals)
+			{
+				TilesToBuild.Add(Portal.NeighborTile);
+			}
+		}
+	}
+
+	for (const uint32 TileIndex : TilesToBuild)
+	{
+		if (!ChangedTiles.Contains(TileIndex))
+		{
+			BuildTile(NavMesh, TileIndex);
+		}
+	}
+}
+
+void FRecastPortalGraph::Reset()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	TileGraphs.Empty();
+	bIsBuilt = false;
+}
+
+uint32 FRecastPortalGraph::GetAllocatedSize() const
+{
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+
+	uint32 MemUsed = TileGraphs.GetAllocatedSize();
+	for (const TPair<uint32, FTileGraph>& It : TileGraphs)
+	{
+		const FTileGraph& TileGraph = It.Value;
+		MemUsed += TileGraph.Portals.GetAllocatedSize() + TileGraph.Connections.GetAllocatedSize() + TileGraph.PolyPortals.GetAllocatedSize();
+		for (const FPortal& Portal : TileGraph.Portals)
+		{
+			MemUsed += Portal.LinkedPolys.GetAllocatedSize();
+		}
+	}
+	return MemUsed;
+}
+
+void FRecastPortalGraph::CalcPolyCenters(const dtMeshTile& Tile, TArray<FVector>& OutCenters)
+{
+	const int32 PolyCount = Tile.header->polyCount;
+	OutCenters.Reset(PolyCount);
+	for (int32 PolyIndex = 0; PolyIndex < PolyCount; ++PolyIndex)
+	{
+		const dtPoly& Poly = Tile.polys[PolyIndex];
+		FVector Center = FVector::ZeroVector;
+		for (int32 VertIndex = 0; VertIndex < Poly.vertCount; ++VertIndex)
+		{
+			const float* Vert = &Tile.verts[Poly.verts[VertIndex] * 3];
+			Center += FVector(Vert[0], Vert[1], Vert[2]);
+		}
+		OutCenters.Add(Poly.vertCount > 0 ? Center / Poly.vertCount : Center);
+	}
+}
+
+void FRecastPortalGraph::CalcTileDistances(const dtNavMesh& NavMesh, const dtMeshTile& Tile, const TArray<FVector>& PolyCenters,
+	int32 SourcePoly, const FVector& SourceLocation, const dtQueryFilter* Filter, TArray<float>& OutDistances)
+{
+	using namespace FRecastPortalGraphHelpers;
+
+	const uint32 TileIndex = NavMesh.decodePolyIdTile(NavMesh.getPolyRefBase(&Tile));
+	OutDistances.Init(FLT_MAX, PolyCenters.Num());
+
+	TArray<FOpenNode> OpenList;
+	OutDistances[SourcePoly] = 0.f;
+	OpenList.HeapPush(FOpenNode(0.f, SourcePoly));
+
+	while (OpenList.Num() > 0)
+	{
+		FOpenNode BestNode(0.f, INDEX_NONE);
+		OpenList.HeapPop(BestNode, /*bAllowShrinking=*/false);
+		if (BestNode.Cost > OutDistances[BestNode.Index])
+		{
+			// outdated entry
+			continue;
+		}
+
+		const FVector& NodeLocation = (BestNode.Index == SourcePoly) ? SourceLocation : PolyCenters[BestNode.Index];
+		const dtPoly& Poly = Tile.polys[BestNode.Index];
+		for (unsigned int LinkIndex = Poly.firstLink; LinkIndex != DT_NULL_LINK; LinkIndex = NavMesh.getLink(&Tile, LinkIndex).next)
+		{
+			const dtPolyRef NeighborRef = NavMesh.getLink(&Tile, LinkIndex).ref;
+			if (NeighborRef == 0 || NavMesh.decodePolyIdTile(NeighborRef) != TileIndex)
+			{
+				continue;
+			}
+
+			const int32 NeighborIndex = NavMesh.decodePolyIdPoly(NeighborRef);
+			if (Filter && !Filter->passFilter(NeighborRef, &Tile, &Tile.polys[NeighborIndex]))
+			{
+				continue;
+			}
+
+			const float NeighborCost = BestNode.Cost + FVector::Dist(NodeLocation, PolyCenters[NeighborIndex]);
+			if (NeighborCost < OutDistances[NeighborIndex])
+			{
+				OutDistances[NeighborIndex] = NeighborCost;
+				OpenList.HeapPush(FOpenNode(NeighborCost, NeighborIndex));
+			}
+		}
+	}
+}
+
+void FRecastPortalGraph::BuildTile(const dtNavMesh& NavMesh, uint32 TileIndex)
+{
+	const dtMeshTile* Tile = NavMesh.getTile(TileIndex);
+	if (Tile == nullptr || Tile->header == nullptr || Tile->header->polyCount == 0)
+	{
+		TileGraphs.Remove(TileIndex);
+		return;
+	}
+
+	FTileGraph& TileGraph = TileGraphs.FindOrAdd(TileIndex);
+	TileGraph.TileRef = NavMesh.getTileRef(Tile);
+	TileGraph.Portals.Reset();
+	TileGraph.Connections.Reset();
+	TileGraph.PolyPortals.Reset();
+
+	const int32 PolyCount = Tile->header->polyCount;
+	const dtPolyRef BaseRef = NavMesh.getPolyRefBase(Tile);
+
+	// Gather border polys, grouped by the neighbor tile they link to
+	TMap<uint32, TArray<int32>> BorderPolys;
+	for (int32 PolyIndex = 0; PolyIndex < PolyCount; ++PolyIndex)
+	{
+		const dtPoly& Poly = Tile->polys[PolyIndex];
+		for (unsigned int LinkIndex = Poly.firstLink; LinkIndex != DT_NULL_LINK; LinkIndex = NavMesh.getLink(Tile, LinkIndex).next)
+		{
+			const dtPolyRef NeighborRef = NavMesh.getLink(Tile, LinkIndex).ref;
+			const uint32 NeighborTile = NeighborRef ? NavMesh.decodePolyIdTile(NeighborRef) : TileIndex;
+			if (NeighborTile != TileIndex)
+			{
+				TArray<int32>& Polys = BorderPolys.FindOrAdd(NeighborTile);
+				if (Polys.Num() == 0 || Polys.Last() != PolyIndex)
+				{
+					Polys.Add(PolyIndex);
+				}
+			}
+		}
+	}
+
+	if (BorderPolys.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FVector> PolyCenters;
+	CalcPolyCenters(*Tile, PolyCenters);
+
+	// Split border polys leading to the same tile in runs of polys connected to each other, each run is a portal
+	TArray<int32> PolyRun;
+	for (TPair<uint32, TArray<int32>>& It : BorderPolys)
+	{
+		const uint32 NeighborTile = It.Key;
+		TArray<int32>& Polys = It.Value;
+
+		while (Polys.Num() > 0)
+		{
+			PolyRun.Reset();
+			PolyRun.Add(Polys.Pop(/*bAllowShrinking=*/false));
+			for (int32 RunIndex = 0; RunIndex < PolyRun.Num(); ++RunIndex)
+			{
+				const dtPoly& Poly = Tile->polys[PolyRun[RunIndex]];
+				for (unsigned int LinkIndex = Poly.firstLink; LinkIndex != DT_NULL_LINK; LinkIndex = NavMesh.getLink(Tile, LinkIndex).next)
+				{
+					const dtPolyRef NeighborRef = NavMesh.getLink(Tile, LinkIndex).ref;
+					if (NeighborRef && NavMesh.decodePolyIdTile(NeighborRef) == TileIndex)
+					{
+						const int32 NeighborIndex = NavMesh.decodePolyIdPoly(NeighborRef);
+						if (Polys.RemoveSingleSwap(NeighborIndex, /*bAllowShrinking=*/false) > 0)
+						{
+							PolyRun.Add(NeighborIndex);
+						}
+					}
+				}
+			}
+
+			FVector RunCenter = FVector::ZeroVector;
+			for (const int32 PolyIndex : PolyRun)
+			{
+				RunCenter += PolyCenters[PolyIndex];
+			}
+			RunCenter /= PolyRun.Num();
+
+			const int32 PortalIndex = TileGraph.Portals.AddDefaulted();
+			FPortal& Portal = TileGraph.Portals[PortalIndex];
+			Portal.NeighborTile = NeighborTile;
+			Portal.FirstConnection = 0;
+			Portal.NumConnections = 0;
+
+			float BestDistSq = FLT_MAX;
+			for (const int32 PolyIndex : PolyRun)
+			{
+				const dtPolyRef PolyRef = BaseRef | (dtPolyRef)PolyIndex;
+				const float DistSq = FVector::DistSquared(RunCenter, PolyCenters[PolyIndex]);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Portal.PolyRef = PolyRef;
+					Portal.Location = PolyCenters[PolyIndex];
+				}
+
+				TileGraph.PolyPortals.Add(PolyRef, PortalIndex);
+
+				const dtPoly& Poly = Tile->polys[PolyIndex];
+				for (unsigned int LinkIndex = Poly.firstLink; LinkIndex != DT_NULL_LINK; LinkIndex = NavMesh.getLink(Tile, LinkIndex).next)
+				{
+					const dtPolyRef NeighborRef = NavMesh.getLink(Tile, LinkIndex).ref;
+					if (NeighborRef && NavMesh.decodePolyIdTile(NeighborRef) == NeighborTile)
+					{
+						Portal.LinkedPolys.AddUnique(NeighborRef);
+					}
+				}
+			}
+		}
+	}
+
+	// Connect portals with the lengths of the shortest paths between them inside the tile
+	TArray<float> Distances;
+	for (int32 PortalIndex = 0; PortalIndex < TileGraph.Portals.Num(); ++PortalIndex)
+	{
+		FPortal& Portal = TileGraph.Portals[PortalIndex];
+		CalcTileDistances(NavMesh, *Tile, PolyCenters, NavMesh.decodePolyIdPoly(Portal.PolyRef), Portal.Location, nullptr, Distances);
+
+		Portal.FirstConnection = TileGraph.Connections.Num();
+		for (int32 OtherIndex = 0; OtherIndex < TileGraph.Portals.Num(); ++OtherIndex)
+		{
+			const float Distance = Distances[NavMesh.decodePolyIdPoly(TileGraph.Portals[OtherIndex].PolyRef)];
+			if (OtherIndex != PortalIndex && Distance < FLT_MAX)
+			{
+				TileGraph.Connections.Add({ OtherIndex, Distance });
+			}
+		}
+		Portal.NumConnections = TileGraph.Connections.Num() - Portal.FirstConnection;
+	}
+}
+
+const FRecastPortalGraph::FTileGraph* FRecastPortalGraph::FindTileGraph(const dtNavMesh& NavMesh, uint32 TileIndex) const
+{
+	const FTileGraph* TileGraph = TileGraphs.Find(TileIndex);
+	const dtMeshTile* Tile = TileGraph ? NavMesh.getTile(TileIndex) : nullptr;
+	return (Tile && Tile->header && NavMesh.getTileRef(Tile) == TileGraph->TileRef) ? TileGraph : nullptr;
+}
+
+bool FRecastPortalGraph::FindPortalPath(const dtNavMesh& NavMesh, const dtQueryFilter& Filter,
+	dtPolyRef StartPoly, const FVector& RecastStartPos, dtPolyRef EndPoly, const FVector& RecastEndPos,
+	int32 MaxSearchNodes, TArray<FWaypoint>& OutWaypoints) const
+{
+	using namespace FRecastPortalGraphHelpers;
+
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+
+	const uint32 StartTileIndex = NavMesh.decodePolyIdTile(StartPoly);
+	const uint32 EndTileIndex = NavMesh.decodePolyIdTile(EndPoly);
+	const FTileGraph* StartTileGraph = FindTileGraph(NavMesh, StartTileIndex);
+	const FTileGraph* EndTileGraph = FindTileGraph(NavMesh, EndTileIndex);
+	if (!bIsBuilt || StartTileGraph == nullptr || EndTileGraph == nullptr || StartTileIndex == EndTileIndex)
+	{
+		return false;
+	}
+
+	// Distances from start and to end inside their tiles, links are assumed to be bidirectional
+	const dtMeshTile* StartTile = NavMesh.getTile(StartTileIndex);
+	const dtMeshTile* EndTile = NavMesh.getTile(EndTileIndex);
+	TArray<FVector> StartPolyCenters, EndPolyCenters;
+	TArray<float> StartDistances, EndDistances;
+	CalcPolyCenters(*StartTile, StartPolyCenters);
+	CalcPolyCenters(*EndTile, EndPolyCenters);
+	CalcTileDistances(NavMesh, *StartTile, StartPolyCenters, NavMesh.decodePolyIdPoly(StartPoly), RecastStartPos, &Filter, StartDistances);
+	CalcTileDistances(NavMesh, *EndTile, EndPolyCenters, NavMesh.decodePolyIdPoly(EndPoly), RecastEndPos, &Filter, EndDistances);
+
+	TArray<FSearchNode> Nodes;
+	TMap<uint64, int32> NodeIndices;
+	TArray<FOpenNode> OpenList;
+	int32 EndNodeIndex = INDEX_NONE;
+
+	auto VisitNode = [&](uint64 Key, uint32 Tile, int32 Portal, const FVector& Location, int32 ParentNode, float Cost)
+	{
+		int32* ExistingIndex = NodeIndices.Find(Key);
+		if (ExistingIndex == nullptr)
+		{
+			if (Nodes.Num() >= MaxSearchNodes)
+			{
+				return;
+			}
+			const int32 NodeIndex = Nodes.Add({ Tile, Portal, ParentNode, Cost, false });
+			NodeIndices.Add(Key, NodeIndex);
+			OpenList.HeapPush(FOpenNode(Cost + FVector::Dist(Location, RecastEndPos), NodeIndex));
+		}
+		else if (!Nodes[*ExistingIndex].bClosed && Cost < Nodes[*ExistingIndex].Cost)
+		{
+			Nodes[*ExistingIndex].ParentNode = ParentNode;
+			Nodes[*ExistingIndex].Cost = Cost;
+			OpenList.HeapPush(FOpenNode(Cost + FVector::Dist(Location, RecastEndPos), *ExistingIndex));
+		}
+	};
+
+	auto VisitPortal = [&](uint32 Tile, const FTileGraph& TileGraph, int32 Portal, int32 ParentNode, float Cost)
+	{
+		const FPortal& PortalData = TileGraph.Portals[Portal];
+		const dtMeshTile* MeshTile = NavMesh.getTile(Tile);
+		const dtPoly* Poly = &MeshTile->polys[NavMesh.decodePolyIdPoly(PortalData.PolyRef)];
+		if (Filter.passFilter(PortalData.PolyRef, MeshTile, Poly))
+		{
+			VisitNode(GetPortalKey(Tile, Portal), Tile, Portal, PortalData.Location, ParentNode, Cost);
+		}
+	};
+
+	const int32 StartNodeIndex = Nodes.Add({ StartTileIndex, INDEX_NONE, INDEX_NONE, 0.f, true });
+	NodeIndices.Add(StartKey, StartNodeIndex);
+	for (int32 PortalIndex = 0; PortalIndex < StartTileGraph->Portals.Num(); ++PortalIndex)
+	{
+		const float Distance = StartDistances[NavMesh.decodePolyIdPoly(StartTileGraph->Portals[PortalIndex].PolyRef)];
+		if (Distance < FLT_MAX)
+		{
+			VisitPortal(StartTileIndex, *StartTileGraph, PortalIndex, StartNodeIndex, Distance);
+		}
+	}
+
+	while (OpenList.Num() > 0)
+	{
+		FOpenNode BestOpenNode(0.f, INDEX_NONE);
+		OpenList.HeapPop(BestOpenNode, /*bAllowShrinking=*/false);
+
+		FSearchNode& BestNode = Nodes[BestOpenNode.Index];
+		if (BestNode.bClosed)
+		{
+			continue;
+		}
+		BestNode.bClosed = true;
+
+		if (BestOpenNode.Index == EndNodeIndex)
+		{
+			break;
+		}
+
+		const uint32 Tile = BestNode.Tile;
+		const int32 Portal = BestNode.Portal;
+		const float Cost = BestNode.Cost;
+		const FTileGraph* TileGraph = FindTileGraph(NavMesh, Tile);
+		if (TileGraph == nullptr)
+		{
+			continue;
+		}
+		const FPortal& PortalData = TileGraph->Portals[Portal];
+
+		// other portals of the same tile
+		for (int32 ConnectionIndex = 0; ConnectionIndex < PortalData.NumConnections; ++ConnectionIndex)
+		{
+			const FConnection& Connection = TileGraph->Connections[PortalData.FirstConnection + ConnectionIndex];
+			VisitPortal(Tile, *TileGraph, Connection.Portal, BestOpenNode.Index, Cost + Connection.Cost);
+		}
+
+		// path end
+		if (Tile == EndTileIndex)
+		{
+			const float Distance = EndDistances[NavMesh.decodePolyIdPoly(PortalData.PolyRef)];
+			if (Distance < FLT_MAX)
+			{
+				VisitNode(EndKey, EndTileIndex, INDEX_NONE, RecastEndPos, BestOpenNode.Index, Cost + Distance);
+				const int32* EndNodeIndexPtr = NodeIndices.Find(EndKey);
+				EndNodeIndex = EndNodeIndexPtr ? *EndNodeIndexPtr : INDEX_NONE;
+			}
+		}
+
+		// portals of the neighbor tile leading back to this one
+		const FTileGraph* NeighborTileGraph = FindTileGraph(NavMesh, PortalData.NeighborTile);
+		if (NeighborTileGraph)
+		{
+			for (const dtPolyRef LinkedPoly : PortalData.LinkedPolys)
+			{
+				for (TMultiMap<dtPolyRef, int32>::TConstKeyIterator It(NeighborTileGraph->PolyPortals, LinkedPoly); It; ++It)
+				{
+					const FPortal& NeighborPortal = NeighborTileGraph->Portals[It.Value()];
+					if (NeighborPortal.NeighborTile == Tile)
+					{
+						VisitPortal(PortalData.NeighborTile, *NeighborTileGraph, It.Value(), BestOpenNode.Index,
+							Cost + FVector::Dist(PortalData.Location, NeighborPortal.Location));
+					}
+				}
+			}
+		}
+	}
+
+	if (EndNodeIndex == INDEX_NONE || !Nodes[EndNodeIndex].bClosed)
+	{
+		return false;
+	}
+
+	OutWaypoints.Reset();
+	OutWaypoints.Add(FWaypoint(EndPoly, RecastEndPos));
+	for (int32 NodeIndex = Nodes[EndNodeIndex].ParentNode; NodeIndex != StartNodeIndex; NodeIndex = Nodes[NodeIndex].ParentNode)
+	{
+		const FSearchNode& Node = Nodes[NodeIndex];
+		const FPortal& PortalData = TileGraphs.FindChecked(Node.Tile).Portals[Node.Portal];
+		OutWaypoints.Add(FWaypoint(PortalData.PolyRef, PortalData.Location));
+	}
+	OutWaypoints.Add(FWaypoint(StartPoly, RecastStartPos));
+	Algo::Reverse(OutWaypoints);
+
+	return true;
+}
+
+#endif // WITH_RECAST
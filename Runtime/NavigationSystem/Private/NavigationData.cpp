@@ -105,6 +105,7 @@ FAsyncPathFindingQuery::FAsyncPathFindingQuery(const UObject* InOwner, const ANa
 , QueryID(GetUniqueID())
 , OnDoneDelegate(Delegate)
 , Mode(EPathFindingMode::Regular)
+, RequestTime(FPlatformTime::Seconds())
 {
 
 }
@@ -114,6 +115,7 @@ FAsyncPathFindingQuery::FAsyncPathFindingQuery(const FPathFindingQuery& Query, c
 , QueryID(GetUniqueID())
 , OnDoneDelegate(Delegate)
 , Mode(QueryMode)
+, RequestTime(FPlatformTime::Seconds())
 {
 
 }
@@ -150,6 +152,7 @@ ANavigationData::ANavigationData(const FObjectInitializer& ObjectInitializer)
 	, FindHierarchicalPathImplementation(NULL)
 	, bRegistered(false)
 	, bRebuildingSuspended(false)
+	, bSupportsConcurrentPathfinding(false)
 #if WITH_EDITORONLY_DATA
 	, bIsBuildingOnLoad(false)
 #endif
@@ -23,11 +23,14 @@
 #include "UObject/Package.h"
 #include "Components/PrimitiveComponent.h"
 #include "UObject/UObjectThreadContext.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_RECAST
 #include "NavMesh/RecastNavMesh.h"
 #include "NavMesh/RecastHelpers.h"
 #include "NavMesh/RecastNavMeshGenerator.h"
+#include "NavMesh/PImplRecastNavMesh.h"
 #endif // WITH_RECAST
 #if WITH_EDITOR
 #include "EditorModeManager.h"
@@ -127,6 +130,38 @@ DEFINE_STAT(STAT_Navigation_RecastMemory);
 CSV_DEFINE_CATEGORY(NavigationSystem, false);
 CSV_DEFINE_CATEGORY(NavTasks, true);
 
+namespace FNavigationSystem
+{
+	/** Minimal number of concurrent capable queries in a batch before they are spread over the task graph workers */
+	int32 AsyncPathfindingParallelMinQueries = 8;
+	static FAutoConsoleVariableRef CVarAsyncPathfindingParallelMinQueries(TEXT("n.AsyncPathfindingParallelMinQueries"), AsyncPathfindingParallelMinQueries,
+		TEXT("Minimal number of async pathfinding queries in a batch before they are processed in parallel. 0 disables parallel processing."), ECVF_Default);
+
+	/** Whether concurrent capable queries of a batch going to the same location share the corridors they find */
+	int32 AsyncPathfindingShareGoalSearch = 1;
+	static FAutoConsoleVariableRef CVarAsyncPathfindingShareGoalSearch(TEXT("n.AsyncPathfindingShareGoalSearch"), AsyncPathfindingShareGoalSearch,
+		TEXT("If 1, async pathfinding queries of a batch going to the same location with the same filter are processed together on one worker,\n")
+		TEXT("and the ones starting on the corridor found by a previous query reuse it instead of searching the navmesh again."), ECVF_Default);
+
+	/** Queries of an async pathfinding batch that can share the corridors they find, see FRecastSharedGoalScope */
+	struct FAsyncPathFindingGoalKey
+	{
+		const ANavigationData* NavData;
+		FVector EndLocation;
+		const FNavigationQueryFilter* QueryFilter;
+
+		bool operator==(const FAsyncPathFindingGoalKey& Other) const
+		{
+			return NavData == Other.NavData && EndLocation == Other.EndLocation && QueryFilter == Other.QueryFilter;
+		}
+
+		friend uint32 GetTypeHash(const FAsyncPathFindingGoalKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.NavData), GetTypeHash(Key.EndLocation)), PointerHash(Key.QueryFilter));
+		}
+	};
+}
+
 //----------------------------------------------------------------------//
 // consts
 //----------------------------------------------------------------------//
@@ -1235,6 +1270,7 @@ void UNavigationSystemV1::Tick(float DeltaSeconds)
 	// completed queries before to keep the list safe.
 	TArray<FAsyncPathFindingQuery> AsyncPathFindingCompletedQueriesToDispatch;
 	Swap(AsyncPathFindingCompletedQueriesToDispatch, AsyncPathFindingCompletedQueries);
+	AsyncPathFindingStats = AsyncPathFindingTaskStats;
 
 	// Trigger the async pathfinding queries (new ones and those that may have been postponed from last frame)
 	if (AsyncPathFindingQueries.Num() > 0)
@@ -1475,12 +1511,58 @@ void UNavigationSystemV1::PerformAsyncQueries(TArray<FAsyncPathFindingQuery> Pat
 		return;
 	}
 
-	int32 NumProcessed = 0;
-	for (FAsyncPathFindingQuery& Query : PathFindingQueries)
+	const double BatchStartTime = FPlatformTime::Seconds();
+	const int32 NumQueries = PathFindingQueries.Num();
+
+	// Resolve navigation data up front so queries can be split between the ones
+	// that may run concurrently and the ones that have to run on this thread
+	// @todo this is not necessarily the safest way to use UObjects outside of main thread. 
+	//	think about something else.
+	TArray<const ANavigationData*, TInlineAllocator<64>> QueryNavData;
+	TArray<int32, TInlineAllocator<64>> ConcurrentQueries;
+	TArray<int32, TInlineAllocator<64>> SerialQueries;
+	QueryNavData.AddUninitialized(NumQueries);
+	const ANavigationData* DefaultNavData = nullptr;
+	bool bDefaultNavDataResolved = false;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		const FAsyncPathFindingQuery& Query = PathFindingQueries[QueryIndex];
+		const ANavigationData* NavData = Query.NavData.Get();
+		if (NavData == nullptr)
+		{
+			if (!bDefaultNavDataResolved)
+			{
+				DefaultNavData = GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
+				bDefaultNavDataResolved = true;
+			}
+			NavData = DefaultNavData;
+		}
+
+		QueryNavData[QueryIndex] = NavData;
+		if (NavData && NavData->SupportsConcurrentPathfinding())
+		{
+			ConcurrentQueries.Add(QueryIndex);
+		}
+		else
+		{
+			SerialQueries.Add(QueryIndex);
+		}
+	}
+
+	// Completion time of each query, 0 for the ones that were postponed by an abort request
+	TArray<double, TInlineAllocator<64>> CompletionTimes;
+	CompletionTimes.AddZeroed(NumQueries);
+
+	auto ProcessQuery = [this, &PathFindingQueries, &QueryNavData, &CompletionTimes](const int32 QueryIndex)
 	{
-		// @todo this is not necessarily the safest way to use UObjects outside of main thread. 
-		//	think about something else.
-		const ANavigationData* NavData = Query.NavData.IsValid() ? Query.NavData.Get() : GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
+		// Check for abort request from the main tread
+		if (bAbortAsyncQueriesRequested)
+		{
+			return;
+		}
+
+		FAsyncPathFindingQuery& Query = PathFindingQueries[QueryIndex];
+		const ANavigationData* NavData = QueryNavData[QueryIndex];
 
 		// perform query
 		if (NavData)
@@ -1498,28 +1580,113 @@ void UNavigationSystemV1::PerformAsyncQueries(TArray<FAsyncPathFindingQuery> Pat
 		{
 			Query.Result = ENavigationQueryResult::Error;
 		}
-		++NumProcessed;
 
-		// Check for abort request from the main tread
-		if (bAbortAsyncQueriesRequested)
+		CompletionTimes[QueryIndex] = FPlatformTime::Seconds();
+	};
+
+	TAtomic<int32> NumSharedGoalQueries(0);
+	if (ConcurrentQueries.Num() > 0)
+	{
+		// Queries going to the same location with the same filter run as one work item, so the ones starting on the corridor
+		// found by a previous query of the group reuse it. A large group stays on one worker, which trades the latency of its
+		// last queries for not searching the navmesh again.
+		TArray<TArray<int32, TInlineAllocator<4>>, TInlineAllocator<64>> QueryGroups;
+		QueryGroups.Reserve(ConcurrentQueries.Num());
 		{
-			break;
+			TMap<FNavigationSystem::FAsyncPathFindingGoalKey, int32, TInlineSetAllocator<64>> GoalToGroup;
+			for (const int32 QueryIndex : ConcurrentQueries)
+			{
+				const FAsyncPathFindingQuery& Query = PathFindingQueries[QueryIndex];
+				const bool bCanShareGoal = FNavigationSystem::AsyncPathfindingShareGoalSearch != 0
+					&& Query.Mode == EPathFindingMode::Regular
+					&& Query.CostLimit == FLT_MAX
+					&& Query.QueryFilter.IsValid();
+				if (bCanShareGoal)
+				{
+					const FNavigationSystem::FAsyncPathFindingGoalKey GoalKey = { QueryNavData[QueryIndex], Query.EndLocation, Query.QueryFilter.Get() };
+					if (const int32* GroupIndex = GoalToGroup.Find(GoalKey))
+					{
+						QueryGroups[*GroupIndex].Add(QueryIndex);
+						continue;
+					}
+					GoalToGroup.Add(GoalKey, QueryGroups.Num());
+				}
+				QueryGroups.AddDefaulted_GetRef().Add(QueryIndex);
+			}
 		}
+
+		const bool bForceSingleThread = FNavigationSystem::AsyncPathfindingParallelMinQueries <= 0
+			|| ConcurrentQueries.Num() < FNavigationSystem::AsyncPathfindingParallelMinQueries;
+		ParallelFor(QueryGroups.Num(), [&ProcessQuery, &QueryGroups, &PathFindingQueries, &NumSharedGoalQueries](const int32 GroupIndex)
+		{
+			const TArray<int32, TInlineAllocator<4>>& QueryGroup = QueryGroups[GroupIndex];
+			if (QueryGroup.Num() == 1)
+			{
+				ProcessQuery(QueryGroup[0]);
+				return;
+			}
+
+#if WITH_RECAST
+			FRecastSharedGoalScope SharedGoal(*PathFindingQueries[QueryGroup[0]].QueryFilter);
+#endif // WITH_RECAST
+			for (const int32 QueryIndex : QueryGroup)
+			{
+				ProcessQuery(QueryIndex);
+			}
+#if WITH_RECAST
+			NumSharedGoalQueries += SharedGoal.GetNumReusedCorridors();
+#endif // WITH_RECAST
+		}, bForceSingleThread);
 	}
 
-	const int32 NumQueries = PathFindingQueries.Num();
-	const int32 NumPostponed = NumQueries - NumProcessed;
+	for (const int32 QueryIndex : SerialQueries)
+	{
+		ProcessQuery(QueryIndex);
+	}
+
+	FNavAsyncPathFindingStats Stats;
+	Stats.NumConcurrentQueries = ConcurrentQueries.Num();
+	Stats.NumSharedGoalQueries = NumSharedGoalQueries;
+	double TotalLatency = 0.;
+	double MaxLatency = 0.;
 
-	// Queue remaining queries for next frame
-	if (bAbortAsyncQueriesRequested)
+	// Append completed queries to the list dispatched in main thread and queue remaining ones for next frame,
+	// keeping the requests order
+	AsyncPathFindingCompletedQueries.Reserve(AsyncPathFindingCompletedQueries.Num() + NumQueries);
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
 	{
-		AsyncPathFindingQueries.Append(PathFindingQueries.GetData() + NumProcessed, NumPostponed);
+		FAsyncPathFindingQuery& Query = PathFindingQueries[QueryIndex];
+		if (CompletionTimes[QueryIndex] > 0.)
+		{
+			const double Latency = CompletionTimes[QueryIndex] - Query.RequestTime;
+			TotalLatency += Latency;
+			MaxLatency = FMath::Max(MaxLatency, Latency);
+			AsyncPathFindingCompletedQueries.Add(MoveTemp(Query));
+			++Stats.NumCompletedQueries;
+		}
+		else
+		{
+			AsyncPathFindingQueries.Add(MoveTemp(Query));
+			++Stats.NumPostponedQueries;
+		}
 	}
-	
-	// Append to list of completed queries to dispatch results in main thread
-	AsyncPathFindingCompletedQueries.Append(PathFindingQueries.GetData(), NumProcessed);
 
-	UE_LOG(LogNavigation, Log, TEXT("Async pathfinding queries: %d completed, %d postponed to next frame"), NumProcessed, NumPostponed);
+	const double BatchTime = FPlatformTime::Seconds() - BatchStartTime;
+	Stats.BatchTimeMs = float(BatchTime * 1000.);
+	Stats.QueriesPerSecond = BatchTime > 0. ? float(Stats.NumCompletedQueries / BatchTime) : 0.f;
+	if (Stats.NumCompletedQueries > 0)
+	{
+		Stats.AverageLatencyMs = float(TotalLatency * 1000. / Stats.NumCompletedQueries);
+		Stats.MaxLatencyMs = float(MaxLatency * 1000.);
+	}
+	AsyncPathFindingTaskStats = Stats;
+
+	CSV_CUSTOM_STAT(NavigationSystem, AsyncPathfindingCompleted, Stats.NumCompletedQueries, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(NavigationSystem, AsyncPathfindingPostponed, Stats.NumPostponedQueries, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(NavigationSystem, AsyncPathfindingMaxLatencyMs, Stats.MaxLatencyMs, ECsvCustomStatOp::Max);
+
+	UE_LOG(LogNavigation, Log, TEXT("Async pathfinding queries: %d completed (%d concurrently), %d postponed to next frame, %.2fms, average latency %.2fms"),
+		Stats.NumCompletedQueries, Stats.NumConcurrentQueries, Stats.NumPostponedQueries, Stats.BatchTimeMs, Stats.AverageLatencyMs);
 }
 
 bool UNavigationSystemV1::GetRandomPoint(FNavLocation& ResultLocation, ANavigationData* NavData, FSharedConstNavQueryFilter QueryFilter)
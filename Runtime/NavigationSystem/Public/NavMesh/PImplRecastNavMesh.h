@@ -14,6 +14,7 @@
 #include "AI/Navigation/NavigationTypes.h"
 #include "NavMesh/RecastNavMesh.h"
 #include "NavMesh/RecastQueryFilter.h"
+#include "NavMesh/RecastPortalGraph.h"
 
 #if RECAST_INTERNAL_DEBUG_DATA
 #include "NavMesh/RecastInternalDebugData.h"
@@ -30,6 +31,55 @@ class FRecastNavMeshGenerator;
 
 #define RECAST_VERY_SMALL_AGENT_RADIUS 0.0f
 
+/**
+ * Shares the path corridors found to one goal between the FindPath calls made on this thread while the scope is alive.
+ *
+ * The first complete corridor found to the goal is recorded, and so is every corridor reaching the goal afterwards.
+ * A query starting on a polygon of a recorded corridor reuses the rest of that corridor instead of searching the navmesh,
+ * only string pulling runs again. Corridors going through nav links are not recorded as links can be filtered per querier.
+ * Async pathfinding batches open a scope around the queries going to the same location with the same filter.
+ * Scopes are thread local and can't be nested.
+ */
+class NAVIGATIONSYSTEM_API FRecastSharedGoalScope
+{
+public:
+	FRecastSharedGoalScope(const FNavigationQueryFilter& InFilter);
+	~FRecastSharedGoalScope();
+
+	/** Returns the scope opened on this thread, if any */
+	static FRecastSharedGoalScope* Get();
+
+	int32 GetNumReusedCorridors() const { return NumReusedCorridors; }
+
+private:
+	friend class FPImplRecastNavMesh;
+
+	/** Whether a search with these parameters can use and record corridors of this scope */
+	bool CanShare(const dtNavMesh* InNavMesh, const FNavigationQueryFilter& InFilter, float CostLimit) const;
+
+	/** Fills PathResult with the rest of a recorded corridor going from StartPolyID to EndPolyID, if any */
+	bool FindCorridor(NavNodeRef StartPolyID, NavNodeRef EndPolyID, const FVector& RecastEndPos, dtQueryResult& PathResult);
+
+	/** Records the corridor found by a search */
+	void AddCorridor(const dtNavMesh* InNavMesh, NavNodeRef EndPolyID, const FVector& RecastEndPos, dtStatus FindPathStatus, const dtQueryResult& PathResult);
+
+	struct FCorridorPoly
+	{
+		int32 CorridorIndex;
+		int32 PolyIndex;
+	};
+
+	const FNavigationQueryFilter* Filter;
+	const dtNavMesh* NavMesh;
+	NavNodeRef GoalPolyID;
+	FVector RecastGoalPos;
+	TArray<TArray<NavNodeRef>> Corridors;
+	TArray<TArray<float>> CorridorCosts;
+	/** First corridor going through each poly, the last poly of the corridors (the goal) is left out */
+	TMap<NavNodeRef, FCorridorPoly> PolyToCorridor;
+	int32 NumReusedCorridors;
+};
+
 /** Engine Private! - Private Implementation details of ARecastNavMesh */
 class NAVIGATIONSYSTEM_API FPImplRecastNavMesh
 {
@@ -82,6 +132,15 @@ public:
 	/** Generates path from the given query. Synchronous. */
 	ENavigationQueryResult::Type FindPath(const FVector& StartLoc, const FVector& EndLoc, const float CostLimit, FNavMeshPath& Path, const FNavigationQueryFilter& Filter, const UObject* Owner) const;
 
+	/** Generates path from the given query, searching the portal graph first for distant locations. Synchronous. */
+	ENavigationQueryResult::Type FindHierarchicalPath(const FVector& StartLoc, const FVector& EndLoc, const float CostLimit, FNavMeshPath& Path, const FNavigationQueryFilter& Filter, const UObject* Owner) const;
+
+	/** Builds the portal graph for the whole navmesh if the owner uses it, removes it otherwise */
+	void RebuildPortalGraph();
+
+	/** Updates the portal graph after tiles have been added, removed or rebuilt, does nothing if the graph isn't built */
+	void UpdatePortalGraph(const TArray<uint32>& ChangedTiles);
+
 	/** Check if path exists */
 	ENavigationQueryResult::Type TestPath(const FVector& StartLoc, const FVector& EndLoc, const FNavigationQueryFilter& Filter, const UObject* Owner, int32* NumVisitedNodes = 0) const;
 
@@ -236,6 +295,27 @@ public:
 	/** query used for searching data on game thread */
 	mutable dtNavMeshQuery SharedNavQuery;
 
+	/** abstract graph used by hierarchical path finding, built with the navmesh and updated with its tiles on the game thread
+	 *	when the owner has bUsePortalGraphForHierarchicalPathfinding set */
+	FRecastPortalGraph PortalGraph;
+
+	/**
+	 * Grants the query used for searching data on the calling thread when it's not the game thread, reused between queries.
+	 * If that query is already in use further up the callstack, e.g. by a link filter running a nested search, a private query is used instead.
+	 */
+	class NAVIGATIONSYSTEM_API FScopedThreadNavQuery
+	{
+	public:
+		FScopedThreadNavQuery() = default;
+		~FScopedThreadNavQuery();
+
+		dtNavMeshQuery& Get();
+
+	private:
+		TUniquePtr<dtNavMeshQuery> PrivateQuery;
+		bool bUsesThreadQuery = false;
+	};
+
 	/** Helper function to serialize a single Recast tile. */
 	static void SerializeRecastMeshTile(FArchive& Ar, int32 NavMeshVersion, unsigned char*& TileData, int32& TileDataSize);
 
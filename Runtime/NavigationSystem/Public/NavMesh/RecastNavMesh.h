@@ -692,6 +692,16 @@ public:
 	UPROPERTY(EditAnywhere, Category = Query, config, meta = (ClampMin = "0.0"))
 	float VerticalDeviationFromGroundCompensation;
 
+	/** if set, a portal graph is built with the navmesh and kept up to date with its tiles, and hierarchical path finding
+	 *	searches it for distant locations. Otherwise hierarchical path finding is regular path finding and nothing is built */
+	UPROPERTY(EditAnywhere, Category = Query, config)
+	uint32 bUsePortalGraphForHierarchicalPathfinding:1;
+
+	/** Minimal distance in tiles between start and end of hierarchical path finding queries to search the portal graph,
+	 *	closer queries use regular path finding */
+	UPROPERTY(EditAnywhere, Category = Query, config, meta = (ClampMin = "1", EditCondition = "bUsePortalGraphForHierarchicalPathfinding"))
+	int32 HierarchicalPathMinTileDistance;
+
 	/** broadcast for navmesh updates */
 	FOnNavMeshUpdate OnNavMeshUpdate;
 
@@ -1009,6 +1019,8 @@ public:
 	
 	// @todo docuement
 	static FPathFindingResult FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
+	/** Finds path refining a path through the portal graph, see FRecastPortalGraph. Falls back to FindPath for close locations. */
+	static FPathFindingResult FindHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
 	static bool TestPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes);
 	static bool TestHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes);
 	static bool NavMeshRaycast(const ANavigationData* Self, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier, FRaycastResult& Result);
@@ -1073,6 +1085,8 @@ private:
 	friend class FPImplRecastNavMesh;
 	// destroys FPImplRecastNavMesh instance if it has been created 
 	void DestroyRecastPImpl();
+	/** shared implementation of FindPath and FindHierarchicalPath */
+	static FPathFindingResult FindPathInternal(const FPathFindingQuery& Query, bool bHierarchical);
 	// @todo docuement
 	void UpdateNavVersion();
 	void UpdateNavObject();
@@ -162,6 +162,39 @@ struct FRecastRawGeometryElement
 	TArray<FTransform>	PerInstanceTransform;
 
 	rcRasterizationFlags RasterizationFlags;
+
+	// Element the geometry comes from, set when its rasterized spans can be cached for the tile
+	TWeakPtr<FNavigationRelevantData, ESPMode::ThreadSafe> SpanCacheSource;
+
+	// Spans rasterized by a previous build of the tile, geometry is not gathered when set
+	TSharedPtr<const TArray<rcSpanCache>, ESPMode::ThreadSafe> CachedSpans;
+};
+
+/** Rasterized spans of a single navigation relevant element in a tile */
+struct FRecastCachedElementSpans
+{
+	TWeakPtr<FNavigationRelevantData, ESPMode::ThreadSafe> Source;
+	TSharedPtr<const TArray<rcSpanCache>, ESPMode::ThreadSafe> Spans;
+};
+
+/**
+ * Rasterized spans of a tile, stored per geometry element so that rebuilding the tile after a local change
+ * (e.g. a destructible breaking) only rasterizes the elements that were added or replaced since the last build.
+ * Elements with per instance transforms or filling collision underneath are always rasterized.
+ */
+struct FRecastTileSpanCache
+{
+	/** Tile bounds the spans were rasterized for, Unreal coords */
+	FBox TileBounds;
+
+	TMap<const FNavigationRelevantData*, FRecastCachedElementSpans> Elements;
+
+	FRecastTileSpanCache() : TileBounds(ForceInit) {}
+
+	/** Returns spans cached for ElementData, or nullptr if the element was replaced since they were rasterized */
+	TSharedPtr<const TArray<rcSpanCache>, ESPMode::ThreadSafe> FindSpans(const TSharedRef<FNavigationRelevantData, ESPMode::ThreadSafe>& ElementData) const;
+
+	uint32 GetAllocatedSize() const;
 };
 
 struct FRecastAreaNavModifierElement
@@ -291,6 +324,8 @@ public:
 	bool HasDataToBuild() const;
 
 	const TArray<FNavMeshTileData>& GetCompressedLayers() const { return CompressedLayers; }
+	/** Rasterized spans of this build, not set when the tile was not rasterized or span caching is disabled */
+	const TSharedPtr<FRecastTileSpanCache, ESPMode::ThreadSafe>& GetSpanCache() const { return SpanCache; }
 
 protected:
 	// to be used solely by FRecastNavMeshGenerator
@@ -459,6 +494,10 @@ protected:
 	
 	// tile's geometry: without voxel cache
 	TArray<FRecastRawGeometryElement> RawGeometry;
+	// spans cached by the previous build of this tile, shared with the parent generator
+	TSharedPtr<const FRecastTileSpanCache, ESPMode::ThreadSafe> PrevSpanCache;
+	// spans rasterized or reused by this build
+	TSharedPtr<FRecastTileSpanCache, ESPMode::ThreadSafe> SpanCache;
 	// areas used for creating navigation data: obstacles
 	TArray<FRecastAreaNavModifierElement> Modifiers;
 	// navigation links
@@ -691,6 +730,9 @@ public:
 	
 	void SetNextTimeSliceRegenActive(bool bRegenState) { SyncTimeSlicedData.bNextTimeSliceRegenActive = bRegenState; }
 
+	/** Returns rasterized spans cached for the tile, if any */
+	TSharedPtr<const FRecastTileSpanCache, ESPMode::ThreadSafe> GetTileSpanCache(int32 TileX, int32 TileY) const;
+
 protected:
 	// Performs initial setup of member variables so that generator is ready to
 	// do its thing from this point on. Called just after construction by ARecastNavMesh
@@ -724,6 +766,9 @@ protected:
 	
 	void StoreCompressedTileCacheLayers(const FRecastTileGenerator& TileGenerator, int32 TileX, int32 TileY);
 
+	/** Stores spans rasterized by TileGenerator so that the next build of the tile can reuse them, evicts least recently used tiles over budget */
+	void StoreTileSpanCache(const FRecastTileGenerator& TileGenerator, int32 TileX, int32 TileY);
+
 #if RECAST_INTERNAL_DEBUG_DATA
 	void StoreDebugData(const FRecastTileGenerator& TileGenerator, int32 TileX, int32 TileY);
 #endif
@@ -828,6 +873,19 @@ protected:
 
 	/** Use this if you don't want your tiles to start at (0,0,0) */
 	FVector RcNavMeshOrigin;
+
+	struct FTileSpanCacheEntry
+	{
+		TSharedPtr<const FRecastTileSpanCache, ESPMode::ThreadSafe> Spans;
+		uint32 AllocatedSize;
+		uint64 LastUsedFrame;
+	};
+
+	/** Rasterized spans of built tiles, see FRecastTileSpanCache */
+	TMap<FIntPoint, FTileSpanCacheEntry> TileSpanCaches;
+
+	/** Memory used by TileSpanCaches */
+	uint64 TileSpanCacheSize;
 	
 	uint32 bInitialized:1;
 
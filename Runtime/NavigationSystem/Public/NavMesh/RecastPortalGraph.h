@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#if WITH_RECAST
+#include "Detour/DetourNavMesh.h"
+
+class dtQueryFilter;
+
+/**
+ * Abstract graph of a Recast navmesh used by hierarchical pathfinding.
+ *
+ * Nodes are portals: runs of connected polys on a tile's border linking to the same neighbor tile.
+ * Portals of a tile are connected with each other by the length of the shortest path between them inside the tile,
+ * and with the portals of the neighbor tiles they link to. The graph is stored per tile, so it's kept in sync with
+ * the navmesh by rebuilding the changed tiles and their neighbors. Tiles replaced in the navmesh but not rebuilt yet
+ * are ignored by searches.
+ *
+ * Costs are geometric, area costs of the query filter are not taken into account: portal paths are meant to be refined
+ * with regular polygon searches between consecutive waypoints.
+ */
+class FRecastPortalGraph
+{
+public:
+	/** Waypoint of a portal path */
+	struct FWaypoint
+	{
+		/** Poly to pass through */
+		dtPolyRef PolyRef;
+
+		/** Location on the poly, in Recast coords */
+		FVector Location;
+
+		FWaypoint(dtPolyRef InPolyRef, const FVector& InLocation) : PolyRef(InPolyRef), Location(InLocation) {}
+	};
+
+	/** Whether the graph has been built for the current navmesh */
+	bool IsBuilt() const;
+
+	/** Builds the graph for all tiles of NavMesh, replacing existing data */
+	void Build(const dtNavMesh& NavMesh);
+
+	/** Rebuilds the graph of changed tiles and their neighbors. Does nothing if the graph hasn't been built yet. */
+	void UpdateTiles(const dtNavMesh& NavMesh, const TArray<uint32>& ChangedTiles);
+
+	/** Removes all data, e.g. when the navmesh is released */
+	void Reset();
+
+	/**
+	 * Searches the portal graph for a path between two polys in different tiles.
+	 * Waypoints start with StartPoly and end with EndPoly, consecutive waypoints are in the same or in neighbor tiles.
+	 *
+	 * @param MaxSearchNodes	limit of portal nodes visited by the search
+	 * @return false if EndPoly can't be reached through the portal graph or the graph is not up to date around start or end
+	 */
+	bool FindPortalPath(const dtNavMesh& NavMesh, const dtQueryFilter& Filter,
+		dtPolyRef StartPoly, const FVector& RecastStartPos, dtPolyRef EndPoly, const FVector& RecastEndPos,
+		int32 MaxSearchNodes, TArray<FWaypoint>& OutWaypoints) const;
+
+	/** Returns memory used by the graph */
+	uint32 GetAllocatedSize() const;
+
+protected:
+	struct FPortal
+	{
+		/** Poly representing the portal, the most central one */
+		dtPolyRef PolyRef;
+
+		/** Center of PolyRef, in Recast coords */
+		FVector Location;
+
+		/** Index of the tile the portal leads to */
+		uint32 NeighborTile;
+
+		/** Range of the portal's connections in FTileGraph::Connections */
+		int32 FirstConnection;
+		int32 NumConnections;
+
+		/** Polys of the neighbor tile linked to the portal polys */
+		TArray<dtPolyRef> LinkedPolys;
+	};
+
+	struct FConnection
+	{
+		/** Index of the connected portal in the same tile */
+		int32 Portal;
+
+		/** Length of the shortest path to the connected portal */
+		float Cost;
+	};
+
+	struct FTileGraph
+	{
+		/** Ref of the tile the graph was built for, used to detect tiles changed since */
+		dtTileRef TileRef;
+
+		TArray<FPortal> Portals;
+		TArray<FConnection> Connections;
+
+		/** Portals each border poly belongs to, a poly in a tile's corner can lead to several neighbor tiles */
+		TMultiMap<dtPolyRef, int32> PolyPortals;
+	};
+
+	/** Builds the graph of a single tile, removes it if the tile is empty */
+	void BuildTile(const dtNavMesh& NavMesh, uint32 TileIndex);
+
+	/** Returns graph of the tile if it's up to date */
+	const FTileGraph* FindTileGraph(const dtNavMesh& NavMesh, uint32 TileIndex) const;
+
+	/** Calculates lengths of the shortest paths inside a tile from SourcePoly to all its polys, FLT_MAX for unreachable ones */
+	static void CalcTileDistances(const dtNavMesh& NavMesh, const dtMeshTile& Tile, const TArray<FVector>& PolyCenters,
+		int32 SourcePoly, const FVector& SourceLocation, const dtQueryFilter* Filter, TArray<float>& OutDistances);
+
+	/** Calculates centers of all polys of a tile, in Recast coords */
+	static void CalcPolyCenters(const dtMeshTile& Tile, TArray<FVector>& OutCenters);
+
+	TMap<uint32, FTileGraph> TileGraphs;
+	bool bIsBuilt = false;
+
+	/** Searches can run on several threads, while the graph is updated on the game thread */
+	mutable FRWLock Lock;
+};
+
+#endif // WITH_RECAST
@@ -573,6 +573,9 @@ public:
 	virtual void CleanUpAndMarkPendingKill();
 
 	FORCEINLINE bool IsRegistered() const { return bRegistered; }
+
+	/** Whether FindPath and FindHierarchicalPath can run concurrently on several threads for this navigation data */
+	FORCEINLINE bool SupportsConcurrentPathfinding() const { return bSupportsConcurrentPathfinding; }
 	virtual void OnRegistered();
 	void OnUnregistered();
 	
@@ -996,6 +999,9 @@ protected:
 	 *	to be applied at later date with SetRebuildingSuspended(false) call */
 	uint32 bRebuildingSuspended : 1;
 
+	/** set by navigation data implementations whose pathfinding doesn't share any per query state between threads */
+	uint32 bSupportsConcurrentPathfinding : 1;
+
 #if WITH_EDITORONLY_DATA
 	uint32 bIsBuildingOnLoad : 1;
 #endif
@@ -1013,9 +1019,13 @@ struct FAsyncPathFindingQuery : public FPathFindingQuery
 	const TEnumAsByte<EPathFindingMode::Type> Mode;
 	FPathFindingResult Result;
 
+	/** Time the query was requested at, used for latency stats */
+	double RequestTime;
+
 	FAsyncPathFindingQuery()
 		: QueryID(INVALID_NAVQUERYID)
 		, Mode(EPathFindingMode::Regular)
+		, RequestTime(0.)
 	{ }
 
 	FAsyncPathFindingQuery(const UObject* InOwner, const ANavigationData& InNavData, const FVector& Start, const FVector& End, const FNavPathQueryDelegate& Delegate, FSharedConstNavQueryFilter SourceQueryFilter, const float CostLimit = FLT_MAX);
@@ -191,6 +191,34 @@ protected:
 	bool bDoTimeSlicedUpdate;
 };
 
+/** Throughput and latency of the async pathfinding queries processed by one batch */
+struct FNavAsyncPathFindingStats
+{
+	/** Number of queries completed by the batch */
+	int32 NumCompletedQueries = 0;
+
+	/** Number of queries postponed to the next frame because the batch was aborted */
+	int32 NumPostponedQueries = 0;
+
+	/** Number of queries spread over the task graph workers */
+	int32 NumConcurrentQueries = 0;
+
+	/** Number of queries that reused the corridor found by a query going to the same location */
+	int32 NumSharedGoalQueries = 0;
+
+	/** Wall time spent processing the batch, in milliseconds */
+	float BatchTimeMs = 0.f;
+
+	/** Completed queries per second of batch processing */
+	float QueriesPerSecond = 0.f;
+
+	/** Average time from request to completion of the completed queries, in milliseconds */
+	float AverageLatencyMs = 0.f;
+
+	/** Longest time from request to completion of the completed queries, in milliseconds */
+	float MaxLatencyMs = 0.f;
+};
+
 UCLASS(Within=World, config=Engine, defaultconfig)
 class NAVIGATIONSYSTEM_API UNavigationSystemV1 : public UNavigationSystemBase
 {
@@ -975,6 +1003,9 @@ public:
 
 	FNavRegenTimeSliceManager& GetMutableNavRegenTimeSliceManager() { return NavRegenTimeSliceManager; }
 
+	/** Stats of the last async pathfinding batch whose results have been dispatched */
+	const FNavAsyncPathFindingStats& GetAsyncPathFindingStats() const { return AsyncPathFindingStats; }
+
 protected:
 
 	UPROPERTY()
@@ -992,6 +1023,12 @@ protected:
 	/** Flag used by main thread to ask the async pathfinding task to stop and postpone remaining queries, if any. */
 	TAtomic<bool> bAbortAsyncQueriesRequested;
 
+	/** Stats of the last async pathfinding batch, written by the async pathfinding task. */
+	FNavAsyncPathFindingStats AsyncPathFindingTaskStats;
+
+	/** Stats of the last async pathfinding batch whose results have been dispatched, safe to read on the main thread. */
+	FNavAsyncPathFindingStats AsyncPathFindingStats;
+
 	FCriticalSection NavDataRegistration;
 
 	TMap<FNavAgentProperties, TWeakObjectPtr<ANavigationData> > AgentToNavDataMap;
@@ -1140,7 +1177,8 @@ protected:
 	 *	In the process PathFindingQueries gets copied. */
 	void TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries);
 
-	/** Processes pathfinding requests given in PathFindingQueries.*/
+	/** Processes pathfinding requests given in PathFindingQueries. Queries on navigation data supporting
+	 *	concurrent pathfinding are spread over the task graph workers. */
 	void PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathFindingQueries);
 
 	/** Broadcasts completion delegate for all completed async pathfinding requests. */
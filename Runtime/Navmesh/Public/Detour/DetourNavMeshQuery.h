@@ -304,6 +304,11 @@ struct NAVMESH_API dtQueryResult
 	void copyFlags(unsigned char* flags, int nmax);
 	void copyFlags(unsigned int* flags, int nmax);
 
+	//@UE4 BEGIN
+	/// Appends a polygon to a path corridor assembled outside of dtNavMeshQuery
+	inline void addRef(dtPolyRef ref, float cost) { addItem(ref, cost, 0, 0); }
+	//@UE4 END
+
 protected:
 	dtChunkArray<dtQueryResultPack> data;
 
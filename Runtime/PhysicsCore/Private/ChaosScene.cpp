@@ -35,9 +35,12 @@
 #include "ProfilingDebugging/CsvProfiler.h"
 
 DECLARE_CYCLE_STAT(TEXT("Update Kinematics On Deferred SkelMeshes"),STAT_UpdateKinematicsOnDeferredSkelMeshesChaos,STATGROUP_Physics);
+DECLARE_CYCLE_STAT(TEXT("Wait For Async Query Sync"),STAT_Scene_WaitAsyncQuerySync,STATGROUP_Physics);
 CSV_DEFINE_CATEGORY(ChaosPhysics,true);
 
 TAutoConsoleVariable<int32> CVar_ChaosSimulationEnable(TEXT("P.Chaos.Simulation.Enable"),1,TEXT("Enable / disable chaos simulation. If disabled, physics will not tick."));
+TAutoConsoleVariable<float> CVar_ChaosAsyncFixedDt(TEXT("p.Chaos.Async.FixedDt"), 0.0f, TEXT("If greater than zero, scene solvers advance in fixed steps of this length without the game thread waiting on them, and the game thread interpolates between their results. Zero steps physics once per frame in sync with the game thread."));
+TAutoConsoleVariable<int32> CVar_ChaosAsyncMaxSkippedQuerySyncs(TEXT("p.Chaos.Async.MaxSkippedQuerySyncs"), 4, TEXT("Number of frames in a row the query acceleration structure and query materials can skip their sync because an async solver step is still running. The game thread then waits for the steps so that queries see the simulation."));
 TAutoConsoleVariable<int32> CVar_ApplyProjectSettings(TEXT("p.Chaos.Simulation.ApplySolverProjectSettings"), 1, TEXT("Whether to apply the solver project settings on spawning a solver"));
 
 FChaosScene::FChaosScene(
@@ -49,6 +52,7 @@ FChaosScene::FChaosScene(
 	: ChaosModule(nullptr)
 	, SceneSolver(nullptr)
 	, Owner(OwnerPtr)
+	, NumSkippedAsyncQuerySyncs(0)
 {
 	LLM_SCOPE(ELLMTag::Chaos);
 
@@ -332,8 +336,10 @@ void FChaosScene::StartFrame()
 	}
 
 
+	const float AsyncFixedDt = CVar_ChaosAsyncFixedDt.GetValueOnGameThread();
 	for(FPhysicsSolverBase* Solver : SolverList)
 	{
+		Solver->SetAsyncFixedDt_External(AsyncFixedDt);
 		CompletionEvents.Add(Solver->AdvanceAndDispatch_External(UseDeltaTime));
 	}
 
@@ -365,6 +371,22 @@ void FChaosScene::OnSyncBodies(int32 SyncTimestamp, Chaos::FPBDRigidDirtyParticl
 
 }
 
+void FChaosScene::OnSyncBodiesAsync(const TArray<Chaos::FPullPhysicsData*>& CommittedData, const Chaos::FPullPhysicsData* NextData, const Chaos::FReal Alpha)
+{
+	using namespace Chaos;
+	//simple implementation that only pulls the committed results over. The engine also interpolates towards the next results
+	for(const FPullPhysicsData* PullData : CommittedData)
+	{
+		for(const FDirtyRigidParticleData& RigidData : PullData->DirtyRigids)
+		{
+			if(RigidData.Proxy)
+			{
+				static_cast<FRigidParticlePhysicsProxy*>(RigidData.Proxy)->PullFromPhysicsState(RigidData, PullData->ExternalTimestamp);
+			}
+		}
+	}
+}
+
 bool FChaosScene::IsCompletionEventComplete() const
 {
 	for (FGraphEventRef Event : CompletionEvents)
@@ -382,6 +404,13 @@ template <typename TSolver>
 void FChaosScene::SyncBodies(TSolver* Solver)
 {
 #if WITH_CHAOS
+	if(Solver->IsUsingAsyncResults())
+	{
+		//joints and the dirty particles buffer are only synced when the solver steps with the game thread
+		SyncBodiesAsync(*Solver);
+		return;
+	}
+
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SyncBodies"),STAT_SyncBodies,STATGROUP_Physics);
 	const int32 SolverSyncTimestamp = Solver->GetMarshallingManager().GetExternalTimestampConsumed_External();
 	Chaos::FPBDRigidDirtyParticlesBufferAccessor Accessor(Solver->GetDirtyParticlesBuffer());
@@ -401,6 +430,29 @@ void FChaosScene::SyncBodies(TSolver* Solver)
 #endif
 }
 
+void FChaosScene::SyncBodiesAsync(Chaos::FPhysicsSolverBase& Solver)
+{
+#if WITH_CHAOS
+	using namespace Chaos;
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SyncBodiesAsync"),STAT_SyncBodiesAsync,STATGROUP_Physics);
+
+	// Results are shown one fixed step behind the game thread, so that the step in progress at that time has usually completed
+	FChaosMarshallingManager& MarshallingManager = Solver.GetMarshallingManager();
+	const FReal ResultsTime = MarshallingManager.GetExternalTime_External() - Solver.GetAsyncFixedDt();
+
+	TArray<FPullPhysicsData*> CommittedData;
+	const FPullPhysicsData* NextData = nullptr;
+	FReal Alpha = 1;
+	MarshallingManager.GatherPullData_External(ResultsTime, CommittedData, NextData, Alpha);
+
+	OnSyncBodiesAsync(CommittedData, NextData, Alpha);
+
+	for(FPullPhysicsData* PullData : CommittedData)
+	{
+		MarshallingManager.FreePullData_External(PullData);
+	}
+#endif
+}
 
 // Find the number of dirty elements in all substructures that has dirty elements that we know of
 // This is non recursive for now
@@ -454,13 +506,42 @@ void FChaosScene::EndFrame()
 		SolverList.AddUnique(GetSolver());
 	}
 
+	// Query data is only synced from async solvers between their steps. Wait for the steps when that hasn't happened for too long,
+	// otherwise a solver that is always busy would leave scene queries without the simulated state
+	bool bAsyncStepsInFlight = false;
+	for(FPhysicsSolverBase* Solver : SolverList)
+	{
+		bAsyncStepsInFlight |= Solver->IsUsingAsyncResults() && !Solver->IsPendingTasksComplete_External();
+	}
+
+	if(!bAsyncStepsInFlight)
+	{
+		NumSkippedAsyncQuerySyncs = 0;
+	}
+	else if(++NumSkippedAsyncQuerySyncs > CVar_ChaosAsyncMaxSkippedQuerySyncs.GetValueOnGameThread())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Scene_WaitAsyncQuerySync);
+		for(FPhysicsSolverBase* Solver : SolverList)
+		{
+			if(Solver->IsUsingAsyncResults())
+			{
+				Solver->WaitOnPendingTasks_External();
+			}
+		}
+		NumSkippedAsyncQuerySyncs = 0;
+	}
+
 	// Flip the buffers over to the game thread and sync
 	{
 		SCOPE_CYCLE_COUNTER(STAT_FlipResults);
 
 		//update external SQ structure
 		//for now just copy the whole thing, stomping any changes that came from GT
-		CopySolverAccelerationStructure();
+		//async solvers may still be running, in which case the structure is copied on a later frame, at the latest after p.Chaos.Async.MaxSkippedQuerySyncs frames
+		if(!GetSolver()->IsUsingAsyncResults() || GetSolver()->IsPendingTasksComplete_External())
+		{
+			CopySolverAccelerationStructure();
+		}
 
 		TArray<FPhysicsSolverBase*> ActiveSolvers;
 		ActiveSolvers.Reserve(SolverList.Num());
@@ -470,7 +551,8 @@ void FChaosScene::EndFrame()
 		{
 			Solver->CastHelper([&ActiveSolvers](auto& Concrete)
 			{
-				if(Concrete.HasActiveParticles())
+				//async solvers may be running, and their results are gathered whether or not they have active particles
+				if(Concrete.IsUsingAsyncResults() || Concrete.HasActiveParticles())
 				{
 					ActiveSolvers.Add(&Concrete);
 				}
@@ -487,6 +569,7 @@ void FChaosScene::EndFrame()
 				SyncBodies(&Concrete);
 				Concrete.SyncEvents_GameThread();
 
+				if(!Concrete.IsUsingAsyncResults() || Concrete.IsPendingTasksComplete_External())
 				{
 					SCOPE_CYCLE_COUNTER(STAT_SqUpdateMaterials);
 					Concrete.SyncQueryMaterials();
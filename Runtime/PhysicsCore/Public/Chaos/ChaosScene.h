@@ -54,6 +54,10 @@ namespace Chaos
 	class TArrayCollectionArray;
 
 	class FPBDRigidDirtyParticlesBufferAccessor;
+
+	class FPhysicsSolverBase;
+
+	struct FPullPhysicsData;
 }
 
 /**
@@ -150,6 +154,13 @@ protected:
 	//Engine interface BEGIN
 	virtual float OnStartFrame(float InDeltaTime){ return InDeltaTime; }
 	virtual void OnSyncBodies(const int32 SolverSyncTimestamp, Chaos::FPBDRigidDirtyParticlesBufferAccessor& Accessor);
+
+	/**
+	 * Syncs the results of a solver running async fixed steps. CommittedData are the results of the steps the external time has gone past, in step order,
+	 * and NextData (which may be null) is the result of the step in progress at the external time, Alpha of the way through it.
+	 * The base implementation moves the committed results into the particles.
+	 */
+	virtual void OnSyncBodiesAsync(const TArray<Chaos::FPullPhysicsData*>& CommittedData, const Chaos::FPullPhysicsData* NextData, const Chaos::FReal Alpha);
 	//Engine interface END
 
 	float MDeltaTime;
@@ -166,6 +177,11 @@ private:
 	template <typename TSolver>
 	void SyncBodies(TSolver* Solver);
 
+	void SyncBodiesAsync(Chaos::FPhysicsSolverBase& Solver);
+
 	// Taskgraph control
 	FGraphEventArray CompletionEvents;
+
+	// Number of frames in a row the query data of async solvers wasn't synced because steps were running
+	int32 NumSkippedAsyncQuerySyncs;
 };
\ No newline at end of file